@@ -0,0 +1,226 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <lexy/engine/code_point.hpp>
+#include <lexy/input/buffer.hpp>
+#include <lexy/input/validated_utf8_buffer.hpp>
+#include <vector>
+
+template <typename Encoding>
+std::size_t use_buffer(const lexy::buffer<Encoding>& buffer)
+{
+    std::size_t sum = 0;
+    for (auto ptr = buffer.data(); ptr != buffer.data() + buffer.size(); ++ptr)
+        sum += std::size_t(*ptr);
+
+    if (sum % 2 == 0)
+        return buffer.size();
+    else
+        return buffer.size() + 1;
+}
+
+// The conversion that was used by `lexy::make_buffer_from_raw()` before it was vectorized.
+template <typename Encoding>
+lexy::buffer<Encoding> loop_big(const void* _memory, std::size_t size)
+{
+    using char_type = typename Encoding::char_type;
+    auto memory     = static_cast<const unsigned char*>(_memory);
+
+    typename lexy::buffer<Encoding>::builder builder(size / sizeof(char_type));
+
+    const auto end = memory + size;
+    for (auto dest = builder.data(); memory != end; memory += sizeof(char_type))
+    {
+        if constexpr (std::is_same_v<char_type, char16_t>)
+            *dest++ = static_cast<char_type>((memory[0] << 8) | (memory[1] << 0));
+        else
+            *dest++ = static_cast<char_type>((memory[0] << 24) | (memory[1] << 16)
+                                             | (memory[2] << 8) | (memory[3] << 0));
+    }
+
+    return LEXY_MOV(builder).finish();
+}
+
+template <typename Encoding>
+std::size_t swap_loop(const std::vector<unsigned char>& data)
+{
+    auto buffer = loop_big<Encoding>(data.data(), data.size());
+    return use_buffer(buffer);
+}
+
+template <typename Encoding>
+std::size_t swap_make_buffer(const std::vector<unsigned char>& data)
+{
+    auto buffer = lexy::make_buffer_from_raw<Encoding, lexy::encoding_endianness::big>(data.data(),
+                                                                                       data.size());
+    return use_buffer(buffer);
+}
+
+template <typename Encoding>
+std::size_t swap_in_place(const std::vector<unsigned char>& data)
+{
+    using char_type = typename Encoding::char_type;
+
+    // Pretend we've read the data into the buffer.
+    typename lexy::buffer<Encoding>::builder builder(data.size() / sizeof(char_type));
+    std::memcpy(builder.data(), data.data(), data.size());
+
+    auto buffer = lexy::make_buffer_from_raw<Encoding, lexy::encoding_endianness::big>(
+        LEXY_MOV(builder).finish());
+    return use_buffer(buffer);
+}
+
+template <typename Encoding>
+std::size_t copy_only(const std::vector<unsigned char>& data)
+{
+    using char_type = typename Encoding::char_type;
+
+    typename lexy::buffer<Encoding>::builder builder(data.size() / sizeof(char_type));
+    std::memcpy(builder.data(), data.data(), data.size());
+    return use_buffer(LEXY_MOV(builder).finish());
+}
+
+template <typename Input>
+std::size_t decode_code_points(const Input& input)
+{
+    std::size_t sum    = 0;
+    auto        reader = input.reader();
+    while (true)
+    {
+        lexy::engine_cp_utf8::error_code ec{};
+        auto                             cp = lexy::engine_cp_utf8::parse(ec, reader);
+        if (ec != lexy::engine_cp_utf8::error_code{})
+            break;
+        sum += cp.value();
+    }
+    return sum;
+}
+
+std::size_t utf8_validate(const lexy::buffer<lexy::utf8_encoding>& buffer)
+{
+    auto begin = reinterpret_cast<const unsigned char*>(buffer.data());
+    return std::size_t(lexy::_detail::find_invalid_utf8(begin, begin + buffer.size()) - begin);
+}
+
+std::size_t utf8_validate_scalar(const lexy::buffer<lexy::utf8_encoding>& buffer)
+{
+    auto begin = reinterpret_cast<const unsigned char*>(buffer.data());
+    return std::size_t(lexy::_detail::find_invalid_utf8_scalar(begin, begin + buffer.size())
+                       - begin);
+}
+
+// Transcodes the straightforward way: into a growing temporary, which is then copied.
+std::size_t transcode_naive(const std::vector<char16_t>& data)
+{
+    std::vector<LEXY_CHAR8_T> result;
+    for (auto cur = data.data(); cur != data.data() + data.size();)
+    {
+        auto cp = char32_t(*cur++);
+        if (cp >= 0xD800 && cp <= 0xDBFF)
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (char32_t(*cur++) - 0xDC00);
+
+        LEXY_CHAR8_T buffer[4];
+        auto         size
+            = lexy::_detail::encode_code_point<lexy::utf8_encoding>::encode(lexy::code_point(cp),
+                                                                            buffer, 4);
+        result.insert(result.end(), buffer, buffer + size);
+    }
+
+    return use_buffer(lexy::buffer<lexy::utf8_encoding>(result.data(), result.size()));
+}
+
+std::size_t transcode(const std::vector<char16_t>& data)
+{
+    auto result
+        = lexy::make_buffer_transcoded<lexy::utf16_encoding, lexy::utf8_encoding>(data.data(),
+                                                                                  data.size());
+    return use_buffer(LEXY_MOV(result).buffer());
+}
+
+int main()
+{
+    ankerl::nanobench::Bench b;
+
+    auto bench_data = [&](auto encoding, const char* title, std::size_t size,
+                          std::size_t iterations) {
+        using encoding_t = decltype(encoding);
+
+        b.minEpochIterations(iterations);
+        b.title(title).relative(true);
+        b.unit("byte").batch(size);
+
+        std::vector<unsigned char> data(size);
+        for (auto i = 0u; i != size; ++i)
+            data[i] = static_cast<unsigned char>(i * 7);
+
+        b.run("loop", [&] { return swap_loop<encoding_t>(data); });
+        b.run("make_buffer_from_raw", [&] { return swap_make_buffer<encoding_t>(data); });
+        b.run("in place", [&] { return swap_in_place<encoding_t>(data); });
+        b.run("memcpy (no swap)", [&] { return copy_only<encoding_t>(data); });
+    };
+
+    bench_data(lexy::utf16_encoding{}, "UTF-16 1 KiB", 1024, 10 * 1000);
+    bench_data(lexy::utf16_encoding{}, "UTF-16 64 KiB", 64 * 1024, 1000);
+    bench_data(lexy::utf16_encoding{}, "UTF-16 1 MiB", 1024 * 1024, 100);
+    bench_data(lexy::utf16_encoding{}, "UTF-16 16 MiB", 16 * 1024 * 1024, 10);
+
+    bench_data(lexy::utf32_encoding{}, "UTF-32 1 KiB", 1024, 10 * 1000);
+    bench_data(lexy::utf32_encoding{}, "UTF-32 64 KiB", 64 * 1024, 1000);
+    bench_data(lexy::utf32_encoding{}, "UTF-32 1 MiB", 1024 * 1024, 100);
+    bench_data(lexy::utf32_encoding{}, "UTF-32 16 MiB", 16 * 1024 * 1024, 10);
+
+    auto bench_utf8 = [&](const char* title, std::size_t size, unsigned multi_unit_percent) {
+        b.minEpochIterations(100);
+        b.title(title).relative(true);
+        b.unit("byte").batch(size);
+
+        lexy::buffer<lexy::utf8_encoding>::builder builder(size);
+        for (auto i = 0u; i < size;)
+        {
+            if (i % 100 < multi_unit_percent && size - i >= 3)
+            {
+                // €
+                builder.data()[i++] = 0xE2;
+                builder.data()[i++] = 0x82;
+                builder.data()[i++] = 0xAC;
+            }
+            else
+            {
+                builder.data()[i] = LEXY_CHAR8_T('a' + i % 26);
+                ++i;
+            }
+        }
+        auto buffer    = LEXY_MOV(builder).finish();
+        auto validated = lexy::validate_utf8(lexy::buffer<lexy::utf8_encoding>(buffer)).buffer();
+
+        b.run("decode", [&] { return decode_code_points(buffer); });
+        b.run("decode (validated)", [&] { return decode_code_points(validated); });
+        b.run("validate_utf8", [&] { return utf8_validate(buffer); });
+        b.run("validate_utf8 (scalar)", [&] { return utf8_validate_scalar(buffer); });
+    };
+
+    bench_utf8("UTF-8 ASCII 1 MiB", 1024 * 1024, 0);
+    bench_utf8("UTF-8 mostly ASCII 1 MiB", 1024 * 1024, 2);
+    bench_utf8("UTF-8 mixed 1 MiB", 1024 * 1024, 30);
+
+    auto bench_transcode = [&](const char* title, std::size_t size, unsigned non_ascii_percent) {
+        b.minEpochIterations(100);
+        b.title(title).relative(true);
+        b.unit("byte").batch(size * 2);
+
+        std::vector<char16_t> data(size);
+        for (auto i = 0u; i != size; ++i)
+            data[i] = i % 100 < non_ascii_percent ? u'€' : char16_t('a' + i % 26);
+
+        b.run("naive", [&] { return transcode_naive(data); });
+        b.run("make_buffer_transcoded", [&] { return transcode(data); });
+    };
+
+    bench_transcode("UTF-16 to UTF-8 ASCII 1 MiB", 512 * 1024, 0);
+    bench_transcode("UTF-16 to UTF-8 mostly ASCII 1 MiB", 512 * 1024, 2);
+    bench_transcode("UTF-16 to UTF-8 mixed 1 MiB", 512 * 1024, 30);
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// Builds a trie of `LEXY_BENCHMARK_STRING_COUNT` strings and matches it.
+// It is only compiled, the time it takes to compile is the benchmark.
+
+#include <cstdint>
+#include <lexy/_detail/string_view.hpp>
+#include <lexy/engine/trie.hpp>
+#include <lexy/input/string_input.hpp>
+
+#ifndef LEXY_BENCHMARK_STRING_COUNT
+#    define LEXY_BENCHMARK_STRING_COUNT 2000
+#endif
+
+namespace
+{
+// The `Idx`-th of some made up words with four to ten lowercase letters.
+// The first three letters encode the index, so the words are unique and neighbours share prefixes.
+template <std::size_t Idx>
+struct word
+{
+    struct storage_t
+    {
+        char        data[10];
+        std::size_t size;
+    };
+    static constexpr auto storage = [] {
+        storage_t result{};
+        result.data[0] = char('a' + Idx / (26 * 26) % 26);
+        result.data[1] = char('a' + Idx / 26 % 26);
+        result.data[2] = char('a' + Idx % 26);
+
+        auto seed   = std::uint64_t(Idx) * 6364136223846793005u + 1442695040888963407u;
+        result.size = 4 + std::size_t(seed >> 61) % 7;
+        for (auto i = 3u; i != result.size; ++i)
+        {
+            seed           = seed * 6364136223846793005u + 1442695040888963407u;
+            result.data[i] = char('a' + (seed >> 33) % 26);
+        }
+        return result;
+    }();
+
+    static constexpr auto get()
+    {
+        return lexy::_detail::string_view(storage.data, storage.size);
+    }
+};
+
+template <std::size_t... Idxs>
+constexpr auto make_trie(lexy::_detail::index_sequence<Idxs...>)
+{
+    return lexy::trie<char, word<Idxs>...>;
+}
+
+constexpr auto words
+    = make_trie(lexy::_detail::make_index_sequence<LEXY_BENCHMARK_STRING_COUNT>{});
+} // namespace
+
+std::size_t match_word(const char* str, std::size_t size)
+{
+    auto input  = lexy::string_input(str, size);
+    auto reader = input.reader();
+
+    auto ec = lexy::engine_trie<words>::error_code();
+    return lexy::engine_trie<words>::parse(ec, reader);
+}
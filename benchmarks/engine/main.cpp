@@ -0,0 +1,436 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <lexy/_detail/ascii_table.hpp>
+#include <lexy/_detail/nttp_string.hpp>
+#include <lexy/engine/find.hpp>
+#include <lexy/engine/literal.hpp>
+#include <lexy/engine/trie.hpp>
+#include <lexy/engine/until.hpp>
+#include <lexy/engine/while.hpp>
+#include <lexy/input/string_input.hpp>
+#include <string>
+
+namespace
+{
+constexpr auto comment_end = lexy::linear_trie<LEXY_NTTP_STRING("*/")>;
+constexpr auto semicolon   = lexy::linear_trie<LEXY_NTTP_STRING(";")>;
+constexpr auto newline     = lexy::trie<char, LEXY_NTTP_STRING("\n"), LEXY_NTTP_STRING("\r\n")>;
+
+// The reserved words of SQL.
+constexpr auto sql_keywords = lexy::trie<char,
+    LEXY_NTTP_STRING("abs"), LEXY_NTTP_STRING("all"), LEXY_NTTP_STRING("allocate"),
+    LEXY_NTTP_STRING("alter"), LEXY_NTTP_STRING("and"), LEXY_NTTP_STRING("any"),
+    LEXY_NTTP_STRING("are"), LEXY_NTTP_STRING("array"), LEXY_NTTP_STRING("as"),
+    LEXY_NTTP_STRING("asensitive"), LEXY_NTTP_STRING("asymmetric"), LEXY_NTTP_STRING("at"),
+    LEXY_NTTP_STRING("atomic"), LEXY_NTTP_STRING("authorization"), LEXY_NTTP_STRING("avg"),
+    LEXY_NTTP_STRING("begin"), LEXY_NTTP_STRING("between"), LEXY_NTTP_STRING("bigint"),
+    LEXY_NTTP_STRING("binary"), LEXY_NTTP_STRING("blob"), LEXY_NTTP_STRING("boolean"),
+    LEXY_NTTP_STRING("both"), LEXY_NTTP_STRING("by"), LEXY_NTTP_STRING("call"),
+    LEXY_NTTP_STRING("called"), LEXY_NTTP_STRING("cardinality"), LEXY_NTTP_STRING("cascaded"),
+    LEXY_NTTP_STRING("case"), LEXY_NTTP_STRING("cast"), LEXY_NTTP_STRING("ceil"),
+    LEXY_NTTP_STRING("ceiling"), LEXY_NTTP_STRING("char"), LEXY_NTTP_STRING("character"),
+    LEXY_NTTP_STRING("check"), LEXY_NTTP_STRING("clob"), LEXY_NTTP_STRING("close"),
+    LEXY_NTTP_STRING("coalesce"), LEXY_NTTP_STRING("collate"), LEXY_NTTP_STRING("collect"),
+    LEXY_NTTP_STRING("column"), LEXY_NTTP_STRING("commit"), LEXY_NTTP_STRING("condition"),
+    LEXY_NTTP_STRING("connect"), LEXY_NTTP_STRING("constraint"), LEXY_NTTP_STRING("convert"),
+    LEXY_NTTP_STRING("corr"), LEXY_NTTP_STRING("corresponding"), LEXY_NTTP_STRING("count"),
+    LEXY_NTTP_STRING("covar_pop"), LEXY_NTTP_STRING("create"), LEXY_NTTP_STRING("cross"),
+    LEXY_NTTP_STRING("cube"), LEXY_NTTP_STRING("cume_dist"), LEXY_NTTP_STRING("current"),
+    LEXY_NTTP_STRING("cursor"), LEXY_NTTP_STRING("cycle"), LEXY_NTTP_STRING("date"),
+    LEXY_NTTP_STRING("day"), LEXY_NTTP_STRING("deallocate"), LEXY_NTTP_STRING("dec"),
+    LEXY_NTTP_STRING("decimal"), LEXY_NTTP_STRING("declare"), LEXY_NTTP_STRING("default"),
+    LEXY_NTTP_STRING("delete"), LEXY_NTTP_STRING("dense_rank"), LEXY_NTTP_STRING("deref"),
+    LEXY_NTTP_STRING("describe"), LEXY_NTTP_STRING("deterministic"), LEXY_NTTP_STRING("disconnect"),
+    LEXY_NTTP_STRING("distinct"), LEXY_NTTP_STRING("double"), LEXY_NTTP_STRING("drop"),
+    LEXY_NTTP_STRING("dynamic"), LEXY_NTTP_STRING("each"), LEXY_NTTP_STRING("element"),
+    LEXY_NTTP_STRING("else"), LEXY_NTTP_STRING("end"), LEXY_NTTP_STRING("escape"),
+    LEXY_NTTP_STRING("every"), LEXY_NTTP_STRING("except"), LEXY_NTTP_STRING("exec"),
+    LEXY_NTTP_STRING("execute"), LEXY_NTTP_STRING("exists"), LEXY_NTTP_STRING("exp"),
+    LEXY_NTTP_STRING("external"), LEXY_NTTP_STRING("extract"), LEXY_NTTP_STRING("false"),
+    LEXY_NTTP_STRING("fetch"), LEXY_NTTP_STRING("filter"), LEXY_NTTP_STRING("float"),
+    LEXY_NTTP_STRING("floor"), LEXY_NTTP_STRING("for"), LEXY_NTTP_STRING("foreign"),
+    LEXY_NTTP_STRING("free"), LEXY_NTTP_STRING("from"), LEXY_NTTP_STRING("full"),
+    LEXY_NTTP_STRING("function"), LEXY_NTTP_STRING("fusion"), LEXY_NTTP_STRING("get"),
+    LEXY_NTTP_STRING("global"), LEXY_NTTP_STRING("grant"), LEXY_NTTP_STRING("group"),
+    LEXY_NTTP_STRING("grouping"), LEXY_NTTP_STRING("having"), LEXY_NTTP_STRING("hold"),
+    LEXY_NTTP_STRING("hour"), LEXY_NTTP_STRING("identity"), LEXY_NTTP_STRING("in"),
+    LEXY_NTTP_STRING("indicator"), LEXY_NTTP_STRING("inner"), LEXY_NTTP_STRING("inout"),
+    LEXY_NTTP_STRING("insensitive"), LEXY_NTTP_STRING("insert"), LEXY_NTTP_STRING("int"),
+    LEXY_NTTP_STRING("integer"), LEXY_NTTP_STRING("intersect"), LEXY_NTTP_STRING("intersection"),
+    LEXY_NTTP_STRING("interval"), LEXY_NTTP_STRING("into"), LEXY_NTTP_STRING("is"),
+    LEXY_NTTP_STRING("join"), LEXY_NTTP_STRING("language"), LEXY_NTTP_STRING("large"),
+    LEXY_NTTP_STRING("lateral"), LEXY_NTTP_STRING("leading"), LEXY_NTTP_STRING("left"),
+    LEXY_NTTP_STRING("like"), LEXY_NTTP_STRING("ln"), LEXY_NTTP_STRING("local"),
+    LEXY_NTTP_STRING("localtime"), LEXY_NTTP_STRING("localtimestamp"), LEXY_NTTP_STRING("lower"),
+    LEXY_NTTP_STRING("match"), LEXY_NTTP_STRING("max"), LEXY_NTTP_STRING("member"),
+    LEXY_NTTP_STRING("merge"), LEXY_NTTP_STRING("method"), LEXY_NTTP_STRING("min"),
+    LEXY_NTTP_STRING("minute"), LEXY_NTTP_STRING("mod"), LEXY_NTTP_STRING("modifies"),
+    LEXY_NTTP_STRING("module"), LEXY_NTTP_STRING("month"), LEXY_NTTP_STRING("multiset"),
+    LEXY_NTTP_STRING("national"), LEXY_NTTP_STRING("natural"), LEXY_NTTP_STRING("nchar"),
+    LEXY_NTTP_STRING("nclob"), LEXY_NTTP_STRING("new"), LEXY_NTTP_STRING("no"),
+    LEXY_NTTP_STRING("none"), LEXY_NTTP_STRING("normalize"), LEXY_NTTP_STRING("not"),
+    LEXY_NTTP_STRING("null"), LEXY_NTTP_STRING("nullif"), LEXY_NTTP_STRING("numeric"),
+    LEXY_NTTP_STRING("octet_length"), LEXY_NTTP_STRING("of"), LEXY_NTTP_STRING("old"),
+    LEXY_NTTP_STRING("on"), LEXY_NTTP_STRING("only"), LEXY_NTTP_STRING("open"),
+    LEXY_NTTP_STRING("or"), LEXY_NTTP_STRING("order"), LEXY_NTTP_STRING("out"),
+    LEXY_NTTP_STRING("outer"), LEXY_NTTP_STRING("over"), LEXY_NTTP_STRING("overlaps"),
+    LEXY_NTTP_STRING("overlay"), LEXY_NTTP_STRING("parameter"), LEXY_NTTP_STRING("partition"),
+    LEXY_NTTP_STRING("percentile_cont"), LEXY_NTTP_STRING("percent_rank"),
+    LEXY_NTTP_STRING("position"), LEXY_NTTP_STRING("power"), LEXY_NTTP_STRING("precision"),
+    LEXY_NTTP_STRING("prepare"), LEXY_NTTP_STRING("primary"), LEXY_NTTP_STRING("procedure"),
+    LEXY_NTTP_STRING("range"), LEXY_NTTP_STRING("rank"), LEXY_NTTP_STRING("reads"),
+    LEXY_NTTP_STRING("real"), LEXY_NTTP_STRING("recursive"), LEXY_NTTP_STRING("ref"),
+    LEXY_NTTP_STRING("references"), LEXY_NTTP_STRING("referencing"), LEXY_NTTP_STRING("release"),
+    LEXY_NTTP_STRING("result"), LEXY_NTTP_STRING("return"), LEXY_NTTP_STRING("returns"),
+    LEXY_NTTP_STRING("revoke"), LEXY_NTTP_STRING("right"), LEXY_NTTP_STRING("rollback"),
+    LEXY_NTTP_STRING("rollup"), LEXY_NTTP_STRING("row"), LEXY_NTTP_STRING("rows"),
+    LEXY_NTTP_STRING("row_number"), LEXY_NTTP_STRING("savepoint"), LEXY_NTTP_STRING("scope"),
+    LEXY_NTTP_STRING("scroll"), LEXY_NTTP_STRING("search"), LEXY_NTTP_STRING("second"),
+    LEXY_NTTP_STRING("select"), LEXY_NTTP_STRING("sensitive"), LEXY_NTTP_STRING("session_user"),
+    LEXY_NTTP_STRING("set"), LEXY_NTTP_STRING("similar"), LEXY_NTTP_STRING("smallint"),
+    LEXY_NTTP_STRING("some"), LEXY_NTTP_STRING("specific"), LEXY_NTTP_STRING("sql"),
+    LEXY_NTTP_STRING("sqlexception"), LEXY_NTTP_STRING("sqlstate"), LEXY_NTTP_STRING("sqlwarning"),
+    LEXY_NTTP_STRING("sqrt"), LEXY_NTTP_STRING("start"), LEXY_NTTP_STRING("static"),
+    LEXY_NTTP_STRING("stddev_pop"), LEXY_NTTP_STRING("submultiset"), LEXY_NTTP_STRING("substring"),
+    LEXY_NTTP_STRING("sum"), LEXY_NTTP_STRING("symmetric"), LEXY_NTTP_STRING("system"),
+    LEXY_NTTP_STRING("system_user"), LEXY_NTTP_STRING("table"), LEXY_NTTP_STRING("tablesample"),
+    LEXY_NTTP_STRING("then"), LEXY_NTTP_STRING("time"), LEXY_NTTP_STRING("timestamp"),
+    LEXY_NTTP_STRING("to"), LEXY_NTTP_STRING("trailing"), LEXY_NTTP_STRING("translate"),
+    LEXY_NTTP_STRING("translation"), LEXY_NTTP_STRING("treat"), LEXY_NTTP_STRING("trigger"),
+    LEXY_NTTP_STRING("trim"), LEXY_NTTP_STRING("true"), LEXY_NTTP_STRING("uescape"),
+    LEXY_NTTP_STRING("union"), LEXY_NTTP_STRING("unique"), LEXY_NTTP_STRING("unknown"),
+    LEXY_NTTP_STRING("unnest"), LEXY_NTTP_STRING("update"), LEXY_NTTP_STRING("upper"),
+    LEXY_NTTP_STRING("user"), LEXY_NTTP_STRING("using"), LEXY_NTTP_STRING("value"),
+    LEXY_NTTP_STRING("values"), LEXY_NTTP_STRING("varchar"), LEXY_NTTP_STRING("varying"),
+    LEXY_NTTP_STRING("var_pop"), LEXY_NTTP_STRING("when"), LEXY_NTTP_STRING("whenever"),
+    LEXY_NTTP_STRING("where"), LEXY_NTTP_STRING("width_bucket"), LEXY_NTTP_STRING("window"),
+    LEXY_NTTP_STRING("with"), LEXY_NTTP_STRING("within"), LEXY_NTTP_STRING("without"),
+    LEXY_NTTP_STRING("year")>;
+
+using identifier_char = lexy::engine_ascii_table<lexy::_detail::dsl_ascii_table,
+                                                 lexy::_detail::ascii_table_alpha_underscore>;
+
+// The engines as they were implemented before they skipped characters at once:
+// they try to match at every position.
+template <typename Condition, typename Reader>
+void until_loop(Reader& reader)
+{
+    while (!lexy::engine_try_match<Condition>(reader) && !reader.eof())
+        reader.bump();
+}
+
+template <typename Condition, typename Limit, typename Reader>
+void find_before_loop(Reader& reader)
+{
+    while (!lexy::engine_peek<Condition>(reader) && !reader.eof()
+           && !lexy::engine_peek<Limit>(reader))
+        reader.bump();
+}
+
+template <typename Matcher, typename Reader>
+void while_loop(Reader& reader)
+{
+    while (lexy::engine_try_match<Matcher>(reader))
+    {}
+}
+
+// The trie engine as it was implemented before nodes with a lot of transitions used a table:
+// it compares the character against each transition.
+template <const auto& Trie>
+struct linear_trie_engine
+{
+    template <std::size_t Node, typename Transitions = void>
+    struct _node
+    : _node<Node, lexy::_detail::make_index_sequence<Trie.transition_count(Node)>>
+    {};
+    template <std::size_t Node, std::size_t... Transitions>
+    struct _node<Node, lexy::_detail::index_sequence<Transitions...>>
+    {
+        template <typename Reader>
+        static std::size_t parse(Reader& reader)
+        {
+            auto                  save = reader;
+            [[maybe_unused]] auto cur  = reader.peek();
+
+            auto result = Trie.invalid_value;
+            (void)((cur == Trie.transition_char(Node, Transitions)
+                        ? (reader.bump(),
+                           result = _node<Trie.transition_next(Node, Transitions)>::parse(reader),
+                           true)
+                        : false)
+                   || ...);
+
+            if (Trie.node_value(Node) != Trie.invalid_value && result == Trie.invalid_value)
+            {
+                reader = LEXY_MOV(save);
+                return Trie.node_value(Node);
+            }
+            return result;
+        }
+    };
+
+    template <typename Reader>
+    static std::size_t parse(Reader& reader)
+    {
+        return _node<0>::parse(reader);
+    }
+};
+
+// The trie flattened into a table with the next node for each node and character.
+template <const auto& Trie>
+struct dfa_trie_engine
+{
+    static constexpr auto node_count = sizeof(Trie._node_value) / sizeof(std::size_t);
+
+    struct table_t
+    {
+        std::uint16_t next[node_count][256];
+        std::size_t   value[node_count];
+    };
+    static constexpr auto table = [] {
+        table_t result{};
+        for (auto node = 0u; node != node_count; ++node)
+        {
+            result.value[node] = Trie._node_value[node];
+
+            auto begin = node == 0 ? 0 : Trie._node_transition_idx[node - 1];
+            for (auto idx = begin; idx != Trie._node_transition_idx[node]; ++idx)
+            {
+                auto c                 = static_cast<unsigned char>(Trie._transition_char[idx]);
+                result.next[node][c] = static_cast<std::uint16_t>(Trie._transition_node[idx]);
+            }
+        }
+        return result;
+    }();
+
+    template <typename Reader>
+    static std::size_t parse(Reader& reader)
+    {
+        auto node   = std::size_t(0);
+        auto result = table.value[0];
+        auto end    = reader;
+        while (true)
+        {
+            auto c = reader.peek();
+            if (c < 0 || c > 0xFF)
+                break;
+
+            node = table.next[node][c];
+            // The root node is never the target of a transition.
+            if (node == 0)
+                break;
+
+            reader.bump();
+            if (table.value[node] != Trie.invalid_value)
+            {
+                result = table.value[node];
+                end    = reader;
+            }
+        }
+
+        reader = LEXY_MOV(end);
+        return result;
+    }
+};
+
+// Applies the function repeatedly until the end of the input.
+template <typename Fn>
+std::size_t scan(const std::string& str, Fn fn)
+{
+    auto input  = lexy::string_input(str.data(), str.size());
+    auto reader = input.reader();
+
+    auto count = std::size_t(0);
+    while (!reader.eof())
+    {
+        fn(reader);
+        if (!reader.eof())
+            reader.bump();
+        ++count;
+    }
+    return count;
+}
+
+// A comment of the given length, which contains some stars.
+std::string block_comment(std::size_t length)
+{
+    std::string result;
+    for (auto i = 0u; result.size() < length; ++i)
+        result += i % 8 == 0 ? "* " : "lorem ipsum ";
+    return result + "*/";
+}
+
+// The text of a statement that is skipped during error recovery.
+std::string statement(std::size_t length)
+{
+    std::string result;
+    while (result.size() < length)
+        result += "foo(bar, 42) + ";
+    return result + ";";
+}
+
+// Identifiers of random length between one and `2 * average - 1` separated by a space.
+std::string identifiers(std::size_t size, unsigned average)
+{
+    std::string result;
+    auto        seed = 1u;
+    while (result.size() < size)
+    {
+        seed = seed * 1103515245u + 12345u;
+        result.append(1 + (seed >> 16) % (2 * average - 1), 'a');
+        result += ' ';
+    }
+    return result;
+}
+// Random words of the list separated by a space.
+template <std::size_t N>
+std::string words(std::size_t size, const char* const (&list)[N])
+{
+    std::string result;
+    auto        seed = 1u;
+    while (result.size() < size)
+    {
+        seed = seed * 1103515245u + 12345u;
+        result += list[(seed >> 16) % N];
+        result += ' ';
+    }
+    return result;
+}
+
+// Some SQL keywords and identifiers.
+constexpr const char* sql_query[] = {
+    "select", "customer", "from", "orders", "where", "price", "between", "and", "group", "by",
+    "region", "having", "count", "order", "desc", "limit", "left", "outer", "join", "on", "id",
+    "is", "not", "null", "insert", "into", "values", "update", "set", "total",
+};
+
+// All SQL keywords.
+constexpr const char* sql_all[] = {
+    "abs", "all", "allocate", "alter", "and", "any", "are", "array", "as", "asensitive",
+    "asymmetric", "at", "atomic", "authorization", "avg", "begin", "between", "bigint", "binary",
+    "blob", "boolean", "both", "by", "call", "called", "cardinality", "cascaded", "case", "cast",
+    "ceil", "ceiling", "char", "character", "check", "clob", "close", "coalesce", "collate",
+    "collect", "column", "commit", "condition", "connect", "constraint", "convert", "corr",
+    "corresponding", "count", "covar_pop", "create", "cross", "cube", "cume_dist", "current",
+    "cursor", "cycle", "date", "day", "deallocate", "dec", "decimal", "declare", "default",
+    "delete", "dense_rank", "deref", "describe", "deterministic", "disconnect", "distinct",
+    "double", "drop", "dynamic", "each", "element", "else", "end", "escape", "every", "except",
+    "exec", "execute", "exists", "exp", "external", "extract", "false", "fetch", "filter", "float",
+    "floor", "for", "foreign", "free", "from", "full", "function", "fusion", "get", "global",
+    "grant", "group", "grouping", "having", "hold", "hour", "identity", "in", "indicator", "inner",
+    "inout", "insensitive", "insert", "int", "integer", "intersect", "intersection", "interval",
+    "into", "is", "join", "language", "large", "lateral", "leading", "left", "like", "ln", "local",
+    "localtime", "localtimestamp", "lower", "match", "max", "member", "merge", "method", "min",
+    "minute", "mod", "modifies", "module", "month", "multiset", "national", "natural", "nchar",
+    "nclob", "new", "no", "none", "normalize", "not", "null", "nullif", "numeric", "octet_length",
+    "of", "old", "on", "only", "open", "or", "order", "out", "outer", "over", "overlaps", "overlay",
+    "parameter", "partition", "percentile_cont", "percent_rank", "position", "power", "precision",
+    "prepare", "primary", "procedure", "range", "rank", "reads", "real", "recursive", "ref",
+    "references", "referencing", "release", "result", "return", "returns", "revoke", "right",
+    "rollback", "rollup", "row", "rows", "row_number", "savepoint", "scope", "scroll", "search",
+    "second", "select", "sensitive", "session_user", "set", "similar", "smallint", "some",
+    "specific", "sql", "sqlexception", "sqlstate", "sqlwarning", "sqrt", "start", "static",
+    "stddev_pop", "submultiset", "substring", "sum", "symmetric", "system", "system_user", "table",
+    "tablesample", "then", "time", "timestamp", "to", "trailing", "translate", "translation",
+    "treat", "trigger", "trim", "true", "uescape", "union", "unique", "unknown", "unnest", "update",
+    "upper", "user", "using", "value", "values", "varchar", "varying", "var_pop", "when",
+    "whenever", "where", "width_bucket", "window", "with", "within", "without", "year",
+};
+} // namespace
+
+int main()
+{
+    using comment_engine  = lexy::engine_literal<comment_end>;
+    using semicolon_engine = lexy::engine_literal<semicolon>;
+    using newline_engine  = lexy::engine_trie<newline>;
+
+    ankerl::nanobench::Bench b;
+    b.minEpochIterations(100);
+
+    auto bench_comment = [&](const char* title, std::size_t length) {
+        std::string str;
+        while (str.size() < 1024 * 1024)
+            str += block_comment(length) + "\n";
+
+        b.title(title).relative(true);
+        b.unit("byte").batch(str.size());
+        b.run("loop", [&] {
+            return scan(str, [](auto& reader) { until_loop<comment_engine>(reader); });
+        });
+        b.run("engine_until", [&] {
+            return scan(str, [](auto& reader) {
+                lexy::engine_until_eof<comment_engine>::match(reader);
+            });
+        });
+    };
+    bench_comment("comment 80 B", 80);
+    bench_comment("comment 1 KiB", 1024);
+
+    auto bench_recovery = [&](const char* title, std::size_t length) {
+        std::string str;
+        while (str.size() < 1024 * 1024)
+            str += statement(length) + "\n";
+
+        b.title(title).relative(true);
+        b.unit("byte").batch(str.size());
+        b.run("loop", [&] {
+            return scan(str, [](auto& reader) {
+                find_before_loop<semicolon_engine, newline_engine>(reader);
+            });
+        });
+        b.run("engine_find_before", [&] {
+            return scan(str, [](auto& reader) {
+                lexy::engine_find_before<semicolon_engine, newline_engine>::match(reader);
+            });
+        });
+    };
+    bench_recovery("recovery 80 B", 80);
+    bench_recovery("recovery 1 KiB", 1024);
+
+    auto bench_identifier = [&](const char* title, unsigned average) {
+        auto str = identifiers(1024 * 1024, average);
+
+        b.title(title).relative(true);
+        b.unit("byte").batch(str.size());
+        b.run("loop", [&] {
+            return scan(str, [](auto& reader) { while_loop<identifier_char>(reader); });
+        });
+        b.run("engine_while", [&] {
+            return scan(str, [](auto& reader) {
+                lexy::engine_while<identifier_char>::match(reader);
+            });
+        });
+    };
+    bench_identifier("identifier 4 B", 4);
+    bench_identifier("identifier 12 B", 12);
+    bench_identifier("identifier 40 B", 40);
+
+    auto bench_keywords = [&](const char* title, const std::string& str) {
+        // Matches a keyword at the beginning of each word and skips the rest of it.
+        auto keywords = [&](auto engine) {
+            return scan(str, [](auto& reader) {
+                decltype(engine)::parse(reader);
+                lexy::engine_while<identifier_char>::match(reader);
+            });
+        };
+
+        b.title(title).relative(true);
+        b.unit("byte").batch(str.size());
+        b.run("linear", [&] { return keywords(linear_trie_engine<sql_keywords>{}); });
+        b.run("dfa", [&] { return keywords(dfa_trie_engine<sql_keywords>{}); });
+        b.run("engine_trie", [&] {
+            return scan(str, [](auto& reader) {
+                auto ec = lexy::engine_trie<sql_keywords>::error_code();
+                lexy::engine_trie<sql_keywords>::parse(ec, reader);
+                lexy::engine_while<identifier_char>::match(reader);
+            });
+        });
+    };
+    bench_keywords("sql query", words(1024 * 1024, sql_query));
+    bench_keywords("sql keywords", words(1024 * 1024, sql_all));
+}
@@ -7,9 +7,19 @@
 
 #include <cstdio>
 #include <fstream>
+#include <lexy/_detail/buffer_builder.hpp>
 #include <lexy/input/file.hpp>
 
-std::size_t use_buffer(const lexy::buffer<>& buffer)
+#if defined(__unix__) || defined(__APPLE__)
+#    include <sys/wait.h>
+#    include <unistd.h>
+#    define LEXY_HAS_PIPE 1
+#else
+#    define LEXY_HAS_PIPE 0
+#endif
+
+template <typename Input>
+std::size_t use_buffer(const Input& buffer)
 {
     std::size_t sum = 0;
     for (auto ptr = buffer.data(); ptr != buffer.data() + buffer.size(); ++ptr)
@@ -27,6 +37,36 @@ std::size_t file_lexy(const char* path)
     return use_buffer(result.buffer());
 }
 
+template <lexy::read_file_strategy Strategy>
+std::size_t file_lexy_strategy(const char* path)
+{
+    lexy::read_file_options options;
+    options.strategy = Strategy;
+
+    auto result = lexy::read_file(path, options);
+    return use_buffer(result.buffer());
+}
+
+// What `lexy::read_file()` did before it could read into the final buffer directly:
+// the contents are always passed to the callback, which copies them into the buffer.
+std::size_t file_lexy_copy(const char* path)
+{
+    using resource_t  = lexy::_detail::default_memory_resource;
+    using user_data_t = lexy::_read_file_user_data<lexy::default_encoding,
+                                                   lexy::encoding_endianness::bom,
+                                                   resource_t>;
+
+    user_data_t user_data(lexy::_detail::get_memory_resource<resource_t>());
+    lexy::_detail::read_file(path, user_data.callback(), &user_data);
+    return use_buffer(user_data.buffer);
+}
+
+std::size_t file_lexy_mapped(const char* path)
+{
+    auto result = lexy::map_file(path);
+    return use_buffer(result.input());
+}
+
 std::size_t file_cfile(const char* path)
 {
     auto file = std::fopen(path, "rb");
@@ -60,6 +100,67 @@ std::size_t file_stream(const char* path)
     return use_buffer(buffer);
 }
 
+std::size_t stdin_lexy()
+{
+    auto result = lexy::read_stdin();
+    return use_buffer(result.buffer());
+}
+
+std::size_t stdin_cfile()
+{
+    lexy::_detail::buffer_builder<char> builder;
+    while (true)
+    {
+        auto read = std::fread(builder.write_data(), 1, builder.write_size(), stdin);
+        builder.commit(read);
+        if (read < builder.write_size())
+            break;
+        builder.grow();
+    }
+
+    // To get a fair comparison, we also need to use the copy.
+    auto make = lexy::make_buffer_from_raw<lexy::default_encoding, lexy::encoding_endianness::bom>;
+    auto buffer = make(builder.read_data(), builder.read_size());
+    return use_buffer(buffer);
+}
+
+#if LEXY_HAS_PIPE
+// Connects stdin to a pipe that a child process fills with `size` bytes before calling `f`.
+template <typename Fn>
+std::size_t with_stdin_pipe(std::size_t size, Fn f)
+{
+    int fds[2];
+    if (::pipe(fds) != 0)
+        return 0;
+
+    auto pid = ::fork();
+    if (pid == 0)
+    {
+        ::close(fds[0]);
+
+        static char buffer[64 * 1024] = {};
+        for (auto written = std::size_t(0); written < size;)
+        {
+            auto count  = size - written < sizeof(buffer) ? size - written : sizeof(buffer);
+            auto result = ::write(fds[1], buffer, count);
+            if (result <= 0)
+                ::_exit(1);
+            written += std::size_t(result);
+        }
+        ::_exit(0);
+    }
+
+    ::close(fds[1]);
+    ::dup2(fds[0], STDIN_FILENO);
+    ::close(fds[0]);
+    std::clearerr(stdin);
+
+    auto result = f();
+    ::waitpid(pid, nullptr, 0);
+    return result;
+}
+#endif
+
 constexpr auto bm_file_path = "bm-file.delete-me";
 
 void write_file(std::size_t size)
@@ -82,6 +183,12 @@ int main()
         auto benchmark = [&](auto f) { return [f] { return f(bm_file_path); }; };
 
         b.run("lexy", benchmark(file_lexy));
+        b.run("lexy (copy)", benchmark(file_lexy_copy));
+        b.run("lexy (read)", benchmark(file_lexy_strategy<lexy::read_file_strategy::read>));
+        b.run("lexy (pread)", benchmark(file_lexy_strategy<lexy::read_file_strategy::pread>));
+        b.run("lexy (mmap)", benchmark(file_lexy_strategy<lexy::read_file_strategy::mmap>));
+        b.run("lexy (direct)", benchmark(file_lexy_strategy<lexy::read_file_strategy::direct>));
+        b.run("lexy (map_file)", benchmark(file_lexy_mapped));
 
         b.run("cfile", benchmark(file_cfile));
         b.run("stream", benchmark(file_stream));
@@ -99,7 +206,24 @@ int main()
     bench_data("128 KiB", 128 * 1024, 1000);
 
     bench_data("1 MiB", 1024 * 1024, 100);
+    bench_data("16 MiB", 16 * 1024 * 1024, 10);
 
     std::remove(bm_file_path);
+
+#if LEXY_HAS_PIPE
+    auto bench_pipe = [&](const char* title, std::size_t size, std::size_t iterations) {
+        b.minEpochIterations(iterations);
+        b.title(title).relative(true);
+        b.unit("byte").batch(size);
+
+        b.run("lexy", [&] { return with_stdin_pipe(size, stdin_lexy); });
+        b.run("cfile", [&] { return with_stdin_pipe(size, stdin_cfile); });
+    };
+
+    bench_pipe("pipe 64 KiB", 64 * 1024, 100);
+    bench_pipe("pipe 1 MiB", 1024 * 1024, 100);
+    bench_pipe("pipe 16 MiB", 16 * 1024 * 1024, 10);
+    bench_pipe("pipe 256 MiB", 256 * 1024 * 1024, 1);
+#endif
 }
 
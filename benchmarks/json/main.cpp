@@ -5,7 +5,9 @@
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include <nanobench.h>
 
+#include <cstdint>
 #include <lexy/input/file.hpp>
+#include <string>
 
 bool json_baseline(const lexy::buffer<lexy::utf8_encoding>& input);
 bool json_lexy(const lexy::buffer<lexy::utf8_encoding>& input);
@@ -23,6 +25,25 @@ auto get_data(const char* file_name)
     return LEXY_MOV(result).buffer();
 }
 
+// An array of integers with 10 to 19 digits, like IDs or timestamps.
+auto get_numbers()
+{
+    std::string str = "[";
+    auto        seed = std::uint64_t(1);
+    while (str.size() < 1024 * 1024)
+    {
+        seed = seed * 6364136223846793005u + 1442695040888963407u;
+
+        auto digit_count = 10 + (seed >> 59) % 10;
+        auto value       = seed >> 1;
+        str += std::to_string(value).substr(0, digit_count);
+        str += ",";
+    }
+    str.back() = ']';
+
+    return lexy::buffer<lexy::utf8_encoding>(str.data(), str.size());
+}
+
 const char* output_prefix()
 {
     return R"(= JSON Validation Benchmark
@@ -96,6 +117,8 @@ const char* output_suffix()
 `twitter.json`::
     Some data from twitter's API.
     Taken from https://github.com/miloyip/nativejson-benchmark.
+`numbers.json`::
+    A generated array of integers with 10 to 19 digits, like IDs or timestamps.
 
 .The Methodology
 The input data is read using `lexy::read_file()`.
@@ -109,10 +132,8 @@ int main()
     std::ofstream            out("benchmark_json.adoc");
     ankerl::nanobench::Bench b;
 
-    auto bench_data = [&](const char* file) {
-        auto data = get_data(file);
-
-        b.title(file).relative(true);
+    auto bench_data = [&](const char* title, const lexy::buffer<lexy::utf8_encoding>& data) {
+        b.title(title).relative(true);
         b.unit("byte").batch(data.size());
         b.minEpochIterations(10);
 
@@ -129,9 +150,10 @@ int main()
     };
 
     out << output_prefix();
-    bench_data("canada.json");
-    bench_data("citm_catalog.json");
-    bench_data("twitter.json");
+    bench_data("canada.json", get_data("canada.json"));
+    bench_data("citm_catalog.json", get_data("citm_catalog.json"));
+    bench_data("twitter.json", get_data("twitter.json"));
+    bench_data("numbers.json", get_numbers());
     out << output_suffix();
 }
 
@@ -0,0 +1,99 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <lexy/action/parse.hpp>
+#include <lexy/callback/real.hpp>
+#include <lexy/dsl/real.hpp>
+#include <lexy/dsl/sign.hpp>
+#include <lexy/input/file.hpp>
+#include <lexy/input/string_input.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct number
+{
+    static constexpr auto rule  = lexy::dsl::minus_sign + lexy::dsl::real<double>;
+    static constexpr auto value = lexy::as_real<double>;
+};
+
+// All numbers in canada.json, which are mostly coordinates with 15 to 17 significant digits.
+std::vector<std::string> get_canada()
+{
+    auto path   = std::string(LEXY_BENCHMARK_DATA) + "/canada.json";
+    auto result = lexy::read_file(path.c_str());
+    if (!result)
+        throw std::runtime_error("unable to read data file");
+
+    auto str = std::string(result.buffer().data(), result.buffer().size());
+
+    std::vector<std::string> numbers;
+    for (auto cur = str.c_str(); *cur != '\0';)
+    {
+        if (*cur == '-' || ('0' <= *cur && *cur <= '9'))
+        {
+            char* end = nullptr;
+            std::strtod(cur, &end);
+            numbers.emplace_back(cur, static_cast<const char*>(end));
+            cur = end;
+        }
+        else
+            ++cur;
+    }
+    return numbers;
+}
+
+// Random doubles in [0, 1) written with 17 significant digits.
+std::vector<std::string> get_random()
+{
+    std::vector<std::string> numbers;
+    auto                     seed = std::uint64_t(1);
+    for (auto i = 0; i != 100000; ++i)
+    {
+        seed = seed * 6364136223846793005u + 1442695040888963407u;
+
+        auto value = double(seed >> 11) / double(std::uint64_t(1) << 53);
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        numbers.emplace_back(buffer);
+    }
+    return numbers;
+}
+} // namespace
+
+int main()
+{
+    ankerl::nanobench::Bench b;
+    b.minEpochIterations(10);
+
+    auto bench = [&](const char* title, const std::vector<std::string>& numbers) {
+        b.title(title).relative(true);
+        b.unit("number").batch(numbers.size());
+
+        b.run("strtod", [&] {
+            auto sum = 0.0;
+            for (auto& str : numbers)
+                sum += std::strtod(str.c_str(), nullptr);
+            ankerl::nanobench::doNotOptimizeAway(sum);
+        });
+        b.run("lexy::dsl::real", [&] {
+            auto sum = 0.0;
+            for (auto& str : numbers)
+            {
+                auto input = lexy::string_input(str.data(), str.size());
+                sum += lexy::parse<number>(input, lexy::noop).value();
+            }
+            ankerl::nanobench::doNotOptimizeAway(sum);
+        });
+    };
+    bench("canada.json", get_canada());
+    bench("random", get_random());
+}
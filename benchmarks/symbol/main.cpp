@@ -0,0 +1,184 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <cstdint>
+#include <lexy/_detail/ascii_table.hpp>
+#include <lexy/_detail/perfect_hash.hpp>
+#include <lexy/dynamic_symbol_table.hpp>
+#include <lexy/engine/char_class.hpp>
+#include <lexy/engine/trie.hpp>
+#include <lexy/engine/while.hpp>
+#include <lexy/input/string_input.hpp>
+#include <map>
+#include <string>
+
+namespace
+{
+// The `Idx`-th of some made up words with four to ten lowercase letters.
+// The first three letters encode the index, so the words are unique and neighbours share prefixes.
+template <std::size_t Idx>
+struct word
+{
+    struct storage_t
+    {
+        char        data[11];
+        std::size_t size;
+    };
+    static constexpr auto storage = [] {
+        storage_t result{};
+        result.data[0] = char('a' + Idx / (26 * 26) % 26);
+        result.data[1] = char('a' + Idx / 26 % 26);
+        result.data[2] = char('a' + Idx % 26);
+
+        auto seed   = std::uint64_t(Idx) * 6364136223846793005u + 1442695040888963407u;
+        result.size = 4 + std::size_t(seed >> 61) % 7;
+        for (auto i = 3u; i != result.size; ++i)
+        {
+            seed           = seed * 6364136223846793005u + 1442695040888963407u;
+            result.data[i] = char('a' + (seed >> 33) % 26);
+        }
+        return result;
+    }();
+
+    static constexpr auto get()
+    {
+        return lexy::_detail::basic_string_view<char>(lexy::_detail::null_terminated{},
+                                                      storage.data, storage.size);
+    }
+};
+
+using identifier_char = lexy::engine_ascii_table<lexy::_detail::dsl_ascii_table,
+                                                 lexy::_detail::ascii_table_alpha_underscore>;
+
+// The first `Size` words in a trie and in a perfect hash table.
+// For comparison, they're also added to a dynamic symbol table and a `std::map` at runtime.
+template <std::size_t Size, typename Idxs = lexy::_detail::make_index_sequence<Size>>
+struct table;
+template <std::size_t Size, std::size_t... Idxs>
+struct table<Size, lexy::_detail::index_sequence<Idxs...>>
+{
+    static constexpr auto& strings = lexy::_trie_strings<char, word<Idxs>...>;
+
+    static constexpr auto trie = lexy::trie<char, word<Idxs>...>;
+    static constexpr auto hash = lexy::_detail::make_perfect_hash<char, Size>(
+        lexy::_trie_strings<char, word<Idxs>...>);
+};
+
+// Words separated by spaces: every other one is in the table of the given size, the others not.
+template <std::size_t... Idxs>
+std::string words(std::size_t table_size, lexy::_detail::index_sequence<Idxs...>)
+{
+    constexpr auto count   = sizeof...(Idxs);
+    constexpr auto strings = lexy::_trie_strings<char, word<Idxs>...>;
+
+    std::string result;
+    auto        seed = std::uint64_t(1);
+    while (result.size() < 1024 * 1024)
+    {
+        seed     = seed * 6364136223846793005u + 1442695040888963407u;
+        auto idx = std::size_t(seed >> 33) % table_size;
+        if (result.size() % 2 == 1)
+            // Not in the table; it has a prefix of one of them.
+            idx = table_size + idx % (count - table_size);
+
+        auto str = strings[idx];
+        result.append(str.data(), str.size());
+        result.push_back(' ');
+    }
+    return result;
+}
+
+// Returns the number of words that are in the table.
+template <typename Fn>
+std::size_t scan(const std::string& str, Fn fn)
+{
+    auto input  = lexy::string_input(str.data(), str.size());
+    auto reader = input.reader();
+
+    auto count = std::size_t(0);
+    while (!reader.eof())
+    {
+        if (fn(reader))
+            ++count;
+        reader.bump(); // the space
+    }
+    return count;
+}
+
+template <std::size_t Size>
+void bench_size(ankerl::nanobench::Bench& b)
+{
+    using table_t = table<Size>;
+    auto str      = words(Size, lexy::_detail::make_index_sequence<2 * 1024>{});
+
+    lexy::dynamic_symbol_table<std::size_t> dynamic;
+    std::map<std::string, std::size_t>      map;
+    for (auto idx = std::size_t(0); idx != Size; ++idx)
+    {
+        auto str = table_t::strings[idx];
+        dynamic.insert(str.data(), idx);
+        map.emplace(std::string(str.data(), str.size()), idx);
+    }
+
+    b.title("symbol table with " + std::to_string(Size) + " entries").relative(true);
+    b.unit("byte").batch(str.size());
+    b.run("trie", [&] {
+        // What the symbol rule does: match a symbol and check that the identifier ends there.
+        // Otherwise, skip the rest of the identifier.
+        return scan(str, [](auto& reader) {
+            using engine = lexy::engine_trie<table_t::trie>;
+            auto ec      = typename engine::error_code();
+            auto idx     = engine::parse(ec, reader);
+            if (ec == typename engine::error_code() && !lexy::engine_peek<identifier_char>(reader))
+                return idx != std::size_t(-1);
+
+            lexy::engine_while<identifier_char>::match(reader);
+            return false;
+        });
+    });
+    b.run("perfect hash", [&] {
+        // Match the identifier and look it up.
+        return scan(str, [](auto& reader) {
+            auto begin = reader.cur();
+            lexy::engine_while<identifier_char>::match(reader);
+
+            auto size = std::size_t(reader.cur() - begin);
+            return table_t::hash.lookup(begin, size) != table_t::hash.invalid_value;
+        });
+    });
+    b.run("dynamic symbol table", [&] {
+        return scan(str, [&](auto& reader) {
+            auto begin = reader.cur();
+            lexy::engine_while<identifier_char>::match(reader);
+
+            return bool(dynamic.lookup(lexy::lexeme(reader, begin)));
+        });
+    });
+    b.run("std::map", [&] {
+        // What a callback does if the identifier is captured.
+        return scan(str, [&](auto& reader) {
+            auto begin = reader.cur();
+            lexy::engine_while<identifier_char>::match(reader);
+
+            return map.count(std::string(begin, reader.cur())) != 0;
+        });
+    });
+}
+} // namespace
+
+int main()
+{
+    ankerl::nanobench::Bench b;
+    bench_size<4>(b);
+    bench_size<8>(b);
+    bench_size<16>(b);
+    bench_size<32>(b);
+    bench_size<64>(b);
+    bench_size<128>(b);
+    bench_size<256>(b);
+    bench_size<1024>(b);
+}
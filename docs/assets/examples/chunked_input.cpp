@@ -0,0 +1,29 @@
+#include <cstdio>
+#include <string_view>
+
+#include <lexy/action/match.hpp>
+#include <lexy/dsl.hpp>
+#include <lexy/input/chunked_input.hpp>
+
+struct production
+{
+    static constexpr auto rule = LEXY_LIT("Hello World!");
+};
+
+//{
+int main()
+{
+    // The message was received in multiple buffers.
+    std::string_view chunks[] = {"Hel", "lo W", "orld!"};
+
+    // Create the input.
+    lexy::chunked_input input(chunks, 3);
+
+    // Use the input.
+    if (!lexy::match<production>(input))
+    {
+        std::puts("Error!\n");
+        return 1;
+    }
+}
+//}
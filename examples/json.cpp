@@ -2,11 +2,8 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
-#include <cinttypes>
-#include <cstdint>
 #include <cstdio>
 #include <map>
-#include <optional>
 #include <string>
 #include <variant>
 #include <vector>
@@ -27,12 +24,7 @@ struct json_value;
 using json_null = std::nullptr_t;
 using json_bool = bool;
 
-struct json_number
-{
-    std::int64_t                integer;
-    std::optional<std::string>  fraction;
-    std::optional<std::int16_t> exponent;
-};
+using json_number = double;
 
 using json_string = std::string;
 
@@ -64,13 +56,9 @@ struct json_value
         else
             std::fputs("false", stdout);
     }
-    void _print(const json_number& i, int) const
+    void _print(json_number n, int) const
     {
-        std::fprintf(stdout, "%" PRId64, i.integer);
-        if (i.fraction)
-            std::fprintf(stdout, ".%s", i.fraction->c_str());
-        if (i.exponent)
-            std::fprintf(stdout, "e%" PRId16, *i.exponent);
+        std::fprintf(stdout, "%.17g", n);
     }
     void _print(const json_string& str, int) const
     {
@@ -173,35 +161,10 @@ struct boolean : lexy::token_production
 // A json value that is a number.
 struct number : lexy::token_production
 {
-    // A signed integer parsed as int64_t.
-    struct integer : lexy::transparent_production
-    {
-        static constexpr auto rule
-            = dsl::minus_sign + dsl::integer<std::int64_t>(dsl::digits<>.no_leading_zero());
-        static constexpr auto value = lexy::as_integer<std::int64_t>;
-    };
-
-    // The fractional part of a number parsed as the string.
-    struct fraction : lexy::transparent_production
-    {
-        static constexpr auto rule  = dsl::lit_c<'.'> >> dsl::capture(dsl::digits<>);
-        static constexpr auto value = lexy::as_string<std::string>;
-    };
-
-    // The exponent of a number parsed as int64_t.
-    struct exponent : lexy::transparent_production
-    {
-        static constexpr auto rule = [] {
-            auto exp_char = dsl::lit_c<'e'> / dsl::lit_c<'E'>;
-            return exp_char >> dsl::sign + dsl::integer<std::int16_t>(dsl::digits<>);
-        }();
-        static constexpr auto value = lexy::as_integer<std::int16_t>;
-    };
-
     static constexpr auto rule
         = dsl::peek(dsl::lit_c<'-'> / dsl::digit<>)
-          >> dsl::p<integer> + dsl::opt(dsl::p<fraction>) + dsl::opt(dsl::p<exponent>);
-    static constexpr auto value = lexy::construct<ast::json_number>;
+          >> dsl::minus_sign + dsl::real<double>.no_leading_zero();
+    static constexpr auto value = lexy::as_real<ast::json_number>;
 };
 
 // A json value that is a string.
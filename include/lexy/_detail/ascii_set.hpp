@@ -0,0 +1,295 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_DETAIL_ASCII_SET_HPP_INCLUDED
+#define LEXY_DETAIL_ASCII_SET_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstring>
+#include <lexy/_detail/config.hpp>
+#include <lexy/_detail/integer_sequence.hpp>
+
+#if LEXY_HAS_AVX2
+#    include <immintrin.h>
+#elif LEXY_HAS_SSSE3
+#    include <tmmintrin.h>
+#elif LEXY_HAS_SSE2
+#    include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#endif
+
+namespace lexy::_detail
+{
+// Precondition: x != 0.
+inline unsigned count_trailing_zeros(unsigned x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(x));
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return static_cast<unsigned>(index);
+#else
+    auto result = 0u;
+    for (; (x & 1) == 0; x >>= 1)
+        ++result;
+    return result;
+#endif
+}
+
+// At most four of the (maximal) ranges of a set, and the total number of them.
+struct ascii_set_ranges
+{
+    std::size_t   count;
+    unsigned char min[4];
+    unsigned char max[4];
+};
+
+// A set of ASCII characters.
+// It is stored as a table indexed by the low nibble of a character,
+// where bit `i` is set if the character with the high nibble `i` is in the set.
+// This allows classifying a vector of characters using two shuffles.
+class ascii_set
+{
+public:
+    constexpr ascii_set() : _nibbles(), _non_ascii(false) {}
+
+    // Adding a character outside of ASCII means the set can't be used.
+    constexpr ascii_set& insert(std::size_t c)
+    {
+        if (c > 0x7F)
+            _non_ascii = true;
+        else
+            _nibbles[c & 0xF] = static_cast<unsigned char>(_nibbles[c & 0xF] | 1u << (c >> 4));
+        return *this;
+    }
+    constexpr ascii_set& insert(std::size_t min, std::size_t max)
+    {
+        for (auto c = min; c <= max; ++c)
+        {
+            insert(c);
+            if (_non_ascii)
+                break;
+        }
+        return *this;
+    }
+
+    constexpr ascii_set& insert(const ascii_set& other)
+    {
+        for (auto i = 0u; i != 16; ++i)
+            _nibbles[i] = static_cast<unsigned char>(_nibbles[i] | other._nibbles[i]);
+        _non_ascii = _non_ascii || other._non_ascii;
+        return *this;
+    }
+
+    constexpr bool is_ascii() const noexcept
+    {
+        return !_non_ascii;
+    }
+
+    constexpr bool contains(std::size_t c) const noexcept
+    {
+        return c <= 0x7F && (_nibbles[c & 0xF] >> (c >> 4) & 1) != 0;
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        auto result = std::size_t(0);
+        for (auto c = std::size_t(0); c <= 0x7F; ++c)
+            if (contains(c))
+                ++result;
+        return result;
+    }
+
+    constexpr const unsigned char* nibbles() const noexcept
+    {
+        return _nibbles;
+    }
+
+    constexpr ascii_set_ranges ranges() const noexcept
+    {
+        ascii_set_ranges result{};
+        for (auto c = std::size_t(0); c <= 0x7F; ++c)
+        {
+            if (!contains(c))
+                continue;
+
+            auto max = c;
+            while (max < 0x7F && contains(max + 1))
+                ++max;
+
+            if (result.count < 4)
+            {
+                result.min[result.count] = static_cast<unsigned char>(c);
+                result.max[result.count] = static_cast<unsigned char>(max);
+            }
+            ++result.count;
+
+            c = max;
+        }
+        return result;
+    }
+
+private:
+    unsigned char _nibbles[16];
+    bool          _non_ascii;
+};
+
+#if LEXY_HAS_SSSE3
+// Returns a mask of the characters that are not in the set.
+inline unsigned ascii_set_mismatch(__m128i chars, __m128i low_table) noexcept
+{
+    // The bit of the high nibble; characters outside ASCII have none.
+    const auto high_table = _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40,
+                                          static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0);
+    const auto nibble_mask = _mm_set1_epi8(0x0F);
+
+    auto low  = _mm_shuffle_epi8(low_table, _mm_and_si128(chars, nibble_mask));
+    auto high = _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi16(chars, 4), nibble_mask));
+
+    auto not_in_set = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+    return static_cast<unsigned>(_mm_movemask_epi8(not_in_set));
+}
+#endif
+
+#if LEXY_HAS_AVX2
+inline unsigned ascii_set_mismatch(__m256i chars, __m256i low_table) noexcept
+{
+    const auto high_table = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0, 0,
+                      0, 0, 0, 0, 0));
+    const auto nibble_mask = _mm256_set1_epi8(0x0F);
+
+    auto low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(chars, nibble_mask));
+    auto high
+        = _mm256_shuffle_epi8(high_table,
+                              _mm256_and_si256(_mm256_srli_epi16(chars, 4), nibble_mask));
+
+    auto not_in_set = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), _mm256_setzero_si256());
+    return static_cast<unsigned>(_mm256_movemask_epi8(not_in_set));
+}
+#endif
+
+#if LEXY_HAS_SSE2 && !LEXY_HAS_SSSE3
+// Without a shuffle, we check each range of the set instead.
+template <const ascii_set& Set, std::size_t... Idx>
+inline unsigned ascii_set_mismatch(__m128i chars, index_sequence<Idx...>) noexcept
+{
+    constexpr auto ranges = Set.ranges();
+
+    // c is in [min, max] if c - min <= max - min as unsigned integers.
+    auto offset = [&](std::size_t i) {
+        return _mm_sub_epi8(chars, _mm_set1_epi8(static_cast<char>(ranges.min[i])));
+    };
+    auto length = [&](std::size_t i) {
+        return _mm_set1_epi8(static_cast<char>(ranges.max[i] - ranges.min[i]));
+    };
+
+    auto in_set = _mm_setzero_si128();
+    ((in_set = _mm_or_si128(in_set, _mm_cmpeq_epi8(_mm_min_epu8(offset(Idx), length(Idx)),
+                                                   offset(Idx)))),
+     ...);
+    return ~static_cast<unsigned>(_mm_movemask_epi8(in_set)) & 0xFFFF;
+}
+#endif
+
+// Returns the length of the initial run of characters whose membership is `InSet`.
+template <const ascii_set& Set, bool InSet>
+inline std::size_t ascii_set_scan_bytes(const unsigned char* str, std::size_t size) noexcept
+{
+    static_assert(Set.is_ascii());
+
+    // A mismatch is a character whose membership differs.
+    [[maybe_unused]] auto mismatch_of = [](unsigned not_in_set, unsigned all) {
+        return InSet ? not_in_set : ~not_in_set & all;
+    };
+
+    auto pos = std::size_t(0);
+#if LEXY_HAS_AVX2
+    const auto low_table_256
+        = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(
+            Set.nibbles())));
+    for (; size - pos >= 32; pos += 32)
+    {
+        auto chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + pos));
+        if (auto mismatch = mismatch_of(ascii_set_mismatch(chars, low_table_256), 0xFFFF'FFFFu))
+            return pos + count_trailing_zeros(mismatch);
+    }
+#endif
+#if LEXY_HAS_SSSE3
+    const auto low_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Set.nibbles()));
+    for (; size - pos >= 16; pos += 16)
+    {
+        auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos));
+        if (auto mismatch = mismatch_of(ascii_set_mismatch(chars, low_table), 0xFFFFu))
+            return pos + count_trailing_zeros(mismatch);
+    }
+#elif LEXY_HAS_SSE2
+    if constexpr (Set.ranges().count <= 4)
+    {
+        for (; size - pos >= 16; pos += 16)
+        {
+            auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos));
+            auto not_in_set
+                = ascii_set_mismatch<Set>(chars, make_index_sequence<Set.ranges().count>{});
+            if (auto mismatch = mismatch_of(not_in_set, 0xFFFFu))
+                return pos + count_trailing_zeros(mismatch);
+        }
+    }
+#endif
+
+    while (pos != size && Set.contains(str[pos]) == InSet)
+        ++pos;
+    return pos;
+}
+
+template <const ascii_set& Set, bool InSet, typename CharT>
+inline std::size_t ascii_set_scan(const CharT* str, std::size_t size) noexcept
+{
+    if constexpr (sizeof(CharT) == 1)
+    {
+        return ascii_set_scan_bytes<Set, InSet>(reinterpret_cast<const unsigned char*>(str), size);
+    }
+    else
+    {
+        auto pos = std::size_t(0);
+        while (pos != size
+               && Set.contains(static_cast<std::make_unsigned_t<CharT>>(str[pos])) == InSet)
+            ++pos;
+        return pos;
+    }
+}
+
+// Returns the length of the initial run of characters in the set, like `std::strspn()`.
+template <const ascii_set& Set, typename CharT>
+inline std::size_t ascii_set_span(const CharT* str, std::size_t size) noexcept
+{
+    return ascii_set_scan<Set, true>(str, size);
+}
+
+// Returns the position of the first character in the set or size, like `std::strcspn()`.
+template <const ascii_set& Set, typename CharT>
+inline std::size_t ascii_set_find(const CharT* str, std::size_t size) noexcept
+{
+    if constexpr (sizeof(CharT) == 1 && Set.size() == 1)
+    {
+        // A single character is best found by the standard library.
+        if (size == 0)
+            return 0;
+
+        constexpr auto c   = static_cast<int>(Set.ranges().min[0]);
+        auto           ptr = std::memchr(str, c, size);
+        return ptr ? std::size_t(static_cast<const CharT*>(ptr) - str) : size;
+    }
+    else
+    {
+        return ascii_set_scan<Set, false>(str, size);
+    }
+}
+} // namespace lexy::_detail
+
+#endif // LEXY_DETAIL_ASCII_SET_HPP_INCLUDED
@@ -0,0 +1,85 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_DETAIL_BYTE_SWAP_HPP_INCLUDED
+#define LEXY_DETAIL_BYTE_SWAP_HPP_INCLUDED
+
+#include <cstdint>
+#include <cstring>
+#include <lexy/_detail/config.hpp>
+
+#if LEXY_HAS_AVX2
+#    include <immintrin.h>
+#elif LEXY_HAS_SSE2
+#    include <emmintrin.h>
+#endif
+
+namespace lexy::_detail
+{
+// Reverses the bytes of each of the `count` code units stored at `src`, writing them to `dest`.
+// `src` doesn't need to be aligned; it may be equal to `dest`, but must not overlap it otherwise.
+template <typename CharT>
+void byte_swap(CharT* dest, const void* src, std::size_t count) noexcept
+{
+    static_assert(sizeof(CharT) == 2 || sizeof(CharT) == 4, "unsupported code unit");
+
+    auto       in  = static_cast<const unsigned char*>(src);
+    auto       out = reinterpret_cast<unsigned char*>(dest);
+    const auto end = in + count * sizeof(CharT);
+
+#if LEXY_HAS_AVX2
+    {
+        // Each 16 byte lane is shuffled separately, which is fine, as no code unit crosses them.
+        const auto shuffle
+            = sizeof(CharT) == 2
+                  ? _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, //
+                                     1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+                  : _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, //
+                                     3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        for (; end - in >= 32; in += 32, out += 32)
+        {
+            auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_shuffle_epi8(v, shuffle));
+        }
+    }
+#endif
+#if LEXY_HAS_SSE2
+    for (; end - in >= 16; in += 16, out += 16)
+    {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        if constexpr (sizeof(CharT) == 4)
+        {
+            // Swap the two 16 bit halves of each code unit...
+            v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+            v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        }
+        // ... and the two bytes of each 16 bit half.
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+    }
+#endif
+
+    // Handle the remaining code units, or all of them without SIMD.
+    for (; in != end; in += sizeof(CharT), out += sizeof(CharT))
+    {
+        if constexpr (sizeof(CharT) == 2)
+        {
+            std::uint16_t value;
+            std::memcpy(&value, in, sizeof(value));
+            value = std::uint16_t((value << 8) | (value >> 8));
+            std::memcpy(out, &value, sizeof(value));
+        }
+        else
+        {
+            std::uint32_t value;
+            std::memcpy(&value, in, sizeof(value));
+            value = (value << 24) | ((value << 8) & 0x00FF'0000) | ((value >> 8) & 0x0000'FF00)
+                    | (value >> 24);
+            std::memcpy(out, &value, sizeof(value));
+        }
+    }
+}
+} // namespace lexy::_detail
+
+#endif // LEXY_DETAIL_BYTE_SWAP_HPP_INCLUDED
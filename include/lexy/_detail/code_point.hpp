@@ -0,0 +1,130 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_DETAIL_CODE_POINT_HPP_INCLUDED
+#define LEXY_DETAIL_CODE_POINT_HPP_INCLUDED
+
+#include <lexy/code_point.hpp>
+#include <lexy/encoding.hpp>
+
+namespace lexy::_detail
+{
+template <typename Encoding>
+struct encode_code_point
+{
+    static_assert(lexy::_detail::error<Encoding>, "cannot encode a code point in this encoding");
+};
+template <>
+struct encode_code_point<lexy::ascii_encoding>
+{
+    static constexpr std::size_t encode(code_point cp, char* buffer, std::size_t size)
+    {
+        LEXY_PRECONDITION(cp.is_ascii());
+        LEXY_PRECONDITION(size >= 1);
+
+        *buffer = char(cp.value());
+        return 1;
+    }
+};
+template <>
+struct encode_code_point<lexy::utf8_encoding>
+{
+    static constexpr std::size_t encode(code_point cp, LEXY_CHAR8_T* buffer, std::size_t size)
+    {
+        LEXY_PRECONDITION(cp.is_valid());
+
+        // Taken from http://www.herongyang.com/Unicode/UTF-8-UTF-8-Encoding-Algorithm.html.
+        if (cp.is_ascii())
+        {
+            LEXY_PRECONDITION(size >= 1);
+
+            buffer[0] = LEXY_CHAR8_T(cp.value());
+            return 1;
+        }
+        else if (cp.value() <= 0x07'FF)
+        {
+            LEXY_PRECONDITION(size >= 2);
+
+            auto first  = (cp.value() >> 6) & 0x1F;
+            auto second = (cp.value() >> 0) & 0x3F;
+
+            buffer[0] = LEXY_CHAR8_T(0xC0 | first);
+            buffer[1] = LEXY_CHAR8_T(0x80 | second);
+            return 2;
+        }
+        else if (cp.value() <= 0xFF'FF)
+        {
+            LEXY_PRECONDITION(size >= 3);
+
+            auto first  = (cp.value() >> 12) & 0x0F;
+            auto second = (cp.value() >> 6) & 0x3F;
+            auto third  = (cp.value() >> 0) & 0x3F;
+
+            buffer[0] = LEXY_CHAR8_T(0xE0 | first);
+            buffer[1] = LEXY_CHAR8_T(0x80 | second);
+            buffer[2] = LEXY_CHAR8_T(0x80 | third);
+            return 3;
+        }
+        else
+        {
+            LEXY_PRECONDITION(size >= 4);
+
+            auto first  = (cp.value() >> 18) & 0x07;
+            auto second = (cp.value() >> 12) & 0x3F;
+            auto third  = (cp.value() >> 6) & 0x3F;
+            auto fourth = (cp.value() >> 0) & 0x3F;
+
+            buffer[0] = LEXY_CHAR8_T(0xF0 | first);
+            buffer[1] = LEXY_CHAR8_T(0x80 | second);
+            buffer[2] = LEXY_CHAR8_T(0x80 | third);
+            buffer[3] = LEXY_CHAR8_T(0x80 | fourth);
+            return 4;
+        }
+    }
+};
+template <>
+struct encode_code_point<lexy::utf16_encoding>
+{
+    static constexpr std::size_t encode(code_point cp, char16_t* buffer, std::size_t size)
+    {
+        LEXY_PRECONDITION(cp.is_valid());
+
+        if (cp.is_bmp())
+        {
+            LEXY_PRECONDITION(size >= 1);
+
+            buffer[0] = char16_t(cp.value());
+            return 1;
+        }
+        else
+        {
+            // Algorithm implemented from
+            // https://en.wikipedia.org/wiki/UTF-16#Code_points_from_U+010000_to_U+10FFFF.
+            LEXY_PRECONDITION(size >= 2);
+
+            auto u_prime       = cp.value() - 0x1'0000;
+            auto high_ten_bits = u_prime >> 10;
+            auto low_ten_bits  = u_prime & 0b0000'0011'1111'1111;
+
+            buffer[0] = char16_t(0xD800 + high_ten_bits);
+            buffer[1] = char16_t(0xDC00 + low_ten_bits);
+            return 2;
+        }
+    }
+};
+template <>
+struct encode_code_point<lexy::utf32_encoding>
+{
+    static constexpr std::size_t encode(code_point cp, char32_t* buffer, std::size_t size)
+    {
+        LEXY_PRECONDITION(cp.is_valid());
+        LEXY_PRECONDITION(size >= 1);
+
+        *buffer = char32_t(cp.value());
+        return 1;
+    }
+};
+} // namespace lexy::_detail
+
+#endif // LEXY_DETAIL_CODE_POINT_HPP_INCLUDED
@@ -139,6 +139,63 @@ struct _char8_str
 #    endif
 #endif
 
+//=== SIMD ===//
+#ifndef LEXY_HAS_SSE2
+#    if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#        define LEXY_HAS_SSE2 1
+#    else
+#        define LEXY_HAS_SSE2 0
+#    endif
+#endif
+
+#ifndef LEXY_HAS_SSSE3
+#    if defined(__SSSE3__) || defined(__AVX2__)
+#        define LEXY_HAS_SSSE3 1
+#    else
+#        define LEXY_HAS_SSSE3 0
+#    endif
+#endif
+
+#ifndef LEXY_HAS_AVX2
+#    if defined(__AVX2__)
+#        define LEXY_HAS_AVX2 1
+#    else
+#        define LEXY_HAS_AVX2 0
+#    endif
+#endif
+
+//=== constant evaluation ===//
+#ifndef LEXY_HAS_IS_CONSTANT_EVALUATED
+#    if defined(__has_builtin)
+#        if __has_builtin(__builtin_is_constant_evaluated)
+#            define LEXY_HAS_IS_CONSTANT_EVALUATED 1
+#        endif
+#    endif
+#    ifndef LEXY_HAS_IS_CONSTANT_EVALUATED
+#        if (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#            define LEXY_HAS_IS_CONSTANT_EVALUATED 1
+#        else
+#            define LEXY_HAS_IS_CONSTANT_EVALUATED 0
+#        endif
+#    endif
+#endif
+
+#if LEXY_HAS_IS_CONSTANT_EVALUATED
+#    define LEXY_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+// Without it, we have to assume constant evaluation, so code paths that aren't constexpr are
+// never taken.
+#    define LEXY_IS_CONSTANT_EVALUATED() true
+#endif
+
+//=== buffer ===//
+#ifndef LEXY_BUFFER_PADDING
+// The number of bytes after the end of a buffer that can be read, e.g. by SIMD code.
+#    define LEXY_BUFFER_PADDING 64
+#endif
+static_assert(LEXY_BUFFER_PADDING >= 4 && LEXY_BUFFER_PADDING % 4 == 0,
+              "LEXY_BUFFER_PADDING must be a positive multiple of four");
+
 //=== force inline ===//
 #ifndef LEXY_FORCE_INLINE
 #    if defined(__has_cpp_attribute)
@@ -0,0 +1,276 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_DETAIL_PERFECT_HASH_HPP_INCLUDED
+#define LEXY_DETAIL_PERFECT_HASH_HPP_INCLUDED
+
+#include <cstdint>
+#include <cstring>
+#include <lexy/_detail/config.hpp>
+#include <lexy/_detail/string_view.hpp>
+#include <type_traits>
+
+namespace lexy::_detail
+{
+// Scrambles the bits of the hash, so all of them depend on all bits of the input.
+constexpr std::uint64_t hash_mix(std::uint64_t value) noexcept
+{
+    value ^= value >> 33;
+    value *= 0xFF51'AFD7'ED55'8CCD;
+    value ^= value >> 33;
+    return value;
+}
+
+// Loads `N` bytes such that the first one is the least significant byte.
+template <std::size_t N, typename CharT>
+constexpr std::uint64_t _hash_load(const CharT* str) noexcept
+{
+    static_assert(sizeof(CharT) == 1);
+
+#if LEXY_IS_LITTLE_ENDIAN
+    if (!LEXY_IS_CONSTANT_EVALUATED())
+    {
+        auto result = std::uint64_t(0);
+        std::memcpy(&result, str, N);
+        return result;
+    }
+#endif
+
+    auto result = std::uint64_t(0);
+    for (auto i = 0u; i != N; ++i)
+        result |= std::uint64_t(static_cast<unsigned char>(str[i])) << (8 * i);
+    return result;
+}
+
+constexpr std::uint64_t _hash_combine(std::uint64_t hash, std::uint64_t block) noexcept
+{
+    hash = (hash ^ block) * 0x9E37'79B9'7F4A'7C15;
+    return hash << 29 | hash >> 35;
+}
+
+// Hashes the code units of a string.
+// Strings of bytes are processed in blocks of eight (with an overlapping last block), and short
+// strings are loaded using two overlapping loads, so there is no loop over the characters.
+template <typename CharT>
+constexpr std::uint64_t hash_string(const CharT* str, std::size_t length) noexcept
+{
+    auto hash = std::uint64_t(0xCBF2'9CE4'8422'2325);
+    if constexpr (sizeof(CharT) == 1)
+    {
+        if (length >= 8)
+        {
+            for (auto i = std::size_t(0); i + 8 < length; i += 8)
+                hash = _hash_combine(hash, _hash_load<8>(str + i));
+            hash = _hash_combine(hash, _hash_load<8>(str + length - 8));
+        }
+        else if (length >= 4)
+        {
+            auto block = _hash_load<4>(str) | _hash_load<4>(str + length - 4) << 32;
+            hash       = _hash_combine(hash, block);
+        }
+        else if (length > 0)
+        {
+            auto block = _hash_load<1>(str) | _hash_load<1>(str + length / 2) << 8
+                         | _hash_load<1>(str + length - 1) << 16;
+            hash = _hash_combine(hash, block);
+        }
+    }
+    else
+    {
+        for (auto i = std::size_t(0); i != length; ++i)
+            hash = _hash_combine(hash, static_cast<std::make_unsigned_t<CharT>>(str[i]));
+    }
+    return hash_mix(hash ^ length);
+}
+
+// Compares the strings with the same loads that were used to hash them.
+template <typename CharT, typename CharU>
+constexpr bool equal_strings(const CharT* lhs, const CharU* rhs, std::size_t length) noexcept
+{
+    static_assert(sizeof(CharT) == sizeof(CharU));
+    if constexpr (sizeof(CharT) == 1)
+    {
+        if (length >= 8)
+        {
+            for (auto i = std::size_t(0); i + 8 < length; i += 8)
+                if (_hash_load<8>(lhs + i) != _hash_load<8>(rhs + i))
+                    return false;
+            return _hash_load<8>(lhs + length - 8) == _hash_load<8>(rhs + length - 8);
+        }
+        else if (length >= 4)
+        {
+            auto first = _hash_load<4>(lhs) ^ _hash_load<4>(rhs);
+            auto last  = _hash_load<4>(lhs + length - 4) ^ _hash_load<4>(rhs + length - 4);
+            return (first | last) == 0;
+        }
+    }
+
+    for (auto i = std::size_t(0); i != length; ++i)
+        if (static_cast<std::make_unsigned_t<CharT>>(lhs[i])
+            != static_cast<std::make_unsigned_t<CharU>>(rhs[i]))
+            return false;
+    return true;
+}
+
+constexpr std::size_t bit_ceil(std::size_t value) noexcept
+{
+    auto result = std::size_t(1);
+    while (result < value)
+        result *= 2;
+    return result;
+}
+
+// The number of strings from which on looking up an identifier in a perfect hash is faster than
+// matching the strings using a trie (see benchmarks/symbol).
+constexpr auto perfect_hash_threshold = std::size_t(256);
+
+// A hash table that maps each of `StringCount` strings to its index without collisions.
+//
+// It uses the hash and displace scheme: each string is assigned to a bucket using its hash.
+// Each bucket has a displacement, which is combined with the hash of the strings to compute
+// their slot. The displacements are chosen at compile time such that every slot contains at most
+// one string, so a lookup needs to hash the string and compare it against a single candidate.
+template <typename CharT, std::size_t StringCount>
+struct perfect_hash
+{
+    static constexpr auto invalid_value = std::size_t(-1);
+
+    // Both are powers of two.
+    static constexpr auto slot_count   = bit_ceil(2 * StringCount);
+    static constexpr auto bucket_count = bit_ceil(StringCount / 2);
+
+    static constexpr std::size_t bucket(std::uint64_t hash) noexcept
+    {
+        return std::size_t(hash >> 32) & (bucket_count - 1);
+    }
+    static constexpr std::size_t slot(std::uint64_t hash, std::uint64_t displacement) noexcept
+    {
+        return std::size_t(hash_mix(hash ^ displacement)) & (slot_count - 1);
+    }
+
+    // Returns the index of the string equal to [str, str + length), or `invalid_value`.
+    template <typename CharU>
+    constexpr std::size_t lookup(const CharU* str, std::size_t length) const noexcept
+    {
+        static_assert(sizeof(CharU) == sizeof(CharT));
+        if (length < _min_length || length > _max_length)
+            return invalid_value;
+
+        auto hash = hash_string(str, length);
+        auto idx  = _slot_string[slot(hash, _displacement[bucket(hash)])];
+        if (idx == invalid_value || _length[idx] != length)
+            return invalid_value;
+
+        // The string in the slot is the only candidate, so we need to compare it.
+        return equal_strings(str, _string[idx], length) ? idx : invalid_value;
+    }
+
+    // Whether the displacements could be computed.
+    // This only fails for duplicate strings, or if two different strings have the same hash.
+    bool _valid;
+
+    std::size_t _min_length, _max_length;
+
+    std::uint64_t _displacement[bucket_count];
+    std::size_t   _slot_string[slot_count];
+
+    const CharT* _string[StringCount == 0 ? 1 : StringCount];
+    std::size_t  _length[StringCount == 0 ? 1 : StringCount];
+};
+
+// Builds the perfect hash of the `StringCount` strings in the array.
+template <typename CharT, std::size_t StringCount>
+LEXY_CONSTEVAL auto make_perfect_hash(const basic_string_view<CharT>* strings)
+{
+    using result_t = perfect_hash<CharT, StringCount>;
+
+    result_t result{};
+    result._valid = true;
+    for (auto& idx : result._slot_string)
+        idx = result_t::invalid_value;
+
+    std::uint64_t hashes[StringCount + 1]                  = {};
+    std::size_t   bucket_size[result_t::bucket_count]      = {};
+    std::size_t   bucket_begin[result_t::bucket_count + 1] = {};
+    std::size_t   bucket_fill[result_t::bucket_count]      = {};
+    std::size_t   bucket_strings[StringCount + 1]          = {};
+    std::size_t   candidate_slots[StringCount + 1]         = {};
+    auto          max_bucket_size                          = std::size_t(0);
+
+    for (auto idx = std::size_t(0); idx != StringCount; ++idx)
+    {
+        auto str            = strings[idx];
+        result._string[idx] = str.data();
+        result._length[idx] = str.size();
+
+        hashes[idx] = hash_string(str.data(), str.size());
+
+        if (idx == 0 || str.size() < result._min_length)
+            result._min_length = str.size();
+        if (str.size() > result._max_length)
+            result._max_length = str.size();
+
+        auto size = ++bucket_size[result_t::bucket(hashes[idx])];
+        if (size > max_bucket_size)
+            max_bucket_size = size;
+    }
+
+    // Sort the strings by bucket.
+    for (auto bucket = std::size_t(0); bucket != result_t::bucket_count; ++bucket)
+        bucket_begin[bucket + 1] = bucket_begin[bucket] + bucket_size[bucket];
+    for (auto idx = std::size_t(0); idx != StringCount; ++idx)
+    {
+        auto bucket = result_t::bucket(hashes[idx]);
+        bucket_strings[bucket_begin[bucket] + bucket_fill[bucket]++] = idx;
+    }
+
+    // Place the buckets with the most strings first, while there are still a lot of free slots.
+    for (auto size = max_bucket_size; size > 0; --size)
+        for (auto bucket = std::size_t(0); bucket != result_t::bucket_count; ++bucket)
+        {
+            if (bucket_size[bucket] != size)
+                continue;
+            auto first = bucket_strings + bucket_begin[bucket];
+
+            // Try displacements until every string of the bucket ends up in a different free slot.
+            auto placed = false;
+            for (auto i = std::uint64_t(1); i != 1 << 16 && !placed; ++i)
+            {
+                auto displacement = i * 0x9E37'79B9'7F4A'7C15;
+
+                placed = true;
+                for (auto j = std::size_t(0); j != size && placed; ++j)
+                {
+                    auto slot          = result_t::slot(hashes[first[j]], displacement);
+                    candidate_slots[j] = slot;
+
+                    if (result._slot_string[slot] != result_t::invalid_value)
+                        placed = false;
+                    for (auto k = std::size_t(0); k != j; ++k)
+                        if (candidate_slots[k] == slot)
+                            placed = false;
+                }
+
+                if (placed)
+                {
+                    result._displacement[bucket] = displacement;
+                    for (auto j = std::size_t(0); j != size; ++j)
+                        result._slot_string[candidate_slots[j]] = first[j];
+                }
+            }
+
+            if (!placed)
+            {
+                // Two strings have the same hash, i.e. they're duplicates.
+                result._valid = false;
+                return result;
+            }
+        }
+
+    return result;
+}
+} // namespace lexy::_detail
+
+#endif // LEXY_DETAIL_PERFECT_HASH_HPP_INCLUDED
+
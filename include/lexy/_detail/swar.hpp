@@ -0,0 +1,79 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_DETAIL_SWAR_HPP_INCLUDED
+#define LEXY_DETAIL_SWAR_HPP_INCLUDED
+
+#include <cstdint>
+#include <cstring>
+#include <lexy/_detail/config.hpp>
+
+namespace lexy::_detail
+{
+// Loads eight bytes such that the first one is the least significant byte.
+template <typename CharT>
+constexpr std::uint64_t swar_load(const CharT* str) noexcept
+{
+    static_assert(sizeof(CharT) == 1);
+
+#if LEXY_IS_LITTLE_ENDIAN
+    if (!LEXY_IS_CONSTANT_EVALUATED())
+    {
+        auto result = std::uint64_t(0);
+        std::memcpy(&result, str, sizeof(result));
+        return result;
+    }
+#endif
+
+    auto result = std::uint64_t(0);
+    for (auto i = 0u; i != 8; ++i)
+        result |= std::uint64_t(static_cast<unsigned char>(str[i])) << (8 * i);
+    return result;
+}
+
+// Whether all eight characters are decimal ASCII digits.
+template <typename CharT>
+constexpr bool swar_is_8digits(const CharT* str) noexcept
+{
+    // '0' to '9' are 0x30 to 0x39: their high nibble is 3, and stays 3 if we add 6 to them.
+    auto chars = swar_load(str);
+    auto high  = chars & 0xF0F0'F0F0'F0F0'F0F0;
+    auto high6 = (chars + 0x0606'0606'0606'0606) & 0xF0F0'F0F0'F0F0'F0F0;
+    return (high | high6 >> 4) == 0x3333'3333'3333'3333;
+}
+
+// Converts eight digits into their value, which is less than Radix^8.
+// Precondition: all of them are ASCII digits of the radix; for radix 16, either case is allowed.
+template <unsigned Radix, typename CharT>
+constexpr std::uint_least32_t swar_parse_8digits(const CharT* str) noexcept
+{
+    static_assert(Radix == 10 || Radix == 16);
+
+    // The value of each digit, the first digit is in the least significant byte.
+    auto digits = swar_load(str);
+    if constexpr (Radix == 10)
+    {
+        // '0' to '9' are 0x30 to 0x39.
+        digits &= 0x0F0F'0F0F'0F0F'0F0F;
+    }
+    else
+    {
+        // '0' to '9' are 0x30 to 0x39, 'a' to 'f' 0x61 to 0x66, and 'A' to 'F' 0x41 to 0x46.
+        // Bit 6 is set for the letters only, and their low nibble is one to six.
+        auto is_letter = (digits >> 6) & 0x0101'0101'0101'0101;
+        digits         = (digits & 0x0F0F'0F0F'0F0F'0F0F) + 9 * is_letter;
+    }
+
+    // Repeatedly combine two neighbouring values into one twice the size,
+    // the lower one is the more significant value.
+    digits = (digits & 0x00FF'00FF'00FF'00FF) * Radix + ((digits >> 8) & 0x00FF'00FF'00FF'00FF);
+    digits = (digits & 0x0000'FFFF'0000'FFFF) * (Radix * Radix)
+             + ((digits >> 16) & 0x0000'FFFF'0000'FFFF);
+    digits = (digits & 0x0000'0000'FFFF'FFFF) * (Radix * Radix * Radix * Radix) + (digits >> 32);
+    return static_cast<std::uint_least32_t>(digits);
+}
+} // namespace lexy::_detail
+
+#endif // LEXY_DETAIL_SWAR_HPP_INCLUDED
+
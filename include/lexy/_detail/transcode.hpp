@@ -0,0 +1,201 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_DETAIL_TRANSCODE_HPP_INCLUDED
+#define LEXY_DETAIL_TRANSCODE_HPP_INCLUDED
+
+#include <cstdint>
+#include <lexy/_detail/code_point.hpp>
+#include <lexy/_detail/config.hpp>
+
+#if LEXY_HAS_SSE2
+#    include <emmintrin.h>
+#endif
+
+namespace lexy::_detail
+{
+template <bool Swap, typename CharT>
+constexpr std::uint_least32_t load_code_unit(const CharT* ptr) noexcept
+{
+    auto unit = std::uint_least32_t(*ptr);
+    if constexpr (Swap && sizeof(CharT) == 2)
+        unit = ((unit << 8) | (unit >> 8)) & 0xFFFF;
+    else if constexpr (Swap && sizeof(CharT) == 4)
+        unit = ((unit << 24) | ((unit << 8) & 0x00FF'0000) | ((unit >> 8) & 0x0000'FF00)
+                | (unit >> 24))
+               & 0xFFFF'FFFF;
+    return unit;
+}
+
+// Transcodes UTF-16 or UTF-32 code units, possibly stored in the other byte order, into another
+// Unicode encoding.
+template <typename From, typename To, bool Swap>
+struct transcoder
+{
+    static_assert(std::is_same_v<From, utf16_encoding> || std::is_same_v<From, utf32_encoding>,
+                  "can only transcode from UTF-16 or UTF-32");
+    static_assert(std::is_same_v<To, utf8_encoding> || std::is_same_v<To, utf16_encoding>
+                      || std::is_same_v<To, utf32_encoding>,
+                  "can only transcode to UTF-8, UTF-16, or UTF-32");
+
+    using from_char = typename From::char_type;
+    using to_char   = typename To::char_type;
+
+    // The input is native and the output UTF-8, so blocks of ASCII characters can be narrowed.
+    static constexpr auto _use_simd
+        = LEXY_HAS_SSE2 && !Swap && std::is_same_v<To, utf8_encoding>;
+
+#if LEXY_HAS_SSE2
+    // If the next 16 code units are all ASCII, stores them as bytes in `result`.
+    static bool _ascii_block(const from_char* cur, __m128i& result) noexcept
+    {
+        auto load = [&](int i) {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur) + i);
+        };
+
+        if constexpr (sizeof(from_char) == 2)
+        {
+            auto a = load(0);
+            auto b = load(1);
+            if (_mm_movemask_epi8(
+                    _mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(-0x80)),
+                                    _mm_setzero_si128()))
+                != 0xFFFF)
+                return false;
+
+            result = _mm_packus_epi16(a, b);
+        }
+        else
+        {
+            auto a = load(0);
+            auto b = load(1);
+            auto c = load(2);
+            auto d = load(3);
+            auto any
+                = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)),
+                                _mm_set1_epi32(-0x80));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(any, _mm_setzero_si128())) != 0xFFFF)
+                return false;
+
+            // All values are less than 0x80, so the signed saturation doesn't change anything.
+            result = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        }
+        return true;
+    }
+#endif
+
+    // Decodes the code point starting at `cur`.
+    // Returns the number of code units, or zero if they don't form a valid code point.
+    static constexpr std::size_t _decode(const from_char* cur, const from_char* end,
+                                         code_point& cp) noexcept
+    {
+        auto first = load_code_unit<Swap>(cur);
+        if constexpr (std::is_same_v<From, utf16_encoding>)
+        {
+            if (first < 0xD800 || first > 0xDFFF)
+            {
+                cp = code_point(char32_t(first));
+                return 1;
+            }
+            else if (first >= 0xDC00 || end - cur < 2)
+            {
+                // Unpaired trailing surrogate, or missing trailing surrogate at the end.
+                return 0;
+            }
+
+            auto second = load_code_unit<Swap>(cur + 1);
+            if (second < 0xDC00 || second > 0xDFFF)
+                return 0;
+
+            cp = code_point(char32_t(0x1'0000 + ((first - 0xD800) << 10) + (second - 0xDC00)));
+            return 2;
+        }
+        else
+        {
+            cp = code_point(char32_t(first));
+            return cp.is_valid() && !cp.is_surrogate() ? 1 : 0;
+        }
+    }
+
+    // Returns the number of code units the result needs.
+    // If the input is malformed, sets `error` to the first code unit of the invalid code point.
+    static std::size_t measure(const from_char* cur, const from_char* end,
+                               const from_char*& error) noexcept
+    {
+        std::size_t size = 0;
+        while (cur != end)
+        {
+#if LEXY_HAS_SSE2
+            if constexpr (_use_simd)
+            {
+                for (__m128i block; end - cur >= 16 && _ascii_block(cur, block); cur += 16)
+                    size += 16;
+            }
+#endif
+
+            // Handle the next code units one at a time, before trying a block of ASCII again.
+            for (auto block_end = end - cur > 16 ? cur + 16 : end; cur < block_end;)
+            {
+                if (load_code_unit<Swap>(cur) < 0x80)
+                {
+                    ++size;
+                    ++cur;
+                    continue;
+                }
+
+                code_point cp;
+                auto       length = _decode(cur, end, cp);
+                if (length == 0)
+                {
+                    error = cur;
+                    return 0;
+                }
+
+                to_char buffer[4];
+                size += encode_code_point<To>::encode(cp, buffer, 4);
+                cur += length;
+            }
+        }
+        return size;
+    }
+
+    // Writes the transcoded input, which must have been measured successfully, to `out`.
+    static void write(const from_char* cur, const from_char* end, to_char* out) noexcept
+    {
+        while (cur != end)
+        {
+#if LEXY_HAS_SSE2
+            if constexpr (_use_simd)
+            {
+                for (__m128i block; end - cur >= 16 && _ascii_block(cur, block); cur += 16)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), block);
+                    out += 16;
+                }
+            }
+#endif
+
+            for (auto block_end = end - cur > 16 ? cur + 16 : end; cur < block_end;)
+            {
+                if (auto unit = load_code_unit<Swap>(cur); unit < 0x80)
+                {
+                    *out++ = to_char(unit);
+                    ++cur;
+                    continue;
+                }
+
+                code_point cp;
+                auto       length = _decode(cur, end, cp);
+                LEXY_PRECONDITION(length > 0);
+
+                // Every code point needs at most 4 code units.
+                out += encode_code_point<To>::encode(cp, out, 4);
+                cur += length;
+            }
+        }
+    }
+};
+} // namespace lexy::_detail
+
+#endif // LEXY_DETAIL_TRANSCODE_HPP_INCLUDED
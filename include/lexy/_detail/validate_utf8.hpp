@@ -0,0 +1,226 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_DETAIL_VALIDATE_UTF8_HPP_INCLUDED
+#define LEXY_DETAIL_VALIDATE_UTF8_HPP_INCLUDED
+
+#include <cstdint>
+#include <cstring>
+#include <lexy/_detail/config.hpp>
+
+#if LEXY_HAS_AVX2
+#    include <immintrin.h>
+#elif LEXY_HAS_SSE2
+#    include <emmintrin.h>
+#endif
+
+namespace lexy::_detail
+{
+// Validates one code point at a time, but skips over blocks of ASCII characters.
+// Returns a pointer to the first code unit of the first invalid code point, or end.
+inline const unsigned char* find_invalid_utf8_scalar(const unsigned char* cur,
+                                                     const unsigned char* end) noexcept
+{
+    while (cur != end)
+    {
+#if LEXY_HAS_SSE2
+        while (end - cur >= 16
+               && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cur))) == 0)
+            cur += 16;
+#else
+        for (std::uint64_t block; end - cur >= 8; cur += 8)
+        {
+            std::memcpy(&block, cur, sizeof(block));
+            if (block & 0x8080'8080'8080'8080)
+                break;
+        }
+#endif
+        if (cur == end)
+            break;
+
+        auto lead = *cur;
+        if (lead < 0x80)
+        {
+            ++cur;
+            continue;
+        }
+
+        // The length and the valid range of the second code unit, see table 3-7 of the Unicode
+        // standard; this rejects overlong sequences, surrogates, and code points > 0x10FFFF.
+        auto length = 0;
+        auto min    = 0x80;
+        auto max    = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF)
+            length = 2;
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            length = 3;
+            if (lead == 0xE0)
+                min = 0xA0;
+            else if (lead == 0xED)
+                max = 0x9F;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            length = 4;
+            if (lead == 0xF0)
+                min = 0x90;
+            else if (lead == 0xF4)
+                max = 0x8F;
+        }
+        else
+            return cur;
+
+        if (end - cur < length || cur[1] < min || cur[1] > max)
+            return cur;
+        for (auto i = 2; i < length; ++i)
+            if ((cur[i] & 0xC0) != 0x80)
+                return cur;
+
+        cur += length;
+    }
+
+    return end;
+}
+
+// Returns the position where scalar validation has to start again, if everything before `pos` has
+// been validated, except for the continuation of a code point that started in the last 3 units.
+inline const unsigned char* utf8_restart_position(const unsigned char* begin,
+                                                  const unsigned char* pos) noexcept
+{
+    for (auto cur = pos; cur != begin && pos - cur < 3; --cur)
+    {
+        auto unit = cur[-1];
+        if (unit >= 0xC0)
+            // The lead of a code point whose continuation we haven't checked.
+            return cur - 1;
+        else if (unit < 0x80)
+            // The last code point is ASCII.
+            break;
+    }
+    return pos;
+}
+
+#if LEXY_HAS_AVX2
+// The lookup table algorithm by John Keiser and Daniel Lemire:
+// "Validating UTF-8 In Less Than One Instruction Per Byte" (2021).
+// It classifies each pair of adjacent code units using three table lookups on their nibbles;
+// the AND of the results is non-zero if they cannot appear next to each other.
+// Returns the position where the scalar validation needs to continue.
+inline const unsigned char* find_invalid_utf8_avx2(const unsigned char* begin,
+                                                   const unsigned char* end) noexcept
+{
+    // The errors that can be determined by looking at two adjacent code units.
+    constexpr char too_short  = 1 << 0; // 11______ 0_______, 11______ 11______
+    constexpr char too_long   = 1 << 1; // 0_______ 10______
+    constexpr char overlong_3 = 1 << 2; // 11100000 100_____
+    constexpr char too_large  = 1 << 3; // 11110100 1001____, 11110100 101_____, 11110101+ 1001____
+    constexpr char surrogate  = 1 << 4; // 11101101 101_____
+    constexpr char overlong_2 = 1 << 5; // 1100000_ 10______
+    constexpr char too_large_1000 = 1 << 6; // 11110101+ 1000____
+    constexpr char overlong_4     = 1 << 6; // 11110000 1000____
+    constexpr char two_conts      = char(1 << 7); // 10______ 10______
+    constexpr char carry          = too_short | too_long | two_conts;
+
+#    define LEXY_TABLE(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+    // Indexed by the high nibble of the first code unit.
+    const auto byte_1_high
+        = LEXY_TABLE(too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+                     too_long, two_conts, two_conts, two_conts, two_conts, too_short | overlong_2,
+                     too_short, too_short | overlong_3 | surrogate,
+                     too_short | too_large | too_large_1000 | overlong_4);
+    // Indexed by the low nibble of the first code unit.
+    const auto byte_1_low
+        = LEXY_TABLE(carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2, carry,
+                     carry, carry | too_large, carry | too_large | too_large_1000,
+                     carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+                     carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+                     carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+                     carry | too_large | too_large_1000,
+                     carry | too_large | too_large_1000 | surrogate,
+                     carry | too_large | too_large_1000, carry | too_large | too_large_1000);
+    // Indexed by the high nibble of the second code unit.
+    const auto byte_2_high
+        = LEXY_TABLE(too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+                     too_short,
+                     too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+                     too_long | overlong_2 | two_conts | overlong_3 | too_large,
+                     too_long | overlong_2 | two_conts | surrogate | too_large,
+                     too_long | overlong_2 | two_conts | surrogate | too_large, too_short,
+                     too_short, too_short, too_short);
+#    undef LEXY_TABLE
+
+    // A code unit in the last three positions that requires more continuation units than fit.
+    const auto incomplete_max
+        = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, //
+                           -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, char(0xF0 - 1),
+                           char(0xE0 - 1), char(0xC0 - 1));
+    const auto nibble_mask = _mm256_set1_epi8(0x0F);
+
+    auto prev_input      = _mm256_setzero_si256();
+    auto prev_incomplete = _mm256_setzero_si256();
+
+    auto cur = begin;
+    for (; end - cur >= 32; cur += 32)
+    {
+        auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur));
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            // An ASCII block is valid, unless it ends a multi-unit code point too early.
+            if (!_mm256_testz_si256(prev_incomplete, prev_incomplete))
+                return utf8_restart_position(begin, cur);
+
+            prev_input      = input;
+            prev_incomplete = _mm256_setzero_si256();
+            continue;
+        }
+
+        // The input shifted by N code units, with the last units of the previous block in front.
+        auto shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+        auto prev1   = _mm256_alignr_epi8(input, shifted, 16 - 1);
+        auto prev2   = _mm256_alignr_epi8(input, shifted, 16 - 2);
+        auto prev3   = _mm256_alignr_epi8(input, shifted, 16 - 3);
+
+        auto special = _mm256_and_si256(
+            _mm256_and_si256(_mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(
+                                                                  _mm256_srli_epi16(prev1, 4),
+                                                                  nibble_mask)),
+                             _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, nibble_mask))),
+            _mm256_shuffle_epi8(byte_2_high,
+                                _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask)));
+
+        // The third and fourth unit of a code point have to be a continuation;
+        // this is exactly where special reports two_conts.
+        auto is_third  = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xE0 - 0x80)));
+        auto is_fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+        auto must_23   = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth),
+                                        _mm256_set1_epi8(char(0x80)));
+
+        auto error = _mm256_xor_si256(must_23, special);
+        if (!_mm256_testz_si256(error, error))
+            return utf8_restart_position(begin, cur);
+
+        prev_input      = input;
+        prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+    }
+
+    // The remaining code units are validated by the scalar loop,
+    // which also checks any code point that continues into them.
+    return utf8_restart_position(begin, cur);
+}
+#endif
+
+// Returns a pointer to the first code unit of the first invalid code point, or end.
+inline const unsigned char* find_invalid_utf8(const unsigned char* begin,
+                                              const unsigned char* end) noexcept
+{
+#if LEXY_HAS_AVX2
+    // If the SIMD loop finds an error, the scalar loop determines its exact position.
+    begin = find_invalid_utf8_avx2(begin, end);
+#endif
+    return find_invalid_utf8_scalar(begin, end);
+}
+} // namespace lexy::_detail
+
+#endif // LEXY_DETAIL_VALIDATE_UTF8_HPP_INCLUDED
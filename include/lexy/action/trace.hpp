@@ -52,11 +52,13 @@ namespace lexy
 {
 namespace _ev = lexy::parse_events;
 
-template <typename OutputIt, typename Input, typename TokenKind = void>
+template <typename OutputIt, typename Input, typename TokenKind = void,
+          typename LocationFinder = lexy_ext::input_location_finder<Input>>
 class trace_handler
 {
-    using location_finder = lexy_ext::input_location_finder<Input>;
-    using location        = typename location_finder::location;
+    // An owned `lexy_ext::input_location_finder` or a reference to a `lexy_ext::line_index`.
+    using location_finder = LocationFinder;
+    using location        = typename std::decay_t<location_finder>::location;
 
     struct label_t
     {
@@ -126,6 +128,12 @@ public:
     {
         LEXY_PRECONDITION(_opts.max_tree_depth <= visualization_options::max_tree_depth_limit);
     }
+    explicit trace_handler(OutputIt out, location_finder locations,
+                           visualization_options opts = {}) noexcept
+    : _out(out), _cur_depth(0), _locations(locations), _anchor(_locations.beginning()), _opts(opts)
+    {
+        LEXY_PRECONDITION(_opts.max_tree_depth <= visualization_options::max_tree_depth_limit);
+    }
 
     //=== result ===//
     template <typename Production>
@@ -451,11 +459,30 @@ OutputIt trace_to(OutputIt out, const Input& input, visualization_options opts =
                                        reader);
 }
 
+template <typename Production, typename TokenKind = void, typename OutputIt, typename Input,
+          typename TokenColumn>
+OutputIt trace_to(OutputIt out, const Input& input,
+                  const lexy_ext::line_index<Input, TokenColumn>& index,
+                  visualization_options                           opts = {})
+{
+    using index_t = lexy_ext::line_index<Input, TokenColumn>;
+    using handler = trace_handler<OutputIt, Input, TokenKind, const index_t&>;
+
+    auto reader = input.reader();
+    return lexy::do_action<Production>(handler(out, index, opts), reader);
+}
+
 template <typename Production, typename TokenKind = void, typename Input>
 void trace(std::FILE* file, const Input& input, visualization_options opts = {})
 {
     trace_to<Production, TokenKind>(cfile_output_iterator{file}, input, opts);
 }
+template <typename Production, typename TokenKind = void, typename Input, typename TokenColumn>
+void trace(std::FILE* file, const Input& input,
+           const lexy_ext::line_index<Input, TokenColumn>& index, visualization_options opts = {})
+{
+    trace_to<Production, TokenKind>(cfile_output_iterator{file}, input, index, opts);
+}
 } // namespace lexy
 
 #endif // LEXY_ACTION_TRACE_HPP_INCLUDED
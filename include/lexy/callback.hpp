@@ -17,6 +17,7 @@
 #include <lexy/callback/integer.hpp>
 #include <lexy/callback/noop.hpp>
 #include <lexy/callback/object.hpp>
+#include <lexy/callback/real.hpp>
 #include <lexy/callback/string.hpp>
 
 #endif // LEXY_CALLBACK_HPP_INCLUDED
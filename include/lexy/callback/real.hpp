@@ -0,0 +1,19 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_CALLBACK_REAL_HPP_INCLUDED
+#define LEXY_CALLBACK_REAL_HPP_INCLUDED
+
+#include <lexy/callback/integer.hpp>
+
+namespace lexy
+{
+// A callback that takes an optional sign and a floating point number and produces the signed
+// number.
+template <typename T>
+constexpr auto as_real = _int<T>{};
+} // namespace lexy
+
+#endif // LEXY_CALLBACK_REAL_HPP_INCLUDED
+
@@ -18,6 +18,7 @@
 #include <lexy/dsl/context_counter.hpp>
 #include <lexy/dsl/context_flag.hpp>
 #include <lexy/dsl/context_identifier.hpp>
+#include <lexy/dsl/context_symbol_table.hpp>
 #include <lexy/dsl/delimited.hpp>
 #include <lexy/dsl/digit.hpp>
 #include <lexy/dsl/encode.hpp>
@@ -39,6 +40,7 @@
 #include <lexy/dsl/position.hpp>
 #include <lexy/dsl/production.hpp>
 #include <lexy/dsl/punctuator.hpp>
+#include <lexy/dsl/real.hpp>
 #include <lexy/dsl/recover.hpp>
 #include <lexy/dsl/return.hpp>
 #include <lexy/dsl/separator.hpp>
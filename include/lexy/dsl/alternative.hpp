@@ -5,10 +5,13 @@
 #ifndef LEXY_DSL_ALTERNATIVE_HPP_INCLUDED
 #define LEXY_DSL_ALTERNATIVE_HPP_INCLUDED
 
+#include <cstdint>
 #include <lexy/_detail/detect.hpp>
+#include <lexy/_detail/integer_sequence.hpp>
 #include <lexy/_detail/iterator.hpp>
 #include <lexy/dsl/base.hpp>
 #include <lexy/dsl/token.hpp>
+#include <lexy/engine/char_class.hpp>
 #include <lexy/engine/failure.hpp>
 #include <lexy/engine/trie.hpp>
 
@@ -54,16 +57,82 @@ struct _alt_engine<_alt_impl<Lits...>, _alt_impl<Tokens...>>
             error = 1
         };
 
+        static constexpr auto _engine_count = (sizeof...(Lits) > 0 ? 1 : 0) + sizeof...(Tokens);
+
+        // We only try the engines that can begin with the current character.
+        // Entry `c` has bit `i` set if the `i`th engine we try can begin with the code unit `c`;
+        // the last entry is used for all non-ASCII code units.
+        static constexpr auto _use_dispatch   = _engine_count <= 64;
+        static constexpr auto _dispatch_table = [] {
+            struct table_t
+            {
+                std::uint_least64_t data[0x81];
+            } result{};
+            if (!_use_dispatch)
+                return result;
+
+            lexy::_detail::ascii_set first_chars[_engine_count] = {};
+            auto                     idx                            = std::size_t(0);
+            if constexpr (sizeof...(Lits) > 0)
+                first_chars[idx++]
+                    = lexy::_engine_first_chars<lexy::engine_trie<_alt_trie<Lits...>::trie>>;
+            ((first_chars[idx++] = lexy::_engine_first_chars<typename Tokens::token_engine>), ...);
+
+            for (auto engine = std::size_t(0); engine != _engine_count; ++engine)
+            {
+                auto bit = std::uint_least64_t(1) << engine;
+                // If it isn't an ASCII set, the engine might match anything.
+                auto any = !first_chars[engine].is_ascii();
+                for (auto c = std::size_t(0); c <= 0x7F; ++c)
+                    if (any || first_chars[engine].contains(c))
+                        result.data[c] |= bit;
+                if (any)
+                    result.data[0x80] |= bit;
+            }
+            return result;
+        }();
+
+        template <typename TryEngine, std::size_t... Idx>
+        static constexpr bool _try_tokens(TryEngine& try_engine,
+                                          lexy::_detail::index_sequence<Idx...>)
+        {
+            constexpr auto offset = sizeof...(Lits) > 0 ? 1 : 0;
+            return (false || ... || try_engine(typename Tokens::token_engine{},
+                                              std::integral_constant<std::size_t, offset + Idx>{}));
+        }
+
         template <typename Reader>
         static constexpr error_code match(Reader& reader)
         {
+            // As the engines can also match at EOF, we need to try all of them there.
+            auto candidates = ~std::uint_least64_t(0);
+            if constexpr (_use_dispatch)
+            {
+                if (auto cur = reader.peek(); cur != Reader::encoding::eof())
+                {
+                    auto code_unit = static_cast<std::size_t>(cur);
+                    candidates     = _dispatch_table.data[code_unit <= 0x7F ? code_unit : 0x80];
+                    if (candidates == 0)
+                        return error_code::error;
+                }
+            }
+
             auto success        = false;
             auto longest_reader = reader;
             auto longest_match  = std::size_t(0);
-            auto try_engine     = [&](auto engine) {
+            auto try_engine     = [&](auto engine, auto bit) {
+                using engine_t = decltype(engine);
+                // Checking a single character is as fast as checking the table.
+                if constexpr (_use_dispatch && decltype(bit)::value < 64
+                              && !lexy::_engine_is_ascii_set<engine_t>)
+                {
+                    if ((candidates & std::uint_least64_t(1) << decltype(bit)::value) == 0)
+                        return false;
+                }
+
                 // Match each engine on a fresh reader and determine the length of the match.
                 auto copy = reader;
-                if (!lexy::engine_try_match<decltype(engine)>(copy))
+                if (!lexy::engine_try_match<engine_t>(copy))
                     return false;
                 auto length = lexy::_detail::range_size(reader.cur(), copy.cur());
 
@@ -84,9 +153,12 @@ struct _alt_engine<_alt_impl<Lits...>, _alt_impl<Tokens...>>
             // We trie the trie first as it is more optimized and gives a longer initial maximum.
             [[maybe_unused]] auto done = false;
             if constexpr (sizeof...(Lits) > 0)
-                done = try_engine(lexy::engine_trie<_alt_trie<Lits...>::trie>{});
+                done = try_engine(lexy::engine_trie<_alt_trie<Lits...>::trie>{},
+                                  std::integral_constant<std::size_t, 0>{});
             if constexpr (sizeof...(Tokens) > 0)
-                (done || ... || try_engine(typename Tokens::token_engine{}));
+                done = done
+                       || _try_tokens(try_engine,
+                                      lexy::_detail::make_index_sequence<sizeof...(Tokens)>{});
 
             if (!success)
                 return error_code::error;
@@ -94,6 +166,14 @@ struct _alt_engine<_alt_impl<Lits...>, _alt_impl<Tokens...>>
             reader = LEXY_MOV(longest_reader);
             return error_code();
         }
+
+        static constexpr auto _first_chars = [] {
+            if constexpr (sizeof...(Lits) > 0)
+                return lexy::_engine_first_chars<lexy::engine_trie<_alt_trie<Lits...>::trie>,
+                                                 typename Tokens::token_engine...>;
+            else
+                return lexy::_engine_first_chars<typename Tokens::token_engine...>;
+        }();
     };
 };
 template <typename... Lits, typename... Tokens, typename H, typename... T>
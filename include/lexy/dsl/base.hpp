@@ -7,6 +7,7 @@
 
 #include <lexy/_detail/config.hpp>
 #include <lexy/engine/base.hpp>
+#include <lexy/engine/char_class.hpp>
 #include <lexy/grammar.hpp>
 #include <lexy/input/base.hpp>
 
@@ -180,6 +181,24 @@ constexpr bool engine_peek(Context& context, Reader reader)
 }
 } // namespace lexy
 
+//=== first chars ===//
+namespace lexy
+{
+// The characters a branch can be taken at; it could also be taken at EOF.
+// As for engines, if it isn't an ASCII set, it might be taken anywhere.
+// A rule can specify them as `_first_chars`, a token rule has the ones of its engine.
+template <typename Rule>
+constexpr _detail::ascii_set _branch_first_chars()
+{
+    if constexpr (_detail::is_detected<_detect_first_chars, Rule>)
+        return Rule::_first_chars;
+    else if constexpr (is_token_rule<Rule>)
+        return _engine_first_chars<typename Rule::token_engine>;
+    else
+        return _detail::ascii_set().insert(0x00, 0xFF);
+}
+} // namespace lexy
+
 //=== whitespace ===//
 namespace lexy::_detail
 {
@@ -5,6 +5,8 @@
 #ifndef LEXY_DSL_CHOICE_HPP_INCLUDED
 #define LEXY_DSL_CHOICE_HPP_INCLUDED
 
+#include <lexy/_detail/integer_sequence.hpp>
+#include <lexy/_detail/tuple.hpp>
 #include <lexy/dsl/base.hpp>
 #include <lexy/error.hpp>
 
@@ -93,6 +95,137 @@ struct _chc_parser<NextParser, H, T...>
     }
 };
 
+// If the branches begin with different characters, we can select the only branch that can be taken
+// by looking at the current character, instead of trying each one in order.
+// This requires that all but the last branch are conditional: an unconditional last branch is
+// taken if no other one can be.
+template <typename... R>
+struct _chc_dispatch
+{
+    using _last = typename lexy::_detail::_nth_type<sizeof...(R) - 1, R...>::type;
+
+    static constexpr auto _conditional_count
+        = _last::is_unconditional_branch ? sizeof...(R) - 1 : sizeof...(R);
+
+    static constexpr auto _first_chars = [] {
+        struct result_t
+        {
+            lexy::_detail::ascii_set data[sizeof...(R)];
+        };
+        return result_t{{lexy::_branch_first_chars<R>()...}};
+    }();
+
+    static constexpr bool _can_dispatch = [] {
+        if (_conditional_count < 2)
+            return false;
+
+        constexpr bool is_unconditional[] = {R::is_unconditional_branch...};
+        for (auto idx = std::size_t(0); idx != _conditional_count; ++idx)
+        {
+            auto& set = _first_chars.data[idx];
+            if (is_unconditional[idx] || !set.is_ascii())
+                return false;
+
+            // Every character may only begin one branch.
+            for (auto other = std::size_t(0); other != idx; ++other)
+                for (auto c = std::size_t(0); c <= 0x7F; ++c)
+                    if (set.contains(c) && _first_chars.data[other].contains(c))
+                        return false;
+        }
+        return true;
+    }();
+
+    // Maps each ASCII character to the index of its branch plus one, or zero if there is none.
+    static constexpr auto _table = [] {
+        struct table_t
+        {
+            unsigned char data[0x80];
+        } result{};
+        for (auto idx = std::size_t(0); idx != _conditional_count; ++idx)
+            for (auto c = std::size_t(0); c <= 0x7F; ++c)
+                if (_first_chars.data[idx].contains(c))
+                    result.data[c] = static_cast<unsigned char>(idx + 1);
+        return result;
+    }();
+};
+
+template <typename NextParser, typename Indices, typename... R>
+struct _chc_dispatch_parser;
+template <typename NextParser, std::size_t... Idx, typename... R>
+struct _chc_dispatch_parser<NextParser, lexy::_detail::index_sequence<Idx...>, R...>
+{
+    using _dispatch = _chc_dispatch<R...>;
+    using _last     = typename _dispatch::_last;
+
+    template <std::size_t I>
+    using _branch_parser
+        = lexy::rule_parser<typename lexy::_detail::_nth_type<I, R...>::type, NextParser>;
+
+    // What we do if none of the conditional branches can be taken.
+    using _fallback = std::conditional_t<_last::is_unconditional_branch,
+                                         _chc_parser<NextParser, _last>, _chc_parser<NextParser>>;
+
+    // Returns the branch that can be taken at the current character plus one, or zero.
+    template <typename Reader>
+    LEXY_DSL_FUNC std::size_t _select(const Reader& reader)
+    {
+        auto cur = reader.peek();
+        if (cur == Reader::encoding::eof())
+            // As we don't know what branches can be taken at EOF, we need to try all of them.
+            return std::size_t(-1);
+
+        auto code_unit = static_cast<std::size_t>(cur);
+        return code_unit <= 0x7F ? _dispatch::_table.data[code_unit] : 0u;
+    }
+
+    // Tries to parse the selected branch; backtracks if there is none.
+    template <typename Context, typename Reader, typename... Args>
+    LEXY_DSL_FUNC auto _try_parse_branch(std::size_t branch, Context& context, Reader& reader,
+                                         Args&&... args) -> lexy::rule_try_parse_result
+    {
+        // The comparisons against the dense branch index are turned into a jump table by the
+        // compiler.
+        auto result = lexy::rule_try_parse_result::backtracked;
+        (void)((branch == Idx + 1
+                && (result = _branch_parser<Idx>::try_parse(context, reader, LEXY_FWD(args)...),
+                    true))
+               || ...);
+        return result;
+    }
+
+    template <typename Context, typename Reader, typename... Args>
+    LEXY_DSL_FUNC auto try_parse(Context& context, Reader& reader, Args&&... args)
+        -> lexy::rule_try_parse_result
+    {
+        auto branch = _select(reader);
+        if (branch == std::size_t(-1))
+            return _chc_parser<NextParser, R...>::try_parse(context, reader, LEXY_FWD(args)...);
+
+        auto result = _try_parse_branch(branch, context, reader, LEXY_FWD(args)...);
+        if (result != lexy::rule_try_parse_result::backtracked)
+            // We've taken the branch, return its result.
+            return result;
+
+        // No other conditional branch can be taken here.
+        return _fallback::try_parse(context, reader, LEXY_FWD(args)...);
+    }
+
+    template <typename Context, typename Reader, typename... Args>
+    LEXY_DSL_FUNC bool parse(Context& context, Reader& reader, Args&&... args)
+    {
+        auto branch = _select(reader);
+        if (branch == std::size_t(-1))
+            return _chc_parser<NextParser, R...>::parse(context, reader, LEXY_FWD(args)...);
+
+        auto result = _try_parse_branch(branch, context, reader, LEXY_FWD(args)...);
+        if (result != lexy::rule_try_parse_result::backtracked)
+            // We've taken the branch, return its translated result.
+            return static_cast<bool>(result);
+
+        return _fallback::parse(context, reader, LEXY_FWD(args)...);
+    }
+};
+
 template <typename... R>
 struct _chc : rule_base
 {
@@ -103,8 +236,44 @@ struct _chc : rule_base
     static constexpr auto is_branch              = !_would_be_unconditional_branch;
     static constexpr auto is_unconditonal_branch = false;
 
+    static constexpr auto _first_chars = [] {
+        lexy::_detail::ascii_set result;
+        if constexpr (_would_be_unconditional_branch)
+            result.insert(0x00, 0xFF);
+        else
+            (result.insert(lexy::_branch_first_chars<R>()), ...);
+        return result;
+    }();
+
+    // A function, so we only analyze the branches if we're actually parsing the choice.
+    static constexpr bool _use_dispatch()
+    {
+        return _chc_dispatch<R...>::_can_dispatch;
+    }
+
     template <typename NextParser>
-    using parser = _chc_parser<NextParser, R...>;
+    struct parser
+    {
+        using _impl = std::conditional_t<
+            _use_dispatch(),
+            _chc_dispatch_parser<
+                NextParser,
+                lexy::_detail::make_index_sequence<_chc_dispatch<R...>::_conditional_count>, R...>,
+            _chc_parser<NextParser, R...>>;
+
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC auto try_parse(Context& context, Reader& reader, Args&&... args)
+            -> lexy::rule_try_parse_result
+        {
+            return _impl::try_parse(context, reader, LEXY_FWD(args)...);
+        }
+
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC bool parse(Context& context, Reader& reader, Args&&... args)
+        {
+            return _impl::parse(context, reader, LEXY_FWD(args)...);
+        }
+    };
 };
 
 template <typename R, typename S>
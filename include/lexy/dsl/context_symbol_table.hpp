@@ -0,0 +1,176 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_DSL_CONTEXT_SYMBOL_TABLE_HPP_INCLUDED
+#define LEXY_DSL_CONTEXT_SYMBOL_TABLE_HPP_INCLUDED
+
+#include <lexy/dsl/base.hpp>
+#include <lexy/dsl/identifier.hpp>
+#include <lexy/dsl/symbol.hpp>
+#include <lexy/dynamic_symbol_table.hpp>
+
+namespace lexyd
+{
+template <typename Reader>
+using _ctx_symbol_table
+    = lexy::dynamic_symbol_table<lexy::lexeme<Reader>, typename Reader::encoding::char_type>;
+
+template <typename Id>
+struct _ctx_screate : rule_base
+{
+    template <typename NextParser>
+    struct parser
+    {
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC bool parse(Context& context, Reader& reader, Args&&... args)
+        {
+            static_assert(!Context::contains(Id{}));
+            lexy::_detail::parse_context_var table_ctx(context, Id{},
+                                                       _ctx_symbol_table<Reader>());
+            return NextParser::parse(table_ctx, reader, LEXY_FWD(args)...);
+        }
+    };
+};
+
+template <typename Id, typename Identifier>
+struct _ctx_sinsert : rule_base
+{
+    static constexpr auto is_branch = true;
+
+    template <typename NextParser>
+    struct parser
+    {
+        template <typename... Args>
+        struct _cont
+        {
+            template <typename Context, typename Reader>
+            LEXY_DSL_FUNC bool parse(Context& context, Reader& reader, Args&&... args,
+                                     lexy::lexeme<Reader> lexeme)
+            {
+                // If the identifier is already in the table, we keep the original one.
+                context.get(Id{}).insert(lexeme, lexeme);
+                return NextParser::parse(context, reader, LEXY_FWD(args)..., lexeme);
+            }
+        };
+
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC auto try_parse(Context& context, Reader& reader, Args&&... args)
+            -> lexy::rule_try_parse_result
+        {
+            return lexy::rule_parser<Identifier, _cont<Args...>>::try_parse(context, reader,
+                                                                            LEXY_FWD(args)...);
+        }
+
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC bool parse(Context& context, Reader& reader, Args&&... args)
+        {
+            return lexy::rule_parser<Identifier, _cont<Args...>>::parse(context, reader,
+                                                                        LEXY_FWD(args)...);
+        }
+    };
+};
+
+template <typename Id, typename Identifier, typename Tag>
+struct _ctx_slookup : rule_base
+{
+    static constexpr auto is_branch               = true;
+    static constexpr auto is_unconditional_branch = false;
+
+    template <typename NextParser>
+    struct parser
+    {
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC auto try_parse(Context& context, Reader& reader, Args&&... args)
+            -> lexy::rule_try_parse_result
+        {
+            // We only need to parse the pattern of the identifier: a reserved identifier can't be
+            // in the table, as it couldn't have been inserted.
+            using engine = typename decltype(Identifier{}.pattern())::token_engine;
+            auto save    = reader;
+            auto idx     = typename _ctx_symbol_table<Reader>::key_index();
+            if (auto ec = engine::match(reader); ec == typename engine::error_code())
+                idx = context.get(Id{}).lookup(lexy::lexeme(reader, save.cur()));
+            if (!idx)
+            {
+                // We didn't have an identifier that is in the table, so backtrack.
+                context.on(_ev::backtracked{}, save.cur(), reader.cur());
+                reader = LEXY_MOV(save);
+                return lexy::rule_try_parse_result::backtracked;
+            }
+
+            context.on(_ev::token{}, lexy::identifier_token_kind, save.cur(), reader.cur());
+            using continuation = lexy::whitespace_parser<Context, NextParser>;
+            return static_cast<lexy::rule_try_parse_result>(
+                continuation::parse(context, reader, LEXY_FWD(args)...,
+                                    context.get(Id{})[idx]));
+        }
+
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC bool parse(Context& context, Reader& reader, Args&&... args)
+        {
+            // Again, parse pattern only.
+            using pattern = decltype(Identifier{}.pattern());
+            using engine  = typename pattern::token_engine;
+            auto begin    = reader.cur();
+            if (auto ec = engine::match(reader); ec != typename engine::error_code())
+            {
+                pattern::token_error(context, reader, ec, begin);
+                return false;
+            }
+            auto lexeme = lexy::lexeme(reader, begin);
+            context.on(_ev::token{}, lexy::identifier_token_kind, lexeme.begin(), lexeme.end());
+
+            auto idx = context.get(Id{}).lookup(lexeme);
+            if (!idx)
+            {
+                using tag = lexy::_detail::type_or<Tag, lexy::unknown_symbol>;
+                auto err  = lexy::make_error<Reader, tag>(lexeme.begin(), lexeme.end());
+                context.on(_ev::error{}, err);
+                return false;
+            }
+
+            using continuation = lexy::whitespace_parser<Context, NextParser>;
+            return continuation::parse(context, reader, LEXY_FWD(args)...,
+                                       context.get(Id{})[idx]);
+        }
+    };
+
+    template <typename Error>
+    static constexpr _ctx_slookup<Id, Identifier, Error> error = {};
+};
+} // namespace lexyd
+
+namespace lexyd
+{
+template <typename Id, typename Identifier>
+struct _ctx_symbol_table_dsl
+{
+    struct id
+    {};
+
+    constexpr auto create() const
+    {
+        return _ctx_screate<id>{};
+    }
+
+    constexpr auto insert() const
+    {
+        return _ctx_sinsert<id, Identifier>{};
+    }
+
+    constexpr auto lookup() const
+    {
+        return _ctx_slookup<id, Identifier, void>{};
+    }
+};
+
+/// Declares a context variable that stores a set of the given identifiers.
+template <typename Id, typename Leading, typename Trailing, typename... Reserved>
+constexpr auto context_symbol_table(_id<Leading, Trailing, Reserved...>)
+{
+    return _ctx_symbol_table_dsl<Id, _id<Leading, Trailing, Reserved...>>{};
+}
+} // namespace lexyd
+
+#endif // LEXY_DSL_CONTEXT_SYMBOL_TABLE_HPP_INCLUDED
@@ -16,6 +16,7 @@
 #include <lexy/dsl/symbol.hpp>
 #include <lexy/dsl/value.hpp>
 #include <lexy/dsl/whitespace.hpp>
+#include <lexy/engine/char_class.hpp>
 #include <lexy/lexeme.hpp>
 
 #ifdef LEXY_IGNORE_DEPRECATED_ESCAPE
@@ -69,9 +70,49 @@ constexpr auto _del_parse_char(Context& context, Reader& reader, Sink& sink)
     return true;
 }
 
+template <typename Token>
+using _detect_token_engine = typename Token::token_engine;
+
 template <typename Close, typename Char, typename Limit, typename... Escapes>
 struct _del : rule_base
 {
+    // The characters that are matched by `Char`, but where none of the other rules can match.
+    // A run of them can be added to the sink as a single lexeme.
+    static constexpr auto _plain_chars = [] {
+        using char_engine = typename Char::token_engine;
+
+        lexy::_detail::ascii_set result;
+        if constexpr (lexy::_engine_is_ascii_set<char_engine> //
+                      && lexy::_detail::is_detected<_detect_token_engine, Close>)
+        {
+            constexpr auto stop_chars
+                = lexy::_engine_first_chars<typename Close::token_engine,
+                                            typename Limit::token_engine,
+                                            typename Escapes::_lead_engine...>;
+            if constexpr (stop_chars.is_ascii())
+            {
+                for (auto c = std::size_t(0); c <= 0x7F; ++c)
+                    if (char_engine::_ascii_set.contains(c) && !stop_chars.contains(c))
+                        result.insert(c);
+            }
+        }
+        return result;
+    }();
+
+    template <typename Context, typename Reader, typename Sink>
+    static void _parse_plain_chars(Context& context, Reader& reader, Sink& sink)
+    {
+        auto begin = reader.cur();
+        lexy::_skip_ascii_set<_plain_chars>(reader);
+        auto end = reader.cur();
+
+        if (begin != end)
+        {
+            context.on(_ev::token{}, Char::token_kind(), begin, end);
+            sink(lexy::lexeme<Reader>(begin, end));
+        }
+    }
+
     template <typename NextParser>
     struct parser
     {
@@ -84,6 +125,15 @@ struct _del : rule_base
             using close = lexy::rule_parser<Close, _list_finish<NextParser, Args...>>;
             while (true)
             {
+                // Consume characters that can't be anything else at once.
+                // This changes the sink calls and token events compared to other readers,
+                // which add each character separately.
+                if constexpr (_plain_chars.size() > 0 && lexy::_is_contiguous_reader<Reader>)
+                {
+                    if (!LEXY_IS_CONSTANT_EVALUATED())
+                        _parse_plain_chars(context, reader, sink);
+                }
+
                 // Try to finish parsing the production.
                 if (auto result = close::try_parse(context, reader, LEXY_FWD(args)..., sink);
                     result != lexy::rule_try_parse_result::backtracked)
@@ -245,6 +295,8 @@ struct _escape_cap : rule_base
 template <typename Escape, typename... Branches>
 struct _escape : decltype(_escape_rule<Escape>(Branches{}...)), _escape_base
 {
+    using _lead_engine = typename Escape::token_engine;
+
     /// Adds a generic escape rule.
     template <typename Branch>
     constexpr auto rule(Branch) const
@@ -6,6 +6,7 @@
 #define LEXY_DSL_IDENTIFIER_HPP_INCLUDED
 
 #include <lexy/_detail/nttp_string.hpp>
+#include <lexy/_detail/perfect_hash.hpp>
 #include <lexy/dsl/alternative.hpp>
 #include <lexy/dsl/any.hpp>
 #include <lexy/dsl/base.hpp>
@@ -91,11 +92,116 @@ struct _contains : token_base<_contains<R>>
 template <typename String, typename Id>
 struct _kw;
 
+// Whether the reserved rule is a literal whose characters have the given type.
+template <typename CharT, typename R>
+constexpr bool _is_reserved_lit = [] {
+    if constexpr (_can_use_trie<R>)
+        return std::is_same_v<typename R::string::char_type, CharT>;
+    else
+        return false;
+}();
+
+template <typename CharT, typename R>
+constexpr auto _reserved_lit_string()
+{
+    if constexpr (_is_reserved_lit<CharT, R>)
+        return R::string::get();
+    else
+        return lexy::_detail::basic_string_view<CharT>();
+}
+
+// The strings of all reserved literals.
+template <typename CharT, typename... Reserved>
+struct _reserved_lits
+{
+    static constexpr bool is_lit[] = {_is_reserved_lit<CharT, Reserved>...};
+    static constexpr auto count    = [] {
+        auto result = std::size_t(0);
+        for (auto lit : is_lit)
+            if (lit)
+                ++result;
+        return result;
+    }();
+
+    static constexpr auto strings = [] {
+        using string_view = lexy::_detail::basic_string_view<CharT>;
+        string_view all[] = {_reserved_lit_string<CharT, Reserved>()...};
+
+        struct strings_t
+        {
+            string_view data[count == 0 ? 1 : count];
+        } result{};
+        auto idx = std::size_t(0);
+        for (auto i = std::size_t(0); i != sizeof...(Reserved); ++i)
+            if (is_lit[i])
+                result.data[idx++] = all[i];
+        return result;
+    }();
+};
+
+template <typename CharT, typename... Reserved>
+constexpr auto _reserved_lit_hash
+    = lexy::_detail::make_perfect_hash<CharT, _reserved_lits<CharT, Reserved...>::count>(
+        _reserved_lits<CharT, Reserved...>::strings.data);
+
 template <typename Leading, typename Trailing, typename... Reserved>
 struct _id : rule_base
 {
     static constexpr auto is_branch = true;
 
+    // If there are a lot of reserved literals, we look up the identifier in a hash table instead
+    // of matching it against them; the other reserved rules are still matched.
+    // The literals need to have the same character type; we pick the most likely one.
+    template <typename Reader>
+    using _hash_char_type = std::conditional_t<sizeof(typename Reader::encoding::char_type) == 1,
+                                               char, typename Reader::encoding::char_type>;
+    template <typename Reader>
+    static constexpr bool _hash_reserved = [] {
+        using char_type = typename Reader::encoding::char_type;
+        if constexpr (!std::is_pointer_v<typename Reader::iterator>
+                      || !std::is_integral_v<char_type>)
+            return false;
+        else if constexpr (_reserved_lits<_hash_char_type<Reader>, Reserved...>::count
+                           < lexy::_detail::perfect_hash_threshold)
+            return false;
+        else
+            return _reserved_lit_hash<_hash_char_type<Reader>, Reserved...>._valid;
+    }();
+
+    template <typename Reader>
+    static constexpr bool _is_reserved(Reader reader, typename Reader::iterator end)
+    {
+        auto id_reader = lexy::partial_reader(reader, end);
+        if constexpr (_hash_reserved<Reader>)
+        {
+            using char_type = _hash_char_type<Reader>;
+
+            auto& hash = _reserved_lit_hash<char_type, Reserved...>;
+            auto  size = static_cast<std::size_t>(end - reader.cur());
+            if (hash.lookup(reader.cur(), size) != hash.invalid_value)
+                return true;
+
+            auto match_other = [&](auto r) {
+                using rule = decltype(r);
+                if constexpr (_is_reserved_lit<char_type, rule>)
+                    return false;
+                else
+                {
+                    auto copy = id_reader;
+                    return lexy::engine_try_match<typename rule::token_engine>(copy)
+                           && copy.cur() == end;
+                }
+            };
+            return (match_other(Reserved{}) || ...);
+        }
+        else
+        {
+            using reserved = decltype((Reserved{} / ...));
+            return lexy::engine_try_match<typename reserved::token_engine>(id_reader)
+                   && id_reader.cur() == end;
+        }
+    }
+
     template <typename NextParser>
     struct parser
     {
@@ -110,11 +216,7 @@ struct _id : rule_base
             // Check that we're not creating a reserved identifier.
             if constexpr (sizeof...(Reserved) > 0)
             {
-                using reserved = decltype((Reserved{} / ...));
-
-                auto id_reader = lexy::partial_reader(saved_reader, end);
-                if (lexy::engine_try_match<typename reserved::token_engine>(id_reader)
-                    && id_reader.cur() == end)
+                if (_is_reserved(saved_reader, end))
                 {
                     // We found a reserved identifier.
                     auto err = lexy::make_error<Reader, lexy::reserved_identifier>(begin, end);
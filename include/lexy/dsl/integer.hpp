@@ -8,6 +8,7 @@
 #include <climits>
 
 #include <lexy/_detail/assert.hpp>
+#include <lexy/_detail/swar.hpp>
 #include <lexy/code_point.hpp>
 #include <lexy/dsl/base.hpp>
 #include <lexy/dsl/digit.hpp>
@@ -245,6 +246,22 @@ struct _bounded_integer_parser
 
     static constexpr auto radix = Base::radix;
 
+    // Whether we can convert blocks of eight digits at once.
+    template <typename Iterator>
+    static constexpr bool _can_parse_8digits = [] {
+        if constexpr (AssumeOnlyDigits && std::is_integral_v<result_type>
+                      && std::is_pointer_v<Iterator>)
+        {
+            constexpr auto is_known_base
+                = std::is_same_v<Base, decimal> || std::is_same_v<Base, hex>
+                  || std::is_same_v<Base, hex_lower> || std::is_same_v<Base, hex_upper>;
+            return is_known_base && sizeof(std::remove_pointer_t<Iterator>) == 1
+                   && traits::template max_digit_count<radix> > 9;
+        }
+        else
+            return false;
+    }();
+
     template <typename Iterator>
     static constexpr unsigned find_digit(Iterator& cur, Iterator end)
     {
@@ -294,7 +311,22 @@ struct _bounded_integer_parser
 
         // Handle max_digit_count - 1 digits without checking for overflow.
         // We cannot overflow, as the maximal value has one digit more.
-        for (std::size_t digit_count = 1; digit_count < max_digit_count - 1; ++digit_count)
+        std::size_t digit_count = 1;
+        if constexpr (_can_parse_8digits<Iterator>)
+        {
+            // Handle as many of them as possible in blocks of eight digits.
+            constexpr auto factor = result_type(result_type(radix * radix * radix * radix)
+                                                * result_type(radix * radix * radix * radix));
+            while (digit_count + 8 < max_digit_count && end - cur >= 8)
+            {
+                auto block = lexy::_detail::swar_parse_8digits<radix>(cur);
+                result     = result_type(result * factor + result_type(block));
+
+                cur += 8;
+                digit_count += 8;
+            }
+        }
+        for (; digit_count < max_digit_count - 1; ++digit_count)
         {
             auto digit = find_digit(cur, end);
             if (digit == unsigned(-1))
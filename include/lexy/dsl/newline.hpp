@@ -8,6 +8,7 @@
 #include <lexy/_detail/nttp_string.hpp>
 #include <lexy/dsl/base.hpp>
 #include <lexy/dsl/token.hpp>
+#include <lexy/engine/char_class.hpp>
 #include <lexy/engine/trie.hpp>
 #include <lexy/token.hpp>
 
@@ -48,6 +49,8 @@ struct _eol : token_base<_eol>
             else
                 return _nl::token_engine::match(reader);
         }
+
+        static constexpr auto _first_chars = lexy::_engine_first_chars<_nl::token_engine>;
     };
 
     static LEXY_CONSTEVAL auto token_kind()
@@ -36,6 +36,8 @@ struct _peek : rule_base
 {
     static constexpr auto is_branch = true;
 
+    static constexpr auto _first_chars = lexy::_engine_first_chars<Engine>;
+
     template <typename NextParser>
     struct parser
     {
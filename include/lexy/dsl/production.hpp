@@ -26,6 +26,8 @@ struct _prd : rule_base
     static constexpr auto is_branch               = _rule::is_branch;
     static constexpr auto is_unconditional_branch = _rule::is_unconditional_branch;
 
+    static constexpr auto _first_chars = lexy::_branch_first_chars<_rule>();
+
     template <typename NextParser>
     struct parser : lexy::_detail::production_parser<Production, NextParser>
     {};
@@ -0,0 +1,135 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_DSL_REAL_HPP_INCLUDED
+#define LEXY_DSL_REAL_HPP_INCLUDED
+
+#include <lexy/_detail/real_conversion.hpp>
+#include <lexy/dsl/base.hpp>
+#include <lexy/dsl/digit.hpp>
+#include <lexy/dsl/token.hpp>
+#include <lexy/engine/char_class.hpp>
+#include <lexy/engine/digits.hpp>
+
+namespace lexyd
+{
+// Matches `integer [. digits] [(e|E) [+|-] digits]`.
+// The fraction and exponent are only consumed if they are followed by a digit.
+template <typename IntegerEngine>
+struct _real_engine : lexy::engine_matcher_base
+{
+    using error_code = typename IntegerEngine::error_code;
+
+    static constexpr auto _exponent_trie = lexy::shallow_trie<LEXY_NTTP_STRING("eE")>;
+    static constexpr auto _sign_trie     = lexy::shallow_trie<LEXY_NTTP_STRING("+-")>;
+
+    using _digits   = lexy::engine_digits<decimal::digit_set>;
+    using _point    = lexy::engine_char_range<'.', '.'>;
+    using _exponent = lexy::engine_char_set<_exponent_trie>;
+    using _sign     = lexy::engine_char_set<_sign_trie>;
+
+    template <typename Reader>
+    static constexpr error_code match(Reader& reader)
+    {
+        if (auto ec = IntegerEngine::match(reader); ec != error_code())
+            return ec;
+
+        if (auto fraction = reader;
+            lexy::engine_try_match<_point>(fraction) && lexy::engine_try_match<_digits>(fraction))
+            reader = LEXY_MOV(fraction);
+
+        if (auto exponent = reader; lexy::engine_try_match<_exponent>(exponent))
+        {
+            lexy::engine_try_match<_sign>(exponent);
+            if (lexy::engine_try_match<_digits>(exponent))
+                reader = LEXY_MOV(exponent);
+        }
+
+        return error_code();
+    }
+
+    static constexpr auto _first_chars = lexy::_engine_first_chars<IntegerEngine>;
+};
+
+template <bool NoLeadingZero>
+struct _real_token : token_base<_real_token<NoLeadingZero>>
+{
+    using _integer_engine
+        = std::conditional_t<NoLeadingZero,
+                             lexy::engine_digits_trimmed<decimal::digit_set, _zero::token_engine>,
+                             lexy::engine_digits<decimal::digit_set>>;
+    using token_engine = _real_engine<_integer_engine>;
+
+    template <typename Context, typename Reader>
+    static constexpr void token_error(Context& context, const Reader& reader,
+                                      typename token_engine::error_code ec,
+                                      typename Reader::iterator         pos)
+    {
+        if constexpr (NoLeadingZero)
+        {
+            if (ec == token_engine::error_code::leading_zero)
+            {
+                auto err
+                    = lexy::make_error<Reader, lexy::forbidden_leading_zero>(pos, reader.cur());
+                context.on(_ev::error{}, err);
+                return;
+            }
+        }
+
+        auto err = lexy::make_error<Reader, lexy::expected_char_class>(pos, decimal::name());
+        context.on(_ev::error{}, err);
+    }
+};
+
+template <typename T, typename Token>
+struct _real : rule_base
+{
+    static constexpr auto is_branch               = true;
+    static constexpr auto is_unconditional_branch = false;
+
+    template <typename NextParser>
+    struct parser
+    {
+        struct _continuation
+        {
+            template <typename Context, typename Reader, typename... Args>
+            LEXY_DSL_FUNC bool parse(Context& context, Reader& reader,
+                                     typename Reader::iterator begin, Args&&... args)
+            {
+                auto value = lexy::_detail::parse_real<T>(begin, reader.cur());
+                return NextParser::parse(context, reader, LEXY_FWD(args)..., value);
+            }
+        };
+
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC auto try_parse(Context& context, Reader& reader, Args&&... args)
+            -> lexy::rule_try_parse_result
+        {
+            return lexy::rule_parser<Token, _continuation>::try_parse(context, reader,
+                                                                      reader.cur(),
+                                                                      LEXY_FWD(args)...);
+        }
+
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC bool parse(Context& context, Reader& reader, Args&&... args)
+        {
+            return lexy::rule_parser<Token, _continuation>::parse(context, reader, reader.cur(),
+                                                                  LEXY_FWD(args)...);
+        }
+    };
+
+    /// Forbids leading zeroes in the integer part, like JSON.
+    constexpr auto no_leading_zero() const
+    {
+        return _real<T, _real_token<true>>{};
+    }
+};
+
+/// Parses a decimal floating point number of type `T` without sign.
+template <typename T>
+constexpr auto real = _real<T, _real_token<false>>{};
+} // namespace lexyd
+
+#endif // LEXY_DSL_REAL_HPP_INCLUDED
+
@@ -5,9 +5,14 @@
 #ifndef LEXY_DSL_SWITCH_HPP_INCLUDED
 #define LEXY_DSL_SWITCH_HPP_INCLUDED
 
+#include <lexy/_detail/integer_sequence.hpp>
+#include <lexy/_detail/tuple.hpp>
+#include <lexy/dsl/alternative.hpp>
 #include <lexy/dsl/any.hpp>
 #include <lexy/dsl/base.hpp>
 #include <lexy/dsl/branch.hpp>
+#include <lexy/engine/char_class.hpp>
+#include <lexy/engine/trie.hpp>
 
 #ifdef LEXY_IGNORE_DEPRECATED_SWITCH
 #    define LEXY_DEPRECATED_SWITCH
@@ -34,6 +39,29 @@ struct _switch_case : rule_base
 {
     static constexpr auto is_branch = true;
 
+    using _condition = Token;
+    using _value     = Value;
+
+    // Whether the token can match a value that begins with the current character.
+    template <typename PartialReader>
+    static constexpr bool _can_begin_with(const PartialReader& partial)
+    {
+        using engine = typename Token::token_engine;
+        if constexpr (_can_use_trie<Token> || lexy::_engine_is_ascii_set<engine>
+                      || !lexy::_engine_first_chars<engine>.is_ascii())
+        {
+            // Either the engine checks the character as fast as we do, or we don't know them.
+            (void)partial;
+            return true;
+        }
+        else
+        {
+            auto cur = partial.peek();
+            return cur == PartialReader::encoding::eof()
+                   || lexy::_engine_first_chars<engine>.contains(static_cast<std::size_t>(cur));
+        }
+    }
+
     template <typename NextParser>
     struct parser
     {
@@ -41,7 +69,10 @@ struct _switch_case : rule_base
         LEXY_DSL_FUNC auto try_parse(Context& context, PartialReader& partial, Reader& reader,
                                      Args&&... args) -> lexy::rule_try_parse_result
         {
-            if (lexy::engine_try_match<typename Token::token_engine>(partial) && partial.eof())
+            if (!_can_begin_with(partial))
+                return lexy::rule_try_parse_result::backtracked;
+            else if (lexy::engine_try_match<typename Token::token_engine>(partial)
+                     && partial.eof())
                 return static_cast<lexy::rule_try_parse_result>(
                     lexy::rule_parser<Value, NextParser>::parse(context, reader,
                                                                 LEXY_FWD(args)...));
@@ -106,9 +137,117 @@ struct _switch_select<NextParser, H, T...>
     }
 };
 
+template <typename Case>
+constexpr bool _switch_is_literal_case = false;
+template <typename Token, typename Value>
+constexpr bool _switch_is_literal_case<_switch_case<Token, Value>> = _can_use_trie<Token>;
+
+// The number of literal cases at the beginning.
+template <typename... Cases>
+constexpr auto _switch_literal_count = [] {
+    constexpr bool is_literal[] = {_switch_is_literal_case<Cases>..., false};
+
+    auto count = std::size_t(0);
+    while (is_literal[count])
+        ++count;
+    return count;
+}();
+
+// If the first cases are literals, we can select the case by matching all of them at once using a
+// trie, instead of trying them in order.
+// The remaining cases are the default, if any, and the error.
+template <typename NextParser, typename Indices, typename... Cases>
+struct _switch_trie_select;
+template <typename NextParser, std::size_t... Idx, typename... Cases>
+struct _switch_trie_select<NextParser, lexy::_detail::index_sequence<Idx...>, Cases...>
+{
+    template <std::size_t I>
+    using _case = typename lexy::_detail::_nth_type<I, Cases...>::type;
+
+    using _trie = _alt_trie<typename _case<Idx>::_condition...>;
+
+    // The trie requires distinct literals; the first of duplicated cases would be taken.
+    static constexpr bool _can_use = [] {
+        using char_type = std::common_type_t<typename _case<Idx>::_condition::string::char_type...>;
+        auto strings
+            = lexy::_trie_strings<char_type, typename _case<Idx>::_condition::string...>;
+        for (auto i = std::size_t(0); i != sizeof...(Idx); ++i)
+            for (auto j = std::size_t(0); j != i; ++j)
+                if (strings[i] == strings[j])
+                    return false;
+        return true;
+    }();
+
+    static auto _fallback_impl()
+    {
+        if constexpr (sizeof...(Idx) + 2 == sizeof...(Cases))
+            return _switch_select<NextParser, _case<sizeof...(Idx)>, _case<sizeof...(Idx) + 1>>{};
+        else
+            return _switch_select<NextParser, _case<sizeof...(Idx)>>{};
+    }
+    using _fallback = decltype(_fallback_impl());
+
+    template <typename Context, typename Reader, typename... Args>
+    LEXY_DSL_FUNC bool parse(Context& context, Reader& reader, Reader save, Args&&... args)
+    {
+        // The trie matches the longest literal, so one of them matches the entire value only if
+        // that one does.
+        using engine = lexy::engine_trie<_trie::trie>;
+        auto partial = lexy::partial_reader(save, reader.cur());
+        auto ec      = typename engine::error_code();
+        auto idx     = engine::parse(ec, partial);
+        if (ec != typename engine::error_code() || !partial.eof())
+            return _fallback::parse(context, reader, save, LEXY_FWD(args)...);
+
+        auto result = false;
+        (void)((idx == Idx ? (result = lexy::rule_parser<typename _case<Idx>::_value,
+                                                         NextParser>::parse(context, reader,
+                                                                            LEXY_FWD(args)...),
+                              true)
+                           : false)
+               || ...);
+        return result;
+    }
+};
+
 template <typename Rule, typename Error, typename... Cases>
 struct _switch : rule_base
 {
+    template <typename NextParser>
+    static auto _select()
+    {
+        using ordered = _switch_select<NextParser, Cases..., Error>;
+
+        // We can use the trie if the literals are only followed by the default, if any.
+        constexpr auto literal_count = _switch_literal_count<Cases...>;
+        constexpr auto use_trie      = [] {
+            if constexpr (literal_count == 0)
+                return false;
+            else if constexpr (literal_count == sizeof...(Cases))
+                return true;
+            else if constexpr (literal_count + 1 == sizeof...(Cases))
+                return lexy::_detail::_nth_type<literal_count,
+                                                Cases...>::type::is_unconditional_branch;
+            else
+                return false;
+        }();
+
+        if constexpr (use_trie)
+        {
+            using trie = _switch_trie_select<NextParser,
+                                             lexy::_detail::make_index_sequence<literal_count>,
+                                             Cases..., Error>;
+            if constexpr (trie::_can_use)
+                return trie{};
+            else
+                return ordered{};
+        }
+        else
+        {
+            return ordered{};
+        }
+    }
+
     template <typename NextParser>
     struct parser
     {
@@ -117,7 +256,7 @@ struct _switch : rule_base
         {
             // We parse the rule using our special continuation.
             // To recover the old reader position, we create a copy.
-            using cont = _switch_select<NextParser, Cases..., Error>;
+            using cont = decltype(_select<NextParser>());
             return lexy::rule_parser<Rule, cont>::parse(context, reader, Reader(reader),
                                                         LEXY_FWD(args)...);
         }
@@ -8,6 +8,7 @@
 #include <lexy/_detail/integer_sequence.hpp>
 #include <lexy/_detail/iterator.hpp>
 #include <lexy/_detail/nttp_string.hpp>
+#include <lexy/_detail/perfect_hash.hpp>
 #include <lexy/dsl/base.hpp>
 #include <lexy/engine/trie.hpp>
 #include <lexy/engine/while.hpp>
@@ -182,6 +183,27 @@ public:
             return key_index();
     }
 
+    /// Returns the symbol that is exactly the lexeme, if any.
+    template <typename Reader>
+    constexpr key_index lookup(lexy::lexeme<Reader> lexeme) const
+    {
+        static_assert(!empty(), "symbol table must not be empty");
+        if constexpr (_use_hash<Reader>)
+        {
+            auto idx = _lazy_hash::hash.lookup(lexeme.begin(), lexeme.size());
+            return idx == _lazy_hash::hash.invalid_value ? key_index() : key_index(idx);
+        }
+        else
+        {
+            using encoding = typename Reader::encoding;
+            using iterator = typename Reader::iterator;
+            auto reader    = lexy::_detail::range_reader<encoding, iterator>(lexeme.begin(),
+                                                                          lexeme.end());
+            auto idx       = try_parse(reader);
+            return reader.eof() ? idx : key_index();
+        }
+    }
+
     constexpr const T& operator[](key_index idx) const noexcept
     {
         LEXY_PRECONDITION(idx);
@@ -193,7 +215,61 @@ private:
     {
         static constexpr auto trie = lexy::trie<char_type, Strings...>;
     };
+    struct _lazy_hash
+    {
+        static constexpr auto hash = lexy::_detail::make_perfect_hash<char_type, size()>(
+            lexy::_trie_strings<char_type, Strings...>);
+    };
+
+public:
+    // Whether `lookup()` hashes the lexeme instead of matching it using the trie.
+    // This is faster for big tables, but requires a contiguous input whose code units can be
+    // compared to the symbols directly.
+    template <typename Reader>
+    static constexpr bool _use_hash = [] {
+        using reader_char_type = typename Reader::encoding::char_type;
+        if constexpr (size() < lexy::_detail::perfect_hash_threshold
+                      || !std::is_pointer_v<typename Reader::iterator>
+                      || !std::is_integral_v<reader_char_type>
+                      || sizeof(reader_char_type) != sizeof(char_type))
+            return false;
+        else
+            return _lazy_hash::hash._valid;
+    }();
+
+    // Whether all symbols are matched by the pattern exactly.
+    // For simplicity, this requires that they have the character type of the input.
+    template <typename Reader, typename Pattern>
+    static constexpr bool _matches_all = [] {
+        using encoding = typename Reader::encoding;
+        if constexpr (!std::is_same_v<typename encoding::char_type, char_type>)
+            return false;
+        else
+        {
+            using engine = typename Pattern::token_engine;
+            for (auto idx = std::size_t(0); idx != size(); ++idx)
+            {
+                auto str    = lexy::_trie_strings<char_type, Strings...>[idx];
+                auto reader = lexy::_detail::range_reader<encoding, const char_type*>(
+                    str.data(), str.data() + str.size());
+                if (!lexy::engine_try_match<engine>(reader) || !reader.eof())
+                    return false;
+            }
+            return true;
+        }
+    }();
+
+    // Whether `dsl::symbol(identifier)` parses the identifier and looks it up,
+    // instead of matching the symbols using the trie.
+    template <typename Reader, typename Pattern>
+    static constexpr bool _lookup_identifier = [] {
+        if constexpr (_use_hash<Reader>)
+            return _matches_all<Reader, Pattern>;
+        else
+            return false;
+    }();
 
+private:
     template <std::size_t... Idx, typename... Args>
     constexpr explicit _symbol_table(lexy::_detail::index_sequence<Idx...>, const T* data,
                                      Args&&... args)
@@ -244,11 +320,9 @@ struct _sym : rule_base
             LEXY_DSL_FUNC auto try_parse(Context& context, Reader& reader, Reader save,
                                          Args&&... args) -> lexy::rule_try_parse_result
             {
-                auto rule_content = lexy::partial_reader(save, reader.cur());
-
-                // We now re-parse what the rule has consumed.
-                auto idx = Table.try_parse(rule_content);
-                if (!idx || !rule_content.eof())
+                // We now look up what the rule has consumed.
+                auto idx = Table.lookup(lexy::lexeme<Reader>(save.cur(), reader.cur()));
+                if (!idx)
                 {
                     // Unknown symbol; backtrack.
                     context.on(_ev::backtracked{}, save.cur(), reader.cur());
@@ -316,17 +390,81 @@ struct _sym : rule_base
 // Optimization for identifiers: instead of parsing an entire identifier (which requires checking
 // every character against the char class), parse a symbol and check whether the next character
 // would continue the identifier. This is the same optimization that is done for keywords.
+//
+// For big tables, it is faster to parse the identifier and look it up in the hash table instead.
+// This requires that every symbol is an identifier, otherwise it could match a symbol that the
+// trie doesn't, or the other way round.
+// Dynamic symbol tables don't have a trie, so they always do that.
 template <const auto& Table, typename L, typename T, typename Tag>
 struct _sym<Table, _idp<L, T>, Tag> : rule_base
 {
     static constexpr auto is_branch               = true;
     static constexpr auto is_unconditional_branch = false;
 
+    using _table = std::decay_t<decltype(Table)>;
+    template <typename Reader>
+    static constexpr bool _use_lookup = _table::template _lookup_identifier<Reader, _idp<L, T>>;
+
     template <typename NextParser>
     struct parser
     {
         template <typename Context, typename Reader, typename... Args>
-        LEXY_DSL_FUNC auto try_parse(Context& context, Reader& reader, Args&&... args)
+        LEXY_DSL_FUNC auto _try_parse_lookup(Context& context, Reader& reader, Args&&... args)
+            -> lexy::rule_try_parse_result
+        {
+            using engine = typename _idp<L, T>::token_engine;
+
+            auto save = reader;
+            auto idx  = typename _table::key_index();
+            if (auto ec = engine::match(reader); ec == typename engine::error_code())
+                idx = Table.lookup(lexy::lexeme<Reader>(save.cur(), reader.cur()));
+            if (!idx)
+            {
+                // We didn't have an identifier that is a symbol, so backtrack.
+                context.on(_ev::backtracked{}, save.cur(), reader.cur());
+                reader = LEXY_MOV(save);
+                return lexy::rule_try_parse_result::backtracked;
+            }
+
+            // We've succesfully matched a symbol.
+            // Report its corresponding identifier token and produce the value.
+            context.on(_ev::token{}, _idp<L, T>::token_kind(), save.cur(), reader.cur());
+            using continuation = lexy::whitespace_parser<Context, NextParser>;
+            return static_cast<lexy::rule_try_parse_result>(
+                continuation::parse(context, reader, LEXY_FWD(args)..., Table[idx]));
+        }
+
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC bool _parse_lookup(Context& context, Reader& reader, Args&&... args)
+        {
+            using engine = typename _idp<L, T>::token_engine;
+
+            auto begin = reader.cur();
+            if (auto ec = engine::match(reader); ec != typename engine::error_code())
+            {
+                // Didn't have an identifier, so different error.
+                _idp<L, T>::token_error(context, reader, ec, begin);
+                return false;
+            }
+            auto end = reader.cur();
+            context.on(_ev::token{}, _idp<L, T>::token_kind(), begin, end);
+
+            auto idx = Table.lookup(lexy::lexeme<Reader>(begin, end));
+            if (!idx)
+            {
+                using tag = lexy::_detail::type_or<Tag, lexy::unknown_symbol>;
+                auto err  = lexy::make_error<Reader, tag>(begin, end);
+                context.on(_ev::error{}, err);
+                return false;
+            }
+
+            // We've succesfully matched a symbol, produce the value.
+            using continuation = lexy::whitespace_parser<Context, NextParser>;
+            return continuation::parse(context, reader, LEXY_FWD(args)..., Table[idx]);
+        }
+
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC auto _try_parse_trie(Context& context, Reader& reader, Args&&... args)
             -> lexy::rule_try_parse_result
         {
             using trailing_engine = typename T::token_engine;
@@ -352,7 +490,7 @@ struct _sym<Table, _idp<L, T>, Tag> : rule_base
         }
 
         template <typename Context, typename Reader, typename... Args>
-        LEXY_DSL_FUNC bool parse(Context& context, Reader& reader, Args&&... args)
+        LEXY_DSL_FUNC bool _parse_trie(Context& context, Reader& reader, Args&&... args)
         {
             using trailing_engine = typename T::token_engine;
 
@@ -398,6 +536,25 @@ struct _sym<Table, _idp<L, T>, Tag> : rule_base
             using continuation = lexy::whitespace_parser<Context, NextParser>;
             return continuation::parse(context, reader, LEXY_FWD(args)..., Table[idx]);
         }
+
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC auto try_parse(Context& context, Reader& reader, Args&&... args)
+            -> lexy::rule_try_parse_result
+        {
+            if constexpr (_use_lookup<Reader>)
+                return _try_parse_lookup(context, reader, LEXY_FWD(args)...);
+            else
+                return _try_parse_trie(context, reader, LEXY_FWD(args)...);
+        }
+
+        template <typename Context, typename Reader, typename... Args>
+        LEXY_DSL_FUNC bool parse(Context& context, Reader& reader, Args&&... args)
+        {
+            if constexpr (_use_lookup<Reader>)
+                return _parse_lookup(context, reader, LEXY_FWD(args)...);
+            else
+                return _parse_trie(context, reader, LEXY_FWD(args)...);
+        }
     };
 
     //=== dsl ===//
@@ -168,6 +168,9 @@ struct _token : token_base<_token<Rule>>
             return lexy::do_action<_production>(lexy::match_handler(), reader) ? error_code()
                                                                                : error_code::error;
         }
+
+        // The rule can only match where it can begin.
+        static constexpr auto _first_chars = lexy::_branch_first_chars<Rule>();
     };
 
     template <typename Context, typename Reader>
@@ -201,6 +201,8 @@ struct _wsn : rule_base
     static constexpr auto is_branch               = Rule::is_branch;
     static constexpr auto is_unconditional_branch = Rule::is_unconditional_branch;
 
+    static constexpr auto _first_chars = lexy::_branch_first_chars<Rule>();
+
     template <typename NextParser>
     struct parser
     {
@@ -0,0 +1,352 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_DYNAMIC_SYMBOL_TABLE_HPP_INCLUDED
+#define LEXY_DYNAMIC_SYMBOL_TABLE_HPP_INCLUDED
+
+#include <cstdint>
+#include <lexy/_detail/assert.hpp>
+#include <lexy/_detail/config.hpp>
+#include <lexy/_detail/memory_resource.hpp>
+#include <lexy/_detail/perfect_hash.hpp>
+#include <lexy/_detail/string_view.hpp>
+#include <lexy/lexeme.hpp>
+#include <new>
+
+namespace lexy
+{
+/// A symbol table whose symbols are added while parsing.
+///
+/// It is a hash table using open addressing with linear probing.
+/// The symbols are not copied: it stores pointers into the input, which must outlive the table.
+template <typename T, typename CharT = char,
+          typename MemoryResource = _detail::default_memory_resource>
+class dynamic_symbol_table
+{
+    static_assert(std::is_integral_v<CharT>, "need a character type");
+
+    struct _entry
+    {
+        const CharT*  symbol;
+        std::size_t   length;
+        std::uint64_t hash;
+        T             value;
+    };
+
+    // A slot refers to the entry with index `entry - 1`; zero means the slot is free.
+    // It also stores the hash, so colliding symbols can be skipped without accessing the entries.
+    struct _slot
+    {
+        std::size_t   entry;
+        std::uint64_t hash;
+    };
+
+    static constexpr auto _invalid_slot = std::size_t(-1);
+
+public:
+    using char_type   = CharT;
+    using key_type    = char_type;
+    using mapped_type = T;
+
+    //=== constructors ===//
+    dynamic_symbol_table() : dynamic_symbol_table(_detail::get_memory_resource<MemoryResource>()) {}
+    explicit dynamic_symbol_table(MemoryResource* resource) noexcept
+    : _resource(resource), _entries(nullptr), _slots(nullptr), _size(0), _slot_count(0)
+    {}
+
+    dynamic_symbol_table(const dynamic_symbol_table&) = delete;
+    dynamic_symbol_table(dynamic_symbol_table&& other) noexcept
+    : _resource(other._resource), _entries(other._entries), _slots(other._slots),
+      _size(other._size), _slot_count(other._slot_count)
+    {
+        other._entries    = nullptr;
+        other._slots      = nullptr;
+        other._size       = 0;
+        other._slot_count = 0;
+    }
+
+    ~dynamic_symbol_table() noexcept
+    {
+        _deallocate(_resource, _entries, _size, _slots, _slot_count);
+    }
+
+    dynamic_symbol_table& operator=(const dynamic_symbol_table&) = delete;
+    dynamic_symbol_table& operator=(dynamic_symbol_table&& other) noexcept
+    {
+        // The previous contents are destroyed by other.
+        _detail::swap(_resource, other._resource);
+        _detail::swap(_entries, other._entries);
+        _detail::swap(_slots, other._slots);
+        _detail::swap(_size, other._size);
+        _detail::swap(_slot_count, other._slot_count);
+        return *this;
+    }
+
+    //=== modifiers ===//
+    /// Adds the symbol with the value constructed from the arguments.
+    /// Does nothing and returns false if the symbol is already in the table.
+    template <typename Reader, typename... Args>
+    bool insert(lexy::lexeme<Reader> symbol, Args&&... args)
+    {
+        _check_reader<Reader>();
+        return _insert(symbol.data(), symbol.size(), LEXY_FWD(args)...);
+    }
+    template <typename... Args>
+    bool insert(const char_type* symbol, Args&&... args)
+    {
+        auto length = _detail::basic_string_view<char_type>(symbol).size();
+        return _insert(symbol, length, LEXY_FWD(args)...);
+    }
+
+    /// Removes the symbol from the table, returns false if it wasn't in the table.
+    template <typename Reader>
+    bool erase(lexy::lexeme<Reader> symbol)
+    {
+        _check_reader<Reader>();
+        return _erase(symbol.data(), symbol.size());
+    }
+    bool erase(const char_type* symbol)
+    {
+        return _erase(symbol, _detail::basic_string_view<char_type>(symbol).size());
+    }
+
+    /// Removes all symbols, but keeps the memory.
+    void clear() noexcept
+    {
+        for (auto idx = std::size_t(0); idx != _size; ++idx)
+            _entries[idx].~_entry();
+        for (auto idx = std::size_t(0); idx != _slot_count; ++idx)
+            _slots[idx] = _slot{0, 0};
+        _size = 0;
+    }
+
+    /// Ensures that `count` symbols can be inserted without a reallocation.
+    void reserve(std::size_t count)
+    {
+        if (2 * count > _slot_count)
+            _rehash(_detail::bit_ceil(2 * count));
+    }
+
+    //=== access ===//
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return _size;
+    }
+
+    struct key_index
+    {
+        std::size_t _value;
+
+        constexpr key_index() noexcept : _value(std::size_t(-1)) {}
+        constexpr explicit key_index(std::size_t idx) noexcept : _value(idx) {}
+
+        constexpr explicit operator bool() const noexcept
+        {
+            return _value != std::size_t(-1);
+        }
+
+        friend constexpr bool operator==(key_index lhs, key_index rhs) noexcept
+        {
+            return lhs._value == rhs._value;
+        }
+        friend constexpr bool operator!=(key_index lhs, key_index rhs) noexcept
+        {
+            return lhs._value != rhs._value;
+        }
+    };
+
+    /// Returns the symbol that is exactly the lexeme, if any.
+    /// The index is invalidated by inserting or erasing a symbol.
+    template <typename Reader>
+    key_index lookup(lexy::lexeme<Reader> symbol) const noexcept
+    {
+        _check_reader<Reader>();
+        return _lookup(symbol.data(), symbol.size());
+    }
+    key_index lookup(const char_type* symbol) const noexcept
+    {
+        return _lookup(symbol, _detail::basic_string_view<char_type>(symbol).size());
+    }
+
+    T& operator[](key_index idx) noexcept
+    {
+        LEXY_PRECONDITION(idx && idx._value < _size);
+        return _entries[idx._value].value;
+    }
+    const T& operator[](key_index idx) const noexcept
+    {
+        LEXY_PRECONDITION(idx && idx._value < _size);
+        return _entries[idx._value].value;
+    }
+
+    //=== dsl::symbol ===//
+    template <typename Reader>
+    key_index try_parse(Reader&) const
+    {
+        static_assert(lexy::_detail::error<Reader>,
+                      "symbol() with a dynamic symbol table requires a token or identifier");
+        return key_index();
+    }
+
+    // The symbols aren't known in advance, so `dsl::symbol(identifier)` always parses the
+    // identifier and looks it up.
+    template <typename Reader, typename Pattern>
+    static constexpr bool _lookup_identifier = true;
+
+private:
+    template <typename Reader>
+    static constexpr void _check_reader()
+    {
+        static_assert(std::is_pointer_v<typename Reader::iterator>,
+                      "dynamic symbol table requires a contiguous input");
+        static_assert(std::is_same_v<typename Reader::encoding::char_type, char_type>,
+                      "input has a different character type than the dynamic symbol table");
+    }
+
+    std::size_t _find(const char_type* symbol, std::size_t length,
+                      std::uint64_t hash) const noexcept
+    {
+        if (_slot_count == 0)
+            return _invalid_slot;
+
+        // The table is at most half full, so we will eventually reach a free slot.
+        auto mask = _slot_count - 1;
+        for (auto slot = std::size_t(hash) & mask;; slot = (slot + 1) & mask)
+        {
+            auto cur = _slots[slot];
+            if (cur.entry == 0)
+                return _invalid_slot;
+            else if (cur.hash == hash)
+            {
+                auto& entry = _entries[cur.entry - 1];
+                if (entry.length == length && _detail::equal_strings(symbol, entry.symbol, length))
+                    return slot;
+            }
+        }
+    }
+
+    key_index _lookup(const char_type* symbol, std::size_t length) const noexcept
+    {
+        auto slot = _find(symbol, length, _detail::hash_string(symbol, length));
+        if (slot == _invalid_slot)
+            return key_index();
+        else
+            return key_index(_slots[slot].entry - 1);
+    }
+
+    template <typename... Args>
+    bool _insert(const char_type* symbol, std::size_t length, Args&&... args)
+    {
+        auto hash = _detail::hash_string(symbol, length);
+        if (_find(symbol, length, hash) != _invalid_slot)
+            return false;
+
+        // The arguments might refer to an entry, so we need to construct the value before a
+        // rehash moves them.
+        T value(LEXY_FWD(args)...);
+
+        // We can store half as many entries as we have slots, so growing doubles both.
+        if (2 * (_size + 1) > _slot_count)
+            _rehash(_slot_count == 0 ? 16 : 2 * _slot_count);
+
+        ::new (static_cast<void*>(_entries + _size)) _entry{symbol, length, hash, LEXY_MOV(value)};
+        _place(_slots, _slot_count, _size, hash);
+        ++_size;
+        return true;
+    }
+
+    bool _erase(const char_type* symbol, std::size_t length) noexcept
+    {
+        auto hole = _find(symbol, length, _detail::hash_string(symbol, length));
+        if (hole == _invalid_slot)
+            return false;
+        auto idx = _slots[hole].entry - 1;
+
+        // Move the following slots of the cluster backwards into the hole, unless that would put
+        // them in front of the slot their probe sequence starts at.
+        auto mask = _slot_count - 1;
+        for (auto slot = (hole + 1) & mask; _slots[slot].entry != 0; slot = (slot + 1) & mask)
+        {
+            auto home = std::size_t(_slots[slot].hash) & mask;
+            if (((slot - home) & mask) >= ((slot - hole) & mask))
+            {
+                _slots[hole] = _slots[slot];
+                hole         = slot;
+            }
+        }
+        _slots[hole] = _slot{0, 0};
+
+        // Keep the entries contiguous by moving the last one into the erased one.
+        auto last = _size - 1;
+        if (idx != last)
+        {
+            auto slot = std::size_t(_entries[last].hash) & mask;
+            while (_slots[slot].entry != last + 1)
+                slot = (slot + 1) & mask;
+            _slots[slot].entry = idx + 1;
+
+            _entries[idx] = LEXY_MOV(_entries[last]);
+        }
+        _entries[last].~_entry();
+        --_size;
+        return true;
+    }
+
+    static void _place(_slot* slots, std::size_t slot_count, std::size_t idx,
+                       std::uint64_t hash) noexcept
+    {
+        auto mask = slot_count - 1;
+        auto slot = std::size_t(hash) & mask;
+        while (slots[slot].entry != 0)
+            slot = (slot + 1) & mask;
+        slots[slot] = _slot{idx + 1, hash};
+    }
+
+    void _rehash(std::size_t slot_count)
+    {
+        auto slots = static_cast<_slot*>(
+            _resource->allocate(slot_count * sizeof(_slot), alignof(_slot)));
+        for (auto slot = std::size_t(0); slot != slot_count; ++slot)
+            ::new (static_cast<void*>(slots + slot)) _slot{0, 0};
+
+        auto entries = static_cast<_entry*>(
+            _resource->allocate(slot_count / 2 * sizeof(_entry), alignof(_entry)));
+        for (auto idx = std::size_t(0); idx != _size; ++idx)
+        {
+            ::new (static_cast<void*>(entries + idx)) _entry(LEXY_MOV(_entries[idx]));
+            _place(slots, slot_count, idx, entries[idx].hash);
+        }
+
+        _deallocate(_resource, _entries, _size, _slots, _slot_count);
+        _entries    = entries;
+        _slots      = slots;
+        _slot_count = slot_count;
+    }
+
+    static void _deallocate(_detail::memory_resource_ptr<MemoryResource> resource,
+                            _entry* entries, std::size_t size, _slot* slots,
+                            std::size_t slot_count) noexcept
+    {
+        if (slot_count == 0)
+            return;
+
+        for (auto idx = std::size_t(0); idx != size; ++idx)
+            entries[idx].~_entry();
+        resource->deallocate(entries, slot_count / 2 * sizeof(_entry), alignof(_entry));
+        resource->deallocate(slots, slot_count * sizeof(_slot), alignof(_slot));
+    }
+
+    LEXY_EMPTY_MEMBER _detail::memory_resource_ptr<MemoryResource> _resource;
+    _entry*                                                          _entries;
+    _slot*                                                           _slots;
+    std::size_t                                                      _size, _slot_count;
+};
+} // namespace lexy
+
+#endif // LEXY_DYNAMIC_SYMBOL_TABLE_HPP_INCLUDED
@@ -250,6 +250,13 @@ constexpr bool _is_ascii(CharT c)
         return c <= 0x7F;
 }
 
+// The value of the code unit, ignoring the sign of char.
+template <typename CharT>
+constexpr std::size_t _char_to_code_unit(CharT c)
+{
+    return static_cast<std::size_t>(static_cast<std::make_unsigned_t<CharT>>(c));
+}
+
 template <typename Encoding, typename CharT>
 LEXY_CONSTEVAL auto _char_to_int_type(CharT c)
 {
@@ -19,8 +19,17 @@ struct engine_any : engine_matcher_base
     template <typename Reader>
     static constexpr error_code match(Reader& reader)
     {
-        while (!reader.eof())
-            reader.bump();
+        if constexpr (_is_contiguous_reader<Reader>)
+        {
+            // Skip a contiguous run of characters at once.
+            while (!reader.eof())
+                reader.bump(reader.remaining().size());
+        }
+        else
+        {
+            while (!reader.eof())
+                reader.bump();
+        }
         return error_code();
     }
 };
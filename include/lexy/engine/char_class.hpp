@@ -6,6 +6,7 @@
 #define LEXY_ENGINE_CHAR_CLASS_HPP_INCLUDED
 
 #include <climits>
+#include <lexy/_detail/ascii_set.hpp>
 #include <lexy/_detail/integer_sequence.hpp>
 #include <lexy/engine/base.hpp>
 
@@ -43,6 +44,9 @@ struct engine_char_range : engine_matcher_base
             reader.bump();
         return true;
     }
+
+    static constexpr auto _ascii_set
+        = _detail::ascii_set().insert(_char_to_code_unit(Min), _char_to_code_unit(Max));
 };
 } // namespace lexy
 
@@ -62,6 +66,14 @@ struct _strie
         return _char_to_int_type<Encoding>(_transition[transition]);
     }
 
+    LEXY_CONSTEVAL auto ascii_set() const
+    {
+        _detail::ascii_set result;
+        for (auto idx = 0u; idx != TransitionCount; ++idx)
+            result.insert(_char_to_code_unit(_transition[idx]));
+        return result;
+    }
+
     CharT _transition[TransitionCount == 0 ? 1 : TransitionCount];
 };
 
@@ -121,6 +133,8 @@ struct engine_char_set : engine_matcher_base
             reader.bump();
         return true;
     }
+
+    static constexpr auto _ascii_set = STrie.ascii_set();
 };
 
 } // namespace lexy
@@ -226,8 +240,107 @@ struct engine_ascii_table : engine_matcher_base
             reader.bump();
         return true;
     }
+
+    static constexpr auto _ascii_set = [] {
+        _detail::ascii_set result;
+        for (auto c = 0x00; c <= 0x7F; ++c)
+            if (Table.template contains<default_encoding, Categories...>(c))
+                result.insert(std::size_t(c));
+        return result;
+    }();
 };
 } // namespace lexy
 
+namespace lexy
+{
+template <typename Matcher>
+using _detect_ascii_set = decltype(Matcher::_ascii_set);
+
+// Whether the matcher matches a single character of a set of ASCII characters.
+template <typename Matcher>
+constexpr bool _engine_is_ascii_set = [] {
+    if constexpr (_detail::is_detected<_detect_ascii_set, Matcher>)
+        return Matcher::_ascii_set.is_ascii();
+    else
+        return false;
+}();
+
+/// Consumes all characters of the set.
+/// This skips a contiguous run of characters at once.
+template <const _detail::ascii_set& Set, typename Reader>
+void _skip_ascii_set(Reader& reader)
+{
+    static_assert(Set.is_ascii() && _is_contiguous_reader<Reader>);
+    while (true)
+    {
+        auto remaining = reader.remaining();
+        auto count     = _detail::ascii_set_span<Set>(remaining.data(), remaining.size());
+        reader.bump(count);
+
+        // We need to continue in the next chunk if we've consumed everything.
+        if (count < remaining.size() || remaining.empty())
+            break;
+    }
+}
+
+/// Consumes all characters of the set of the matcher, which must be an ASCII set.
+template <typename Matcher, typename Reader>
+void _engine_skip_ascii_set(Reader& reader)
+{
+    static_assert(_engine_is_ascii_set<Matcher>);
+    _skip_ascii_set<Matcher::_ascii_set>(reader);
+}
+} // namespace lexy
+
+namespace lexy
+{
+template <typename Matcher>
+using _detect_first_chars = decltype(Matcher::_first_chars);
+
+template <typename Matcher>
+constexpr _detail::ascii_set _engine_first_chars_of()
+{
+    if constexpr (_detail::is_detected<_detect_first_chars, Matcher>)
+        return Matcher::_first_chars;
+    else if constexpr (_detail::is_detected<_detect_ascii_set, Matcher>)
+        return Matcher::_ascii_set;
+    else
+        // It could start with any character.
+        return _detail::ascii_set().insert(0x00, 0xFF);
+}
+
+// The characters where one of the matchers can succeed; they can also succeed at EOF.
+// If it isn't an ASCII set, they might succeed anywhere.
+// A matcher can specify them as `_first_chars`.
+template <typename... Matchers>
+constexpr auto _engine_first_chars = [] {
+    _detail::ascii_set result;
+    (result.insert(_engine_first_chars_of<Matchers>()), ...);
+    return result;
+}();
+
+template <typename Reader, typename... Matchers>
+constexpr bool _engine_can_skip_to_first_chars
+    = _is_contiguous_reader<Reader> && _engine_first_chars<Matchers...>.is_ascii();
+
+/// Advances to the first position where one of the matchers can succeed, or EOF.
+/// This skips over contiguous runs of other characters at once.
+template <typename... Matchers, typename Reader>
+void _engine_skip_to_first_chars(Reader& reader)
+{
+    static_assert(_engine_can_skip_to_first_chars<Reader, Matchers...>);
+    while (true)
+    {
+        auto remaining = reader.remaining();
+        auto count     = _detail::ascii_set_find<_engine_first_chars<Matchers...>>(remaining.data(),
+                                                                                remaining.size());
+        reader.bump(count);
+
+        if (count < remaining.size() || remaining.empty())
+            break;
+    }
+}
+} // namespace lexy
+
 #endif // LEXY_ENGINE_CHAR_CLASS_HPP_INCLUDED
 
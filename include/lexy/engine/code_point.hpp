@@ -93,10 +93,76 @@ struct engine_cp_utf8 : engine_matcher_base, engine_parser_base
 
     using error_code = _cp_error_code;
 
+    template <typename Reader>
+    using _detect_validated = decltype(Reader::_validated_utf8);
+
+    // The reader has been validated, so every lead unit is followed by the right number of
+    // continuation units and the result is valid.
+    template <typename Reader>
+    static constexpr code_point _parse_validated(error_code& ec, Reader& reader)
+    {
+        auto first = reader.peek();
+        if ((first & ~payload_lead1) == pattern_lead1)
+        {
+            // ASCII character.
+            reader.bump();
+            return code_point(first);
+        }
+        else if ((first & ~payload_cont) == pattern_cont)
+        {
+            // We are in the middle of a code point.
+            ec = error_code::leads_with_trailing;
+            return code_point();
+        }
+        else if ((first & ~payload_lead2) == pattern_lead2)
+        {
+            reader.bump();
+            auto result = char32_t(first & payload_lead2);
+            result <<= 6;
+            result |= char32_t(reader.peek() & payload_cont);
+            reader.bump();
+            return code_point(result);
+        }
+        else if ((first & ~payload_lead3) == pattern_lead3)
+        {
+            reader.bump();
+            auto result = char32_t(first & payload_lead3);
+            result <<= 6;
+            result |= char32_t(reader.peek() & payload_cont);
+            reader.bump();
+            result <<= 6;
+            result |= char32_t(reader.peek() & payload_cont);
+            reader.bump();
+            return code_point(result);
+        }
+        else if ((first & ~payload_lead4) == pattern_lead4)
+        {
+            reader.bump();
+            auto result = char32_t(first & payload_lead4);
+            result <<= 6;
+            result |= char32_t(reader.peek() & payload_cont);
+            reader.bump();
+            result <<= 6;
+            result |= char32_t(reader.peek() & payload_cont);
+            reader.bump();
+            result <<= 6;
+            result |= char32_t(reader.peek() & payload_cont);
+            reader.bump();
+            return code_point(result);
+        }
+        else // The EOF sentinel.
+        {
+            ec = error_code::eof;
+            return code_point();
+        }
+    }
+
     template <typename Reader>
     static constexpr code_point parse(error_code& ec, Reader& reader)
     {
         static_assert(std::is_same_v<typename Reader::encoding, utf8_encoding>);
+        if constexpr (_detail::is_detected<_detect_validated, Reader>)
+            return _parse_validated(ec, reader);
 
         auto first = reader.peek();
         if ((first & ~payload_lead1) == pattern_lead1)
@@ -6,9 +6,26 @@
 #define LEXY_ENGINE_DIGITS_HPP_INCLUDED
 
 #include <lexy/engine/base.hpp>
+#include <lexy/engine/char_class.hpp>
 
 namespace lexy
 {
+template <typename DigitSet, typename Reader>
+constexpr void _match_trailing_digits(Reader& reader)
+{
+    if constexpr (_engine_is_ascii_set<DigitSet> && _is_contiguous_reader<Reader>)
+    {
+        if (!LEXY_IS_CONSTANT_EVALUATED())
+        {
+            _engine_skip_ascii_set<DigitSet>(reader);
+            return;
+        }
+    }
+
+    while (engine_try_match<DigitSet>(reader))
+    {}
+}
+
 /// Match one or more of the specified digits.
 template <typename DigitSet>
 struct engine_digits : engine_matcher_base
@@ -25,11 +42,12 @@ struct engine_digits : engine_matcher_base
             return ec;
 
         // Match subsequent digits as often as possible.
-        while (engine_try_match<DigitSet>(reader))
-        {}
+        _match_trailing_digits<DigitSet>(reader);
 
         return error_code();
     }
+
+    static constexpr auto _first_chars = _engine_first_chars<DigitSet>;
 };
 
 /// Match one or more of the specified digits with digit separator in between.
@@ -62,6 +80,8 @@ struct engine_digits_sep : engine_matcher_base
 
         return error_code();
     }
+
+    static constexpr auto _first_chars = _engine_first_chars<DigitSet>;
 };
 } // namespace lexy
 
@@ -102,12 +122,13 @@ struct engine_digits_trimmed : engine_matcher_base
                 return translate(ec);
 
             // Match subsequent digits as often as possible.
-            while (engine_try_match<DigitSet>(reader))
-            {}
+            _match_trailing_digits<DigitSet>(reader);
 
             return error_code();
         }
     }
+
+    static constexpr auto _first_chars = _engine_first_chars<Zero, DigitSet>;
 };
 
 /// Match one or more of the specified digits optionally separated, trimmed from unnecessary leading
@@ -162,6 +183,8 @@ struct engine_digits_trimmed_sep : engine_matcher_base
             return error_code();
         }
     }
+
+    static constexpr auto _first_chars = _engine_first_chars<Zero, DigitSet>;
 };
 } // namespace lexy
 
@@ -209,6 +232,8 @@ struct engine_ndigits : engine_matcher_base
 
         return error_code();
     }
+
+    static constexpr auto _first_chars = _engine_first_chars<DigitSet>;
 };
 
 /// Matches exactly N digits optionally separated.
@@ -262,6 +287,8 @@ struct engine_ndigits_sep : engine_matcher_base
 
         return error_code();
     }
+
+    static constexpr auto _first_chars = _engine_first_chars<DigitSet>;
 };
 } // namespace lexy
 
@@ -5,6 +5,7 @@
 #ifndef LEXY_ENGINE_EOF_HPP_INCLUDED
 #define LEXY_ENGINE_EOF_HPP_INCLUDED
 
+#include <lexy/_detail/ascii_set.hpp>
 #include <lexy/engine/base.hpp>
 
 namespace lexy
@@ -22,6 +23,9 @@ struct engine_eof : engine_matcher_base
     {
         return reader.eof() ? error_code() : error_code::error;
     }
+
+    // It only succeeds at EOF.
+    static constexpr auto _first_chars = _detail::ascii_set();
 };
 } // namespace lexy
 
@@ -6,6 +6,7 @@
 #define LEXY_ENGINE_FIND_HPP_INCLUDED
 
 #include <lexy/engine/base.hpp>
+#include <lexy/engine/char_class.hpp>
 
 namespace lexy
 {
@@ -23,15 +24,22 @@ struct engine_find : engine_matcher_base
     template <typename Reader>
     static constexpr error_code match(Reader& reader)
     {
-        while (!engine_peek<Condition>(reader))
+        while (true)
         {
-            if (reader.eof())
+            if constexpr (_engine_can_skip_to_first_chars<Reader, Condition>)
+            {
+                // Skip over characters where the condition can't match.
+                if (!LEXY_IS_CONSTANT_EVALUATED())
+                    _engine_skip_to_first_chars<Condition>(reader);
+            }
+
+            if (engine_peek<Condition>(reader))
+                return error_code();
+            else if (reader.eof())
                 return error_code::not_found;
             else
                 reader.bump();
         }
-
-        return error_code();
     }
 };
 
@@ -51,17 +59,24 @@ struct engine_find_before : engine_matcher_base
     template <typename Reader>
     static constexpr error_code match(Reader& reader)
     {
-        while (!engine_peek<Condition>(reader))
+        while (true)
         {
-            if (reader.eof())
+            if constexpr (_engine_can_skip_to_first_chars<Reader, Condition, Limit>)
+            {
+                // Skip over characters where neither the condition nor the limit can match.
+                if (!LEXY_IS_CONSTANT_EVALUATED())
+                    _engine_skip_to_first_chars<Condition, Limit>(reader);
+            }
+
+            if (engine_peek<Condition>(reader))
+                return error_code();
+            else if (reader.eof())
                 return error_code::not_found_eof;
             else if (engine_peek<Limit>(reader))
                 return error_code::not_found_limit;
             else
                 reader.bump();
         }
-
-        return error_code();
     }
 };
 } // namespace lexy
@@ -5,6 +5,7 @@
 #ifndef LEXY_ENGINE_LITERAL_HPP_INCLUDED
 #define LEXY_ENGINE_LITERAL_HPP_INCLUDED
 
+#include <lexy/_detail/ascii_set.hpp>
 #include <lexy/_detail/integer_sequence.hpp>
 #include <lexy/engine/base.hpp>
 
@@ -29,6 +30,17 @@ struct _ltrie
         return _char_to_int_type<Encoding>(_transition[node]);
     }
 
+    LEXY_CONSTEVAL auto first_chars() const
+    {
+        _detail::ascii_set result;
+        if (NodeCount == 0)
+            // The empty string matches everywhere.
+            result.insert(0x00, 0xFF);
+        else
+            result.insert(_char_to_code_unit(_transition[0]));
+        return result;
+    }
+
     CharT _transition[NodeCount == 0 ? 1 : NodeCount];
 };
 
@@ -81,11 +93,37 @@ struct engine_literal : engine_matcher_base
         return result;
     }
 
+    template <typename Reader, std::size_t... Nodes>
+    static constexpr auto _compare(Reader&                                 reader,
+                                   lexy::_detail::index_sequence<Nodes...> nodes)
+    {
+        using encoding = typename Reader::encoding;
+
+        auto remaining = reader.remaining();
+        if (remaining.size() < sizeof...(Nodes))
+            // The literal might continue in the next chunk.
+            return _transition(reader, nodes);
+
+        // Compare without checking for EOF after every character.
+        auto count = std::size_t(0);
+        (void)((encoding::to_int_type(remaining[Nodes])
+                    == LTrie.template transition<encoding>(Nodes)
+                && (++count, true))
+               && ...);
+        reader.bump(count);
+        return count == sizeof...(Nodes) ? error_code() : error_code(count + 1);
+    }
+
     template <typename Reader>
     static constexpr error_code match(Reader& reader)
     {
-        return _transition(reader, LTrie.node_sequence());
+        if constexpr (_is_contiguous_reader<Reader>)
+            return _compare(reader, LTrie.node_sequence());
+        else
+            return _transition(reader, LTrie.node_sequence());
     }
+
+    static constexpr auto _first_chars = LTrie.first_chars();
 };
 
 template <const auto& LTrie, typename Reader>
@@ -6,6 +6,7 @@
 #define LEXY_ENGINE_MINUS_HPP_INCLUDED
 
 #include <lexy/engine/base.hpp>
+#include <lexy/engine/char_class.hpp>
 
 namespace lexy
 {
@@ -58,6 +59,9 @@ struct engine_minus : lexy::engine_matcher_base
         else
             return Matcher::recover(reader, error_to_matcher(ec));
     }
+
+    // We can only match where the matcher does.
+    static constexpr auto _first_chars = _engine_first_chars<Matcher>;
 };
 } // namespace lexy
 
@@ -5,7 +5,9 @@
 #ifndef LEXY_ENGINE_TRIE_HPP_INCLUDED
 #define LEXY_ENGINE_TRIE_HPP_INCLUDED
 
+#include <lexy/_detail/ascii_set.hpp>
 #include <lexy/_detail/integer_sequence.hpp>
+#include <lexy/_detail/string_view.hpp>
 #include <lexy/engine/base.hpp>
 
 namespace lexy
@@ -47,6 +49,18 @@ struct _trie
         return _transition_node[begin + transition];
     }
 
+    LEXY_CONSTEVAL auto first_chars() const
+    {
+        _detail::ascii_set result;
+        if (accepts_empty())
+            // The empty string matches everywhere.
+            result.insert(0x00, 0xFF);
+        else
+            for (auto transition = 0u; transition != transition_count(0); ++transition)
+                result.insert(_char_to_code_unit(transition_char(0, transition)));
+        return result;
+    }
+
     // Arrays indexed by nodes.
     // The node has the transitions in the range [_node_transition_idx[node] - 1,
     // _node_transition_idx[node]].
@@ -58,23 +72,39 @@ struct _trie
     std::size_t _transition_node[TransitionCount == 0 ? 1 : TransitionCount];
 };
 
-template <typename CharT, typename... Strings, std::size_t... Idxs>
-LEXY_CONSTEVAL auto _make_trie(lexy::_detail::index_sequence<Idxs...>)
+// Fold expressions over a lot of strings are slow to evaluate, so we put them into an array.
+template <typename CharT, typename... Strings>
+constexpr lexy::_detail::basic_string_view<CharT> _trie_strings[sizeof...(Strings) + 1]
+    = {Strings::get()...};
+
+template <typename CharT, typename... Strings>
+LEXY_CONSTEVAL auto _make_trie()
 {
     // We can estimate the number of nodes in the trie by adding all strings together.
     // This is the worst case where the strings don't share any nodes.
     // The plus one comes from the additional root node.
-    constexpr auto node_count_upper_bound = (Strings::get().size() + ... + 1);
+    constexpr auto node_count_upper_bound = [] {
+        auto result = std::size_t(1);
+        for (auto idx = 0u; idx != sizeof...(Strings); ++idx)
+            result += _trie_strings<CharT, Strings...>[idx].size();
+        return result;
+    }();
 
     // We cannot construct the `_trie` directly as we don't know how many transitions each node has.
-    // So we use this temporary representation using an adjacency matrix.
+    // So we use this temporary representation where the children of a node form a linked list.
+    // This only requires space linear in the total size of the strings.
     struct builder_t
     {
         std::size_t node_count       = 1;
         std::size_t transition_count = 0;
 
         std::size_t node_value[node_count_upper_bound] = {std::size_t(-1)};
-        CharT       node_transition[node_count_upper_bound][node_count_upper_bound] = {};
+        // The character of the transition to the node.
+        CharT node_char[node_count_upper_bound] = {};
+        // The root node is never a child, so zero means no child or sibling.
+        std::size_t node_first_child[node_count_upper_bound]  = {};
+        std::size_t node_last_child[node_count_upper_bound]   = {};
+        std::size_t node_next_sibling[node_count_upper_bound] = {};
 
         constexpr void insert(std::size_t value, const CharT* str, std::size_t size)
         {
@@ -84,29 +114,27 @@ LEXY_CONSTEVAL auto _make_trie(lexy::_detail::index_sequence<Idxs...>)
                 auto c = *ptr;
                 LEXY_PRECONDITION(c);
 
-                auto found = false;
-                for (auto next_node = cur_node + 1; next_node < node_count; ++next_node)
-                {
-                    if (node_transition[cur_node][next_node] == c)
-                    {
-                        // The transition from `cur_node` to `next_node` using `c` is already in
-                        // the trie. Follow it.
-                        cur_node = next_node;
-                        found    = true;
-                        break;
-                    }
-                }
+                auto next_node = node_first_child[cur_node];
+                while (next_node != 0 && node_char[next_node] != c)
+                    next_node = node_next_sibling[next_node];
 
-                if (!found)
+                if (next_node == 0)
                 {
                     // We haven't found the transition, need to create a new node.
-                    auto next_node                       = node_count++;
-                    node_value[next_node]                = std::size_t(-1);
-                    node_transition[cur_node][next_node] = c;
+                    // It is appended to the children, so they're ordered by creation.
+                    next_node             = node_count++;
+                    node_value[next_node] = std::size_t(-1);
+                    node_char[next_node]  = c;
                     transition_count++;
 
-                    cur_node = next_node;
+                    if (node_last_child[cur_node] == 0)
+                        node_first_child[cur_node] = next_node;
+                    else
+                        node_next_sibling[node_last_child[cur_node]] = next_node;
+                    node_last_child[cur_node] = next_node;
                 }
+
+                cur_node = next_node;
             }
 
             LEXY_PRECONDITION(node_value[cur_node]
@@ -117,27 +145,33 @@ LEXY_CONSTEVAL auto _make_trie(lexy::_detail::index_sequence<Idxs...>)
     // We build the trie by inserting all strings.
     constexpr auto builder = [] {
         builder_t builder;
-        (builder.insert(Idxs, Strings::get().data(), Strings::get().size()), ...);
+        for (auto idx = 0u; idx != sizeof...(Strings); ++idx)
+        {
+            auto str = _trie_strings<CharT, Strings...>[idx];
+            builder.insert(idx, str.data(), str.size());
+        }
         return builder;
     }();
 
     // Now we also now the exact number of nodes and transitions in the trie.
     _trie<CharT, builder.node_count, builder.transition_count> result{};
 
-    // Translate the adjacency matrix representation into the actual trie representation.
+    // Translate the linked list representation into the actual trie representation.
     auto transition_idx = 0u;
     for (auto node = 0u; node != builder.node_count; ++node)
     {
         result._node_value[node] = builder.node_value[node];
 
-        for (auto next_node = node + 1; next_node != builder.node_count; ++next_node)
-            if (auto c = builder.node_transition[node][next_node])
-            {
-                // We've found a transition, add it to the shared transition array.
-                result._transition_char[transition_idx] = c;
-                result._transition_node[transition_idx] = next_node;
-                ++transition_idx;
-            }
+        auto next_node = builder.node_first_child[node];
+        while (next_node != 0)
+        {
+            // Add the transition to the shared transition array.
+            result._transition_char[transition_idx] = builder.node_char[next_node];
+            result._transition_node[transition_idx] = next_node;
+            ++transition_idx;
+
+            next_node = builder.node_next_sibling[next_node];
+        }
 
         // The node transition end at the current transition index.
         result._node_transition_idx[node] = transition_idx;
@@ -148,8 +182,7 @@ LEXY_CONSTEVAL auto _make_trie(lexy::_detail::index_sequence<Idxs...>)
 
 /// A trie containing `Strings::get()` for every string.
 template <typename CharT, typename... Strings>
-constexpr auto trie
-    = _make_trie<CharT, Strings...>(lexy::_detail::index_sequence_for<Strings...>{});
+constexpr auto trie = _make_trie<CharT, Strings...>();
 
 /// Matches one of the strings contained in the trie.
 template <const auto& Trie>
@@ -160,6 +193,9 @@ struct engine_trie : engine_matcher_base, engine_parser_base
         error = 1,
     };
 
+    // The number of transitions from which on a node uses a lookup table.
+    static constexpr auto _table_threshold = std::size_t(8);
+
     template <std::size_t Node>
     using _transition_sequence = lexy::_detail::make_index_sequence<Trie.transition_count(Node)>;
 
@@ -170,6 +206,37 @@ struct engine_trie : engine_matcher_base, engine_parser_base
     template <std::size_t Node, std::size_t... Transitions>
     struct _node<Node, lexy::_detail::index_sequence<Transitions...>>
     {
+        template <typename Encoding, std::size_t Transition>
+        static constexpr auto _code_unit = _char_to_code_unit(
+            _char_to_int_type<Encoding>(Trie.transition_char(Node, Transition)));
+
+        // Nodes with a lot of transitions look up the transition in a table indexed by the code
+        // unit instead of comparing against each one.
+        // This requires that all of them are single bytes.
+        template <typename Encoding>
+        static constexpr bool _use_table = [] {
+            if constexpr (!std::is_integral_v<typename Encoding::int_type>)
+                return false;
+            else if constexpr (sizeof...(Transitions) < _table_threshold
+                               || sizeof...(Transitions) >= 0xFF)
+                return false;
+            else
+                return ((_code_unit<Encoding, Transitions> <= 0xFF) && ...);
+        }();
+
+        // Maps each code unit to the index of its transition plus one, or zero if there is none.
+        template <typename Encoding>
+        static constexpr auto _table = [] {
+            struct table_t
+            {
+                unsigned char data[256];
+            } result{};
+            ((result.data[_code_unit<Encoding, Transitions>]
+              = static_cast<unsigned char>(Transitions + 1)),
+             ...);
+            return result;
+        }();
+
         template <typename Reader>
         static constexpr auto parse(Reader& reader)
         {
@@ -178,15 +245,35 @@ struct engine_trie : engine_matcher_base, engine_parser_base
             auto cur       = reader.peek();
 
             auto result = Trie.invalid_value;
-            // Check the character of each transition.
-            // If it matches, we advance by one and go to that node.
-            // As soon as we do that, we return true to short circuit the search.
-            (void)((cur == _char_to_int_type<encoding>(Trie.transition_char(Node, Transitions))
-                        ? (reader.bump(),
-                           result = _node<Trie.transition_next(Node, Transitions)>::parse(reader),
-                           true)
-                        : false)
-                   || ...);
+            if constexpr (_use_table<encoding>)
+            {
+                // Look up the transition we have to take, if any.
+                // If there is one, we advance by one and go to that node; the comparisons against
+                // the dense transition index are turned into a jump table by the compiler.
+                auto code_unit  = _char_to_code_unit(cur);
+                auto transition = code_unit <= 0xFF ? _table<encoding>.data[code_unit] : 0u;
+                if (transition != 0)
+                    (void)((transition == Transitions + 1
+                                ? (reader.bump(),
+                                   result
+                                   = _node<Trie.transition_next(Node, Transitions)>::parse(reader),
+                                   true)
+                                : false)
+                           || ...);
+            }
+            else
+            {
+                // Check the character of each transition.
+                // If it matches, we advance by one and go to that node.
+                // As soon as we do that, we return true to short circuit the search.
+                (void)((cur == _char_to_int_type<encoding>(Trie.transition_char(Node, Transitions))
+                            ? (reader.bump(),
+                               result
+                               = _node<Trie.transition_next(Node, Transitions)>::parse(reader),
+                               true)
+                            : false)
+                       || ...);
+            }
 
             if constexpr (Trie.node_value(Node) != Trie.invalid_value)
             {
@@ -242,6 +329,8 @@ struct engine_trie : engine_matcher_base, engine_parser_base
     {
         return false;
     }
+
+    static constexpr auto _first_chars = Trie.first_chars();
 };
 
 template <const auto& Trie, typename Reader>
@@ -6,6 +6,7 @@
 #define LEXY_ENGINE_UNTIL_HPP_INCLUDED
 
 #include <lexy/engine/base.hpp>
+#include <lexy/engine/char_class.hpp>
 
 namespace lexy
 {
@@ -20,18 +21,23 @@ struct engine_until : engine_matcher_base
     template <typename Reader>
     static constexpr error_code match(Reader& reader)
     {
-        while (!engine_try_match<Condition>(reader))
+        while (true)
         {
-            if (reader.eof())
+            if constexpr (_engine_can_skip_to_first_chars<Reader, Condition>)
             {
-                // This match fails but gives us an appropriate error code.
-                return Condition::match(reader);
+                // Skip over characters where the condition can't match.
+                if (!LEXY_IS_CONSTANT_EVALUATED())
+                    _engine_skip_to_first_chars<Condition>(reader);
             }
 
-            reader.bump();
+            if (engine_try_match<Condition>(reader))
+                return error_code();
+            else if (reader.eof())
+                // This match fails but gives us an appropriate error code.
+                return Condition::match(reader);
+            else
+                reader.bump();
         }
-
-        return error_code();
     }
 };
 } // namespace lexy
@@ -51,15 +57,20 @@ struct engine_until_eof : engine_matcher_base
     template <typename Reader>
     static constexpr error_code match(Reader& reader)
     {
-        while (!engine_try_match<Condition>(reader))
+        while (true)
         {
-            if (reader.eof())
-                break;
+            if constexpr (_engine_can_skip_to_first_chars<Reader, Condition>)
+            {
+                // Skip over characters where the condition can't match.
+                if (!LEXY_IS_CONSTANT_EVALUATED())
+                    _engine_skip_to_first_chars<Condition>(reader);
+            }
 
-            reader.bump();
+            if (engine_try_match<Condition>(reader) || reader.eof())
+                return error_code();
+            else
+                reader.bump();
         }
-
-        return error_code();
     }
 };
 
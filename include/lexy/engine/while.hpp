@@ -6,6 +6,7 @@
 #define LEXY_ENGINE_WHILE_HPP_INCLUDED
 
 #include <lexy/engine/base.hpp>
+#include <lexy/engine/char_class.hpp>
 
 namespace lexy
 {
@@ -22,6 +23,15 @@ struct engine_while : engine_matcher_base
     template <typename Reader>
     static constexpr error_code match(Reader& reader)
     {
+        if constexpr (_engine_is_ascii_set<Matcher> && _is_contiguous_reader<Reader>)
+        {
+            if (!LEXY_IS_CONSTANT_EVALUATED())
+            {
+                _engine_skip_ascii_set<Matcher>(reader);
+                return error_code();
+            }
+        }
+
         while (engine_try_match<Matcher>(reader))
         {}
 
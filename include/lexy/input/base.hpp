@@ -6,6 +6,8 @@
 #define LEXY_INPUT_BASE_HPP_INCLUDED
 
 #include <lexy/_detail/config.hpp>
+#include <lexy/_detail/detect.hpp>
+#include <lexy/_detail/string_view.hpp>
 #include <lexy/encoding.hpp>
 
 #if 0
@@ -45,6 +47,19 @@ public:
     iterator cur() const;
 };
 
+/// Optionally, a reader can give access to the input as contiguous memory.
+class ContiguousReader : public Reader
+{
+public:
+    /// The characters starting at the current position up to EOF or the end of the current chunk,
+    /// as a `lexy::_detail::basic_string_view<char_type>`.
+    /// It must not be empty unless the reader is at EOF.
+    auto remaining() const;
+
+    /// Advances by `n` characters; `n` must be at most `remaining().size()`.
+    void bump(std::size_t n);
+};
+
 /// An Input produces a reader.
 class Input
 {
@@ -91,6 +106,24 @@ public:
         return _cur;
     }
 
+    // Only a range of pointers to `char_type` is contiguous.
+    template <typename It = Iterator,
+              typename = std::enable_if_t<std::is_same_v<It, Sentinel>
+                                          && std::is_convertible_v<It, const char_type*>>>
+    constexpr auto remaining() const noexcept
+    {
+        return basic_string_view<char_type>(_cur, _end);
+    }
+
+    template <typename It = Iterator,
+              typename = std::enable_if_t<std::is_same_v<It, Sentinel>
+                                          && std::is_convertible_v<It, const char_type*>>>
+    constexpr void bump(std::size_t n) noexcept
+    {
+        LEXY_PRECONDITION(n <= remaining().size());
+        _cur += n;
+    }
+
     constexpr void _make_eof() noexcept
     {
         static_assert(std::is_same_v<Iterator, Sentinel>);
@@ -116,6 +149,11 @@ constexpr bool char_type_compatible_with_reader
 template <typename Reader>
 constexpr bool is_canonical_reader = std::is_same_v<typename Reader::canonical_reader, Reader>;
 
+template <typename Reader>
+using _detect_contiguous_reader = decltype(LEXY_DECLVAL(const Reader&).remaining());
+template <typename Reader>
+constexpr bool _is_contiguous_reader = _detail::is_detected<_detect_contiguous_reader, Reader>;
+
 /// Creates a reader that only reads until the given end.
 template <typename Reader>
 constexpr auto partial_reader(Reader reader, typename Reader::iterator end)
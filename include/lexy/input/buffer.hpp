@@ -6,15 +6,127 @@
 #define LEXY_INPUT_BUFFER_HPP_INCLUDED
 
 #include <cstring>
+#include <lexy/_detail/byte_swap.hpp>
 #include <lexy/_detail/memory_resource.hpp>
+#include <lexy/_detail/transcode.hpp>
 #include <lexy/error.hpp>
 #include <lexy/input/base.hpp>
 #include <lexy/lexeme.hpp>
 
+namespace lexy::_detail
+{
+// Reads a range whose end contains the EOF sentinel, so `peek()` doesn't need a branch.
+template <typename Encoding>
+class sentinel_reader
+{
+public:
+    using encoding         = Encoding;
+    using char_type        = typename encoding::char_type;
+    using iterator         = const char_type*;
+    using canonical_reader = sentinel_reader<Encoding>;
+
+    explicit sentinel_reader(iterator begin, iterator end) noexcept : _cur(begin), _end(end)
+    {
+        LEXY_PRECONDITION(*end == encoding::eof());
+    }
+
+    bool eof() const noexcept
+    {
+        return _cur == _end;
+    }
+
+    auto peek() const noexcept
+    {
+        // The last one will be EOF.
+        return *_cur;
+    }
+
+    void bump() noexcept
+    {
+        ++_cur;
+    }
+
+    iterator cur() const noexcept
+    {
+        return _cur;
+    }
+
+    auto remaining() const noexcept
+    {
+        return basic_string_view<char_type>(_cur, _end);
+    }
+
+    void bump(std::size_t n) noexcept
+    {
+        LEXY_PRECONDITION(n <= remaining().size());
+        _cur += n;
+    }
+
+private:
+    iterator _cur;
+    iterator _end;
+};
+
+// A reader for a buffer whose encoding has no spare value for an EOF sentinel.
+// As the buffer is padded, the current character can be read even at EOF,
+// so `peek()` can select EOF without a branch.
+template <typename Encoding>
+class padded_reader
+{
+public:
+    using encoding         = Encoding;
+    using char_type        = typename encoding::char_type;
+    using iterator         = const char_type*;
+    using canonical_reader = padded_reader<Encoding>;
+
+    explicit padded_reader(iterator begin, iterator end) noexcept : _cur(begin), _end(end) {}
+
+    bool eof() const noexcept
+    {
+        return _cur == _end;
+    }
+
+    auto peek() const noexcept
+    {
+        auto c = encoding::to_int_type(*_cur);
+        return _cur == _end ? encoding::eof() : c;
+    }
+
+    void bump() noexcept
+    {
+        ++_cur;
+    }
+
+    iterator cur() const noexcept
+    {
+        return _cur;
+    }
+
+    auto remaining() const noexcept
+    {
+        return basic_string_view<char_type>(_cur, _end);
+    }
+
+    void bump(std::size_t n) noexcept
+    {
+        LEXY_PRECONDITION(n <= remaining().size());
+        _cur += n;
+    }
+
+private:
+    iterator _cur;
+    iterator _end;
+};
+} // namespace lexy::_detail
+
 namespace lexy
 {
+template <typename Encoding, encoding_endianness Endian>
+struct _make_buffer;
+
 /// Stores the input that will be parsed.
-/// For encodings with spare code points, it can append an EOF sentinel.
+/// The memory is aligned and followed by padding that can be read.
+/// For encodings with spare code points, the padding starts with an EOF sentinel.
 /// This allows branch-less detection of EOF.
 template <typename Encoding       = default_encoding,
           typename MemoryResource = _detail::default_memory_resource>
@@ -28,6 +140,12 @@ public:
     using char_type = typename encoding::char_type;
     static_assert(std::is_trivial_v<char_type>);
 
+    /// The alignment of `data()` in bytes.
+    static constexpr std::size_t alignment = 64;
+    /// The number of bytes after `data() + size()` that can be read.
+    /// They are zero, except for the EOF sentinel at the beginning, if there is one.
+    static constexpr std::size_t padding = LEXY_BUFFER_PADDING;
+
     //=== constructors ===//
     /// Allows the creation of an uninitialized buffer that is then filled by the user.
     class builder
@@ -116,10 +234,7 @@ public:
         if (!_data)
             return;
 
-        if constexpr (_has_sentinel)
-            _resource->deallocate(_data, (_size + 1) * sizeof(char_type), alignof(char_type));
-        else
-            _resource->deallocate(_data, _size * sizeof(char_type), alignof(char_type));
+        _resource->deallocate(_data, _size * sizeof(char_type) + padding, alignment);
     }
 
     buffer& operator=(const buffer& other) // NOLINT: we do guard against self-assignment
@@ -167,64 +282,36 @@ public:
     //=== input ===//
     auto reader() const& noexcept
     {
+        // A buffer without memory is empty, so we read the padding of a static one instead.
+        alignas(alignment) static constexpr char_type empty[padding / sizeof(char_type)]
+            = {_has_sentinel ? char_type(encoding::eof()) : char_type()};
+        auto data = _data ? _data : empty;
+
         if constexpr (_has_sentinel)
-            return _sentinel_reader(_data);
+            return _detail::sentinel_reader<encoding>(data, data + _size);
         else
-            return _detail::range_reader<encoding, const char_type*>(_data, _data + _size);
+            return _detail::padded_reader<encoding>(data, data + _size);
     }
 
 private:
-    class _sentinel_reader
-    {
-    public:
-        using encoding         = Encoding;
-        using char_type        = typename encoding::char_type;
-        using iterator         = const char_type*;
-        using canonical_reader = _sentinel_reader;
-
-        bool eof() const noexcept
-        {
-            return *_cur == encoding::eof();
-        }
-
-        auto peek() const noexcept
-        {
-            // The last one will be EOF.
-            return *_cur;
-        }
-
-        void bump() noexcept
-        {
-            ++_cur;
-        }
-
-        iterator cur() const noexcept
-        {
-            return _cur;
-        }
-
-    private:
-        explicit _sentinel_reader(iterator begin) noexcept : _cur(begin) {}
-
-        iterator _cur;
-        friend buffer;
-    };
-
     char_type* allocate(std::size_t size) const
     {
-        if constexpr (_has_sentinel)
-            ++size;
+        auto memory
+            = static_cast<char_type*>(_resource->allocate(size * sizeof(char_type) + padding,
+                                                          alignment));
 
-        auto memory = static_cast<char_type*>(
-            _resource->allocate(size * sizeof(char_type), alignof(char_type)));
+        std::memset(memory + size, 0, padding);
         if constexpr (_has_sentinel)
-            memory[size - 1] = encoding::eof();
+            memory[size] = encoding::eof();
         return memory;
     }
 
     LEXY_EMPTY_MEMBER _detail::memory_resource_ptr<MemoryResource> _resource;
     char_type*                                                     _data;
     std::size_t                                                    _size;
+
+    template <typename, encoding_endianness>
+    friend struct _make_buffer;
 };
 
 template <typename CharT>
@@ -271,98 +358,180 @@ struct _make_buffer
         {
             typename buffer<Encoding, MemoryResource>::builder builder(size / sizeof(char_type),
                                                                        resource);
-
-            const auto end = memory + size;
-            for (auto dest = builder.data(); memory != end; memory += sizeof(char_type))
-            {
-                constexpr auto is_char16 = std::is_same_v<char_type, char16_t>;
-                constexpr auto is_char32 = std::is_same_v<char_type, char32_t>;
-
-                // We convert each group of bytes to the appropriate value.
-                if constexpr (is_char16 && Endian == encoding_endianness::little)
-                    *dest++ = static_cast<char_type>((memory[0] << 0) | (memory[1] << 8));
-                else if constexpr (is_char32 && Endian == encoding_endianness::little)
-                    *dest++ = static_cast<char_type>((memory[0] << 0) | (memory[1] << 8)
-                                                     | (memory[2] << 16) | (memory[3] << 24));
-                else if constexpr (is_char16 && Endian == encoding_endianness::big)
-                    *dest++ = static_cast<char_type>((memory[0] << 8) | (memory[1] << 0));
-                else if constexpr (is_char32 && Endian == encoding_endianness::big)
-                    *dest++ = static_cast<char_type>((memory[0] << 24) | (memory[1] << 16)
-                                                     | (memory[2] << 8) | (memory[3] << 0));
-                else
-                    static_assert(_detail::error<Encoding>, "unhandled encoding/endianness");
-            }
-
+            // As the endianness isn't the native one, we need to reverse the bytes of each unit.
+            _detail::byte_swap(builder.data(), memory, builder.size());
             return LEXY_MOV(builder).finish();
         }
     }
+
+    // Converts a buffer whose code units are still stored in the specified endianness in place,
+    // without allocating a new buffer.
+    template <typename MemoryResource>
+    auto operator()(buffer<Encoding, MemoryResource>&& raw) const
+    {
+        constexpr auto native_endianness
+            = LEXY_IS_LITTLE_ENDIAN ? encoding_endianness::little : encoding_endianness::big;
+
+        using char_type = typename Encoding::char_type;
+        if constexpr (sizeof(char_type) > 1 && Endian != native_endianness)
+            _detail::byte_swap(raw._data, raw._data, raw._size);
+        return LEXY_MOV(raw);
+    }
 };
-template <>
-struct _make_buffer<utf8_encoding, encoding_endianness::bom>
+struct _bom
 {
-    template <typename MemoryResource = _detail::default_memory_resource>
-    auto operator()(const void* _memory, std::size_t size,
-                    MemoryResource* resource = _detail::get_memory_resource<MemoryResource>()) const
-    {
-        auto memory = static_cast<const unsigned char*>(_memory);
+    std::size_t         size;
+    encoding_endianness endianness;
+};
 
-        // We just skip over the BOM if there is one, it doesn't matter.
-        if (size >= 3 && memory[0] == 0xEF && memory[1] == 0xBB && memory[2] == 0xBF)
-        {
-            memory += 3;
-            size -= 3;
-        }
+// Detects the BOM at the beginning of memory, returning its size and the endianness it specifies.
+// Without a BOM, the encoding is big endian.
+template <typename Encoding>
+constexpr _bom _detect_bom(const unsigned char* memory, std::size_t size) noexcept
+{
+    constexpr auto big    = encoding_endianness::big;
+    constexpr auto little = encoding_endianness::little;
 
-        return _make_buffer<utf8_encoding, encoding_endianness::big>{}(memory, size, resource);
+    if constexpr (std::is_same_v<Encoding, utf8_encoding>)
+    {
+        // The BOM doesn't specify anything, but we skip it nonetheless.
+        if (size >= 3 && memory[0] == 0xEF && memory[1] == 0xBB && memory[2] == 0xBF)
+            return {3, big};
     }
-};
-template <>
-struct _make_buffer<utf16_encoding, encoding_endianness::bom>
+    else if constexpr (std::is_same_v<Encoding, utf16_encoding>)
+    {
+        if (size >= 2 && memory[0] == 0xFF && memory[1] == 0xFE)
+            return {2, little};
+        else if (size >= 2 && memory[0] == 0xFE && memory[1] == 0xFF)
+            return {2, big};
+    }
+    else if constexpr (std::is_same_v<Encoding, utf32_encoding>)
+    {
+        if (size >= 4 && memory[0] == 0xFF && memory[1] == 0xFE && memory[2] == 0x00
+            && memory[3] == 0x00)
+            return {4, little};
+        else if (size >= 4 && memory[0] == 0x00 && memory[1] == 0x00 && memory[2] == 0xFE
+                 && memory[3] == 0xFF)
+            return {4, big};
+    }
+
+    return {0, big};
+}
+
+template <typename Encoding>
+struct _make_buffer<Encoding, encoding_endianness::bom>
 {
     template <typename MemoryResource = _detail::default_memory_resource>
     auto operator()(const void* _memory, std::size_t size,
                     MemoryResource* resource = _detail::get_memory_resource<MemoryResource>()) const
     {
-        constexpr auto utf16_big    = _make_buffer<utf16_encoding, encoding_endianness::big>{};
-        constexpr auto utf16_little = _make_buffer<utf16_encoding, encoding_endianness::little>{};
-        auto           memory       = static_cast<const unsigned char*>(_memory);
+        constexpr auto make_big    = _make_buffer<Encoding, encoding_endianness::big>{};
+        constexpr auto make_little = _make_buffer<Encoding, encoding_endianness::little>{};
+        auto           memory      = static_cast<const unsigned char*>(_memory);
 
-        if (size < 2)
-            return utf16_big(memory, size, resource);
-        if (memory[0] == 0xFF && memory[1] == 0xFE)
-            return utf16_little(memory + 2, size - 2, resource);
-        else if (memory[0] == 0xFE && memory[1] == 0xFF)
-            return utf16_big(memory + 2, size - 2, resource);
+        auto bom = _detect_bom<Encoding>(memory, size);
+        if (bom.endianness == encoding_endianness::little)
+            return make_little(memory + bom.size, size - bom.size, resource);
         else
-            return utf16_big(memory, size, resource);
+            return make_big(memory + bom.size, size - bom.size, resource);
     }
 };
-template <>
-struct _make_buffer<utf32_encoding, encoding_endianness::bom>
+
+/// Creates a buffer with the specified encoding/endianness from raw memory,
+/// or converts the code units of a buffer to the native endianness in place.
+template <typename Encoding, encoding_endianness Endianness>
+constexpr auto make_buffer_from_raw = _make_buffer<Encoding, Endianness>{};
+
+//=== make_buffer_transcoded ===//
+/// The result of `lexy::make_buffer_transcoded()`.
+template <typename Encoding, typename MemoryResource>
+class transcode_result
+{
+public:
+    using encoding  = Encoding;
+    using char_type = typename encoding::char_type;
+
+    explicit operator bool() const noexcept
+    {
+        return _error == std::size_t(-1);
+    }
+
+    const lexy::buffer<Encoding, MemoryResource>& buffer() const& noexcept
+    {
+        LEXY_PRECONDITION(*this);
+        return _buffer;
+    }
+    lexy::buffer<Encoding, MemoryResource>&& buffer() && noexcept
+    {
+        LEXY_PRECONDITION(*this);
+        return LEXY_MOV(_buffer);
+    }
+
+    /// The index of the first code unit of the first malformed code point in the input.
+    std::size_t error_offset() const noexcept
+    {
+        LEXY_PRECONDITION(!*this);
+        return _error;
+    }
+
+public:
+    // Pretend this doesn't exist.
+    explicit transcode_result(lexy::buffer<Encoding, MemoryResource>&& buffer,
+                              std::size_t                              error) noexcept
+    : _buffer(LEXY_MOV(buffer)), _error(error)
+    {}
+
+private:
+    lexy::buffer<Encoding, MemoryResource> _buffer;
+    std::size_t                            _error;
+};
+
+template <typename From, typename To>
+struct _make_buffer_transcoded
 {
+    using _from_char = typename From::char_type;
+
     template <typename MemoryResource = _detail::default_memory_resource>
-    auto operator()(const void* _memory, std::size_t size,
+    auto operator()(const _from_char* data, std::size_t size,
                     MemoryResource* resource = _detail::get_memory_resource<MemoryResource>()) const
+        -> transcode_result<To, MemoryResource>
     {
-        constexpr auto utf32_big    = _make_buffer<utf32_encoding, encoding_endianness::big>{};
-        constexpr auto utf32_little = _make_buffer<utf32_encoding, encoding_endianness::little>{};
-        auto           memory       = static_cast<const unsigned char*>(_memory);
-
-        if (size >= 4)
-        {
-            if (memory[0] == 0xFF && memory[1] == 0xFE && memory[2] == 0x00 && memory[3] == 0x00)
-                return utf32_little(memory + 4, size - 4, resource);
-            else if (memory[0] == 0x00 && memory[1] == 0x00 && memory[2] == 0xFE && memory[3])
-                return utf32_big(memory + 4, size - 4, resource);
-        }
+        return _transcode<false>(data, size, resource);
+    }
+    template <typename CharT, typename MemoryResource = _detail::default_memory_resource,
+              typename = _require_secondary_char_type<From, CharT>>
+    auto operator()(const CharT* data, std::size_t size,
+                    MemoryResource* resource = _detail::get_memory_resource<MemoryResource>()) const
+        -> transcode_result<To, MemoryResource>
+    {
+        static_assert(sizeof(CharT) == sizeof(_from_char));
+        return _transcode<false>(reinterpret_cast<const _from_char*>(data), size, resource);
+    }
 
-        return utf32_big(memory, size, resource);
+    // If Swap is true, the code units are stored in the other byte order.
+    template <bool Swap, typename MemoryResource>
+    static auto _transcode(const _from_char* data, std::size_t size, MemoryResource* resource)
+        -> transcode_result<To, MemoryResource>
+    {
+        using transcoder = _detail::transcoder<From, To, Swap>;
+
+        // We first determine the size of the result, so we can write it into the buffer directly.
+        const _from_char* error  = nullptr;
+        auto              length = transcoder::measure(data, data + size, error);
+        if (error != nullptr)
+            return transcode_result<To, MemoryResource>(buffer<To, MemoryResource>(resource),
+                                                        std::size_t(error - data));
+
+        typename buffer<To, MemoryResource>::builder builder(length, resource);
+        transcoder::write(data, data + size, builder.data());
+        return transcode_result<To, MemoryResource>(LEXY_MOV(builder).finish(), std::size_t(-1));
     }
 };
 
-/// Creates a buffer with the specified encoding/endianness from raw memory.
-template <typename Encoding, encoding_endianness Endianness>
-constexpr auto make_buffer_from_raw = _make_buffer<Encoding, Endianness>{};
+/// Creates a buffer of the encoding `To` from the code units of the encoding `From`,
+/// which must be UTF-16 or UTF-32, converting each code point.
+template <typename From, typename To>
+constexpr auto make_buffer_transcoded = _make_buffer_transcoded<From, To>{};
 
 //=== convenience typedefs ===//
 template <typename Encoding       = default_encoding,
@@ -0,0 +1,255 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_INPUT_CHUNKED_INPUT_HPP_INCLUDED
+#define LEXY_INPUT_CHUNKED_INPUT_HPP_INCLUDED
+
+#include <lexy/_detail/assert.hpp>
+#include <lexy/_detail/iterator.hpp>
+#include <lexy/_detail/string_view.hpp>
+#include <lexy/error.hpp>
+#include <lexy/input/base.hpp>
+#include <lexy/lexeme.hpp>
+
+namespace lexy::_detail
+{
+template <typename Encoding, typename Chunk>
+class chunked_reader;
+} // namespace lexy::_detail
+
+namespace lexy
+{
+/// An iterator over the characters of a list of chunks, which are contiguous ranges of
+/// characters.
+template <typename CharT, typename Chunk>
+class chunked_iterator
+: public _detail::bidirectional_iterator_base<chunked_iterator<CharT, Chunk>, const CharT>
+{
+public:
+    constexpr chunked_iterator() noexcept
+    : _chunk(nullptr), _last(nullptr), _cur(nullptr), _chunk_end(nullptr)
+    {}
+
+    /// An iterator to the first character of the chunks.
+    constexpr explicit chunked_iterator(const Chunk* chunks, std::size_t count) noexcept
+    : _chunk(chunks), _last(chunks + count), _cur(nullptr), _chunk_end(nullptr)
+    {
+        // Find the first non-empty chunk.
+        for (auto chunk = chunks; chunk != _last; ++chunk)
+            if (chunk->size() > 0)
+            {
+                _set_chunk(chunk, 0);
+                return;
+            }
+    }
+
+    constexpr const CharT& deref() const noexcept
+    {
+        return *_cur;
+    }
+
+    constexpr void increment() noexcept
+    {
+        LEXY_PRECONDITION(!is_end());
+        if (++_cur == _chunk_end)
+            _next_chunk();
+    }
+    constexpr void decrement() noexcept
+    {
+        // Check whether we point to the first character of the chunk.
+        if (_cur == _data(*_chunk))
+        {
+            // Go to the end of the previous non-empty chunk.
+            // We will have one, otherwise we would point to the beginning.
+            do
+                --_chunk;
+            while (_chunk->size() == 0);
+            _set_chunk(_chunk, _chunk->size() - 1);
+        }
+        else
+            --_cur;
+    }
+
+    constexpr bool equal(chunked_iterator rhs) const noexcept
+    {
+        return _chunk == rhs._chunk && _cur == rhs._cur;
+    }
+    constexpr bool is_end() const noexcept
+    {
+        // We never point to the end of a chunk, unless it is the last one.
+        return _cur == _chunk_end;
+    }
+
+private:
+    static constexpr const CharT* _data(const Chunk& chunk) noexcept
+    {
+        if constexpr (std::is_same_v<decltype(chunk.data()), const CharT*>)
+            return chunk.data();
+        else
+            return reinterpret_cast<const CharT*>(chunk.data());
+    }
+
+    constexpr void _set_chunk(const Chunk* chunk, std::size_t pos) noexcept
+    {
+        _chunk     = chunk;
+        _cur       = _data(*chunk) + pos;
+        _chunk_end = _data(*chunk) + chunk->size();
+    }
+
+    // Called when we've reached the end of the current chunk.
+    constexpr void _next_chunk() noexcept
+    {
+        for (auto next = _chunk + 1; next != _last; ++next)
+            if (next->size() > 0)
+            {
+                _set_chunk(next, 0);
+                return;
+            }
+
+        // We're at the end; stay at the end of the last non-empty chunk.
+    }
+
+    const Chunk* _chunk;
+    const Chunk* _last;
+    const CharT* _cur;
+    const CharT* _chunk_end;
+
+    template <typename Encoding, typename C>
+    friend class _detail::chunked_reader;
+};
+} // namespace lexy
+
+namespace lexy::_detail
+{
+// Tracks the end of the current chunk, so it can be advanced within the chunk directly.
+template <typename Encoding, typename Chunk>
+class chunked_reader
+{
+public:
+    using encoding         = Encoding;
+    using char_type        = typename encoding::char_type;
+    using iterator         = chunked_iterator<char_type, Chunk>;
+    using canonical_reader = chunked_reader<Encoding, Chunk>;
+
+    constexpr explicit chunked_reader(iterator begin) noexcept : _cur(begin) {}
+
+    constexpr bool eof() const noexcept
+    {
+        return _cur.is_end();
+    }
+
+    constexpr auto peek() const noexcept
+    {
+        if (_cur.is_end())
+            return encoding::eof();
+        else
+            return encoding::to_int_type(*_cur._cur);
+    }
+
+    constexpr void bump() noexcept
+    {
+        _cur.increment();
+    }
+
+    constexpr iterator cur() const noexcept
+    {
+        return _cur;
+    }
+
+    // The remaining characters of the current chunk.
+    constexpr auto remaining() const noexcept
+    {
+        return basic_string_view<char_type>(_cur._cur, _cur._chunk_end);
+    }
+
+    // Advances by `n` characters of the current chunk.
+    constexpr void bump(std::size_t n) noexcept
+    {
+        LEXY_PRECONDITION(n <= remaining().size());
+        _cur._cur += n;
+        if (_cur._cur == _cur._chunk_end)
+            _cur._next_chunk();
+    }
+
+private:
+    iterator _cur;
+};
+} // namespace lexy::_detail
+
+namespace lexy
+{
+/// An input that consists of multiple chunks, e.g. the buffers of a network message,
+/// without copying them into contiguous memory.
+/// `Chunk` is a contiguous range of characters like `std::span`, and must have `data()` and
+/// `size()`.
+template <typename Encoding, typename Chunk>
+class chunked_input
+{
+    using _chunk_char_type
+        = std::remove_cv_t<std::remove_pointer_t<decltype(LEXY_DECLVAL(const Chunk&).data())>>;
+
+public:
+    using encoding  = Encoding;
+    using char_type = typename encoding::char_type;
+    static_assert(std::is_same_v<char_type, _chunk_char_type>
+                      || Encoding::template is_secondary_char_type<_chunk_char_type>(),
+                  "invalid character type for the encoding");
+
+    using iterator = chunked_iterator<char_type, Chunk>;
+
+    //=== constructors ===//
+    constexpr chunked_input() noexcept : _chunks(nullptr), _count(0) {}
+
+    /// Uses the chunks in the range `[chunks, chunks + count)`, which must outlive the input.
+    constexpr chunked_input(const Chunk* chunks, std::size_t count) noexcept
+    : _chunks(chunks), _count(count)
+    {}
+
+    /// Uses the chunks of a contiguous container, which must outlive the input.
+    template <typename Container, typename = decltype(LEXY_DECLVAL(const Container&).data())>
+    constexpr explicit chunked_input(const Container& chunks) noexcept
+    : _chunks(chunks.data()), _count(chunks.size())
+    {}
+
+    //=== access ===//
+    constexpr iterator begin() const noexcept
+    {
+        return iterator(_chunks, _count);
+    }
+
+    //=== reader ===//
+    constexpr auto reader() const& noexcept
+    {
+        return _detail::chunked_reader<Encoding, Chunk>(begin());
+    }
+
+private:
+    const Chunk* _chunks;
+    std::size_t  _count;
+};
+
+template <typename Chunk>
+chunked_input(const Chunk* chunks, std::size_t count)
+    -> chunked_input<deduce_encoding<std::remove_cv_t<
+                         std::remove_pointer_t<decltype(LEXY_DECLVAL(const Chunk&).data())>>>,
+                     Chunk>;
+template <typename Container>
+chunked_input(const Container& chunks)
+    -> chunked_input<deduce_encoding<std::remove_cv_t<std::remove_pointer_t<
+                         decltype(LEXY_DECLVAL(const Container&).data()->data())>>>,
+                     std::remove_cv_t<std::remove_pointer_t<
+                         decltype(LEXY_DECLVAL(const Container&).data())>>>;
+
+//=== convenience typedefs ===//
+template <typename Encoding, typename Chunk>
+using chunked_lexeme = lexeme_for<chunked_input<Encoding, Chunk>>;
+
+template <typename Tag, typename Encoding, typename Chunk>
+using chunked_error = error_for<chunked_input<Encoding, Chunk>, Tag>;
+
+template <typename Production, typename Encoding, typename Chunk>
+using chunked_error_context = error_context<Production, chunked_input<Encoding, Chunk>>;
+} // namespace lexy
+
+#endif // LEXY_INPUT_CHUNKED_INPUT_HPP_INCLUDED
@@ -32,6 +32,35 @@ enum class file_error
     file_not_found,
     /// The file cannot be opened.
     permission_denied,
+    /// The contents of the file could not be transcoded, as they are malformed.
+    invalid_encoding,
+};
+
+/// How the contents of a file are read into memory.
+enum class read_file_strategy
+{
+    /// Picks one of the strategies below depending on the size of the file.
+    automatic,
+    /// Uses `read()` to read the entire file.
+    read,
+    /// Uses a loop of `pread()` to read the entire file without seeking.
+    pread,
+    /// Maps the file using `mmap()`, prefaulting all pages, and copies it.
+    mmap,
+    /// Bypasses the page cache using `O_DIRECT` with aligned memory, and copies it.
+    direct,
+};
+
+/// Options that control `lexy::read_file()`.
+struct read_file_options
+{
+    read_file_strategy strategy = read_file_strategy::automatic;
+    /// Files up to that size are read into a buffer on the stack first, which avoids a system call.
+    /// Only up to 4 KiB are read into the stack.
+    std::size_t small_file_size = 4 * 1024u;
+    /// Files up to that size are read using `read()` by the automatic strategy, bigger ones are
+    /// mapped.
+    std::size_t medium_file_size = 32 * 1024u;
 };
 } // namespace lexy
 
@@ -46,8 +75,44 @@ using file_callback = void (*)(void* user_data, const char* memory, std::size_t
 // Do not change ABI, especially with different build configurations!
 file_error read_file(const char* path, file_callback cb, void* user_data);
 
+// Allocates the memory the file is read into directly.
+// `prefix` contains the first bytes of the file (at most four),
+// `size` is the size of the entire file.
+// It stores the number of bytes at the beginning that should be skipped (e.g. a BOM) in `offset`,
+// and returns memory for the remaining bytes, or nullptr if they can't be used as-is.
+using file_allocate_callback = void* (*)(void* user_data, const char* prefix,
+                                         std::size_t prefix_size, std::size_t size,
+                                         std::size_t& offset);
+
+// Same as above, but uses the options and reads the file into the memory returned by
+// `allocate`, if possible. In that case, the callback is not invoked.
+//
+// Do not change ABI, especially with different build configurations!
+file_error read_file(const char* path, const read_file_options& options,
+                     file_allocate_callback allocate, file_callback cb, void* user_data);
+
 // Same as above, but reads from stdin.
 file_error read_stdin(file_callback cb, void* user_data);
+file_error read_stdin(file_allocate_callback allocate, file_callback cb, void* user_data);
+
+struct file_mapping
+{
+    const void* memory;
+    std::size_t size;
+    std::size_t _mapping_size;
+};
+
+// Maps the entire contents of the specified file into memory, followed by the sentinel.
+// The size of the file is rounded down to a multiple of the sentinel size, if there is one.
+// On success, stores the memory in `mapping`; it must be released by calling `unmap_file()`.
+// On error, returns the error without modifying `mapping`.
+//
+// Do not change ABI, especially with different build configurations!
+file_error map_file(const char* path, const void* sentinel, std::size_t sentinel_size,
+                    file_mapping& mapping);
+
+// Releases the memory of a mapping created by `map_file()`.
+void unmap_file(const file_mapping& mapping) noexcept;
 } // namespace lexy::_detail
 
 namespace lexy
@@ -120,10 +185,25 @@ private:
 template <typename Encoding, encoding_endianness Endian, typename MemoryResource>
 struct _read_file_user_data
 {
+    using char_type = typename Encoding::char_type;
+
     lexy::buffer<Encoding, MemoryResource> buffer;
     MemoryResource*                        resource;
+    // Set by `allocate()` if the code units still need to be converted to the native endianness.
+    char_type* byte_swap_data;
+
+    _read_file_user_data(MemoryResource* resource)
+    : buffer(resource), resource(resource), byte_swap_data(nullptr)
+    {}
 
-    _read_file_user_data(MemoryResource* resource) : buffer(resource), resource(resource) {}
+    void finish(file_error ec) noexcept
+    {
+        if constexpr (sizeof(char_type) > 1)
+        {
+            if (ec == file_error::_success && byte_swap_data != nullptr)
+                _detail::byte_swap(byte_swap_data, byte_swap_data, buffer.size());
+        }
+    }
 
     static auto callback()
     {
@@ -134,20 +214,143 @@ struct _read_file_user_data
                 = lexy::make_buffer_from_raw<Encoding, Endian>(memory, size, user_data->resource);
         };
     }
+
+    static auto allocate()
+    {
+        return [](void* _user_data, const char* prefix, std::size_t prefix_size, std::size_t size,
+                  std::size_t& offset) -> void* {
+            constexpr auto native_endianness
+                = LEXY_IS_LITTLE_ENDIAN ? encoding_endianness::little : encoding_endianness::big;
+
+            auto bom = _bom{0, Endian};
+            if constexpr (Endian == encoding_endianness::bom)
+                bom = _detect_bom<Encoding>(reinterpret_cast<const unsigned char*>(prefix),
+                                            prefix_size);
+
+            if ((size - bom.size) % sizeof(char_type) != 0)
+                // Let `make_buffer_from_raw()` deal with it.
+                return nullptr;
+
+            auto user_data = static_cast<_read_file_user_data*>(_user_data);
+
+            typename lexy::buffer<Encoding, MemoryResource>::builder
+                builder((size - bom.size) / sizeof(char_type), user_data->resource);
+            auto memory       = builder.data();
+            user_data->buffer = LEXY_MOV(builder).finish();
+
+            if (sizeof(char_type) > 1 && bom.endianness != native_endianness)
+                // We convert the endianness in place after everything has been read.
+                user_data->byte_swap_data = memory;
+
+            offset = bom.size;
+            return memory;
+        };
+    }
 };
 
 /// Reads the file at the specified path into a buffer.
 template <typename Encoding          = default_encoding,
           encoding_endianness Endian = encoding_endianness::bom,
           typename MemoryResource    = _detail::default_memory_resource>
-auto read_file(const char*     path,
+auto read_file(const char* path, const read_file_options& options,
                MemoryResource* resource = _detail::get_memory_resource<MemoryResource>())
     -> read_file_result<Encoding, MemoryResource>
 {
     _read_file_user_data<Encoding, Endian, MemoryResource> user_data(resource);
-    auto error = _detail::read_file(path, user_data.callback(), &user_data);
+    auto error = _detail::read_file(path, options, user_data.allocate(), user_data.callback(),
+                                    &user_data);
+    user_data.finish(error);
     return read_file_result(error, LEXY_MOV(user_data.buffer));
 }
+template <typename Encoding          = default_encoding,
+          encoding_endianness Endian = encoding_endianness::bom,
+          typename MemoryResource    = _detail::default_memory_resource>
+auto read_file(const char*     path,
+               MemoryResource* resource = _detail::get_memory_resource<MemoryResource>())
+    -> read_file_result<Encoding, MemoryResource>
+{
+    return read_file<Encoding, Endian>(path, read_file_options{}, resource);
+}
+
+template <typename From, typename To, encoding_endianness Endian, typename MemoryResource>
+struct _read_file_transcoded_user_data
+{
+    using from_char = typename From::char_type;
+
+    lexy::buffer<To, MemoryResource> buffer;
+    MemoryResource*                  resource;
+    bool                             invalid;
+
+    _read_file_transcoded_user_data(MemoryResource* resource)
+    : buffer(resource), resource(resource), invalid(false)
+    {}
+
+    file_error finish(file_error ec) noexcept
+    {
+        if (ec == file_error::_success && invalid)
+            return file_error::invalid_encoding;
+        else
+            return ec;
+    }
+
+    static auto callback()
+    {
+        return [](void* _user_data, const char* _memory, std::size_t size) {
+            constexpr auto native_endianness
+                = LEXY_IS_LITTLE_ENDIAN ? encoding_endianness::little : encoding_endianness::big;
+
+            auto user_data = static_cast<_read_file_transcoded_user_data*>(_user_data);
+            auto memory    = reinterpret_cast<const unsigned char*>(_memory);
+
+            auto bom = _bom{0, Endian};
+            if constexpr (Endian == encoding_endianness::bom)
+                bom = _detect_bom<From>(memory, size);
+            if ((size - bom.size) % sizeof(from_char) != 0)
+            {
+                // A trailing partial code unit.
+                user_data->invalid = true;
+                return;
+            }
+
+            // The memory is suitably aligned, as it was allocated or mapped for the file,
+            // and the BOM consists of one code unit.
+            auto data  = reinterpret_cast<const from_char*>(memory + bom.size);
+            auto count = (size - bom.size) / sizeof(from_char);
+
+            using make  = _make_buffer_transcoded<From, To>;
+            auto result = bom.endianness == native_endianness
+                              ? make::template _transcode<false>(data, count, user_data->resource)
+                              : make::template _transcode<true>(data, count, user_data->resource);
+            if (result)
+                user_data->buffer = LEXY_MOV(result).buffer();
+            else
+                user_data->invalid = true;
+        };
+    }
+};
+
+/// Reads the file at the specified path, whose contents are UTF-16 or UTF-32, into a buffer of
+/// another encoding.
+template <typename From, typename To, encoding_endianness Endian = encoding_endianness::bom,
+          typename MemoryResource = _detail::default_memory_resource>
+auto read_file_transcoded(const char* path, const read_file_options& options,
+                          MemoryResource* resource = _detail::get_memory_resource<MemoryResource>())
+    -> read_file_result<To, MemoryResource>
+{
+    // We don't allocate the memory for the file, so we transcode from the memory it was read
+    // into, or from the mapping directly.
+    _read_file_transcoded_user_data<From, To, Endian, MemoryResource> user_data(resource);
+    auto error = _detail::read_file(path, options, nullptr, user_data.callback(), &user_data);
+    return read_file_result(user_data.finish(error), LEXY_MOV(user_data.buffer));
+}
+template <typename From, typename To, encoding_endianness Endian = encoding_endianness::bom,
+          typename MemoryResource = _detail::default_memory_resource>
+auto read_file_transcoded(const char*     path,
+                          MemoryResource* resource = _detail::get_memory_resource<MemoryResource>())
+    -> read_file_result<To, MemoryResource>
+{
+    return read_file_transcoded<From, To, Endian>(path, read_file_options{}, resource);
+}
 
 /// Reads stdin into a buffer.
 template <typename Encoding          = default_encoding,
@@ -157,10 +360,194 @@ auto read_stdin(MemoryResource* resource = _detail::get_memory_resource<MemoryRe
     -> read_file_result<Encoding, MemoryResource>
 {
     _read_file_user_data<Encoding, Endian, MemoryResource> user_data(resource);
-    auto error = _detail::read_stdin(user_data.callback(), &user_data);
+    auto error = _detail::read_stdin(user_data.allocate(), user_data.callback(), &user_data);
+    user_data.finish(error);
     return read_file_result(error, LEXY_MOV(user_data.buffer));
 }
 } // namespace lexy
 
+namespace lexy
+{
+/// An input that owns the memory mapping of a file.
+/// Unlike `lexy::read_file()`, it does not copy the file contents into a buffer.
+template <typename Encoding = default_encoding>
+class mapped_file_input
+{
+public:
+    using encoding  = Encoding;
+    using char_type = typename encoding::char_type;
+    static_assert(std::is_trivial_v<char_type>);
+
+    //=== constructors ===//
+    constexpr mapped_file_input() noexcept : _mapping{nullptr, 0, 0}, _data(nullptr), _size(0) {}
+
+    mapped_file_input(const mapped_file_input&) = delete;
+    mapped_file_input& operator=(const mapped_file_input&) = delete;
+
+    mapped_file_input(mapped_file_input&& other) noexcept
+    : _mapping(other._mapping), _data(other._data), _size(other._size)
+    {
+        other._mapping = {nullptr, 0, 0};
+        other._data    = nullptr;
+        other._size    = 0;
+    }
+
+    mapped_file_input& operator=(mapped_file_input&& other) noexcept
+    {
+        _detail::swap(_mapping, other._mapping);
+        _detail::swap(_data, other._data);
+        _detail::swap(_size, other._size);
+        return *this;
+    }
+
+    ~mapped_file_input() noexcept
+    {
+        if (_mapping.memory)
+            _detail::unmap_file(_mapping);
+    }
+
+    //=== access ===//
+    const char_type* data() const noexcept
+    {
+        return _data;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return _size;
+    }
+
+    //=== reader ===//
+    auto reader() const& noexcept
+    {
+        if constexpr (_has_sentinel)
+        {
+            // An input without mapping is empty, so we read the sentinel of a static one instead.
+            static constexpr char_type empty[] = {char_type(encoding::eof())};
+            auto                       data    = _data ? _data : empty;
+            return _detail::sentinel_reader<encoding>(data, data + _size);
+        }
+        else
+            return _detail::range_reader<encoding, const char_type*>(_data, _data + _size);
+    }
+
+public:
+    // Pretend this doesn't exist.
+    static constexpr auto _has_sentinel
+        = std::is_same_v<typename Encoding::char_type, typename Encoding::int_type>;
+
+    explicit mapped_file_input(_detail::file_mapping mapping) noexcept : _mapping(mapping)
+    {
+        // The reinterpret_cast is technically UB, as we didn't create objects in memory,
+        // but until std::start_lifetime_as is added, there is nothing we can do.
+        _data = static_cast<const char_type*>(_mapping.memory);
+        _size = _mapping.size / sizeof(char_type);
+
+        // We skip over the BOM if there is one; it has to use the native byte order.
+        auto bytes = static_cast<const unsigned char*>(_mapping.memory);
+        if constexpr (std::is_same_v<Encoding, utf8_encoding>)
+        {
+            if (_size >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF)
+            {
+                _data += 3;
+                _size -= 3;
+            }
+        }
+        else if constexpr (std::is_same_v<Encoding, utf16_encoding> //
+                           || std::is_same_v<Encoding, utf32_encoding>)
+        {
+            if (_size >= 1 && _data[0] == 0xFEFF)
+            {
+                _data += 1;
+                _size -= 1;
+            }
+        }
+    }
+
+private:
+    _detail::file_mapping _mapping;
+    const char_type*      _data;
+    std::size_t           _size;
+};
+
+template <typename Encoding = default_encoding>
+class map_file_result
+{
+public:
+    using encoding  = Encoding;
+    using char_type = typename encoding::char_type;
+
+    explicit operator bool() const noexcept
+    {
+        return _ec == file_error::_success;
+    }
+
+    const mapped_file_input<Encoding>& input() const& noexcept
+    {
+        LEXY_PRECONDITION(*this);
+        return _input;
+    }
+    mapped_file_input<Encoding>&& input() && noexcept
+    {
+        LEXY_PRECONDITION(*this);
+        return LEXY_MOV(_input);
+    }
+
+    file_error error() const noexcept
+    {
+        LEXY_PRECONDITION(!*this);
+        return _ec;
+    }
+
+public:
+    // Pretend these two don't exist.
+    explicit map_file_result(mapped_file_input<Encoding>&& input) noexcept
+    : _input(LEXY_MOV(input)), _ec(file_error::_success)
+    {}
+    explicit map_file_result(file_error ec) noexcept : _input(), _ec(ec)
+    {
+        LEXY_PRECONDITION(!*this);
+    }
+
+private:
+    mapped_file_input<Encoding> _input;
+    file_error                  _ec;
+};
+
+/// Maps the file at the specified path into memory without copying it.
+template <typename Encoding = default_encoding>
+auto map_file(const char* path) -> map_file_result<Encoding>
+{
+    using input_t = mapped_file_input<Encoding>;
+
+    _detail::file_mapping mapping;
+    file_error            error;
+    if constexpr (input_t::_has_sentinel)
+    {
+        constexpr typename Encoding::char_type sentinel = Encoding::eof();
+        error = _detail::map_file(path, &sentinel, sizeof(sentinel), mapping);
+    }
+    else
+    {
+        error = _detail::map_file(path, nullptr, 0, mapping);
+    }
+
+    if (error != file_error::_success)
+        return map_file_result<Encoding>(error);
+    else
+        return map_file_result<Encoding>(input_t(mapping));
+}
+
+//=== convenience typedefs ===//
+template <typename Encoding = default_encoding>
+using mapped_file_lexeme = lexeme_for<mapped_file_input<Encoding>>;
+
+template <typename Tag, typename Encoding = default_encoding>
+using mapped_file_error = error_for<mapped_file_input<Encoding>, Tag>;
+
+template <typename Production, typename Encoding = default_encoding>
+using mapped_file_error_context = error_context<Production, mapped_file_input<Encoding>>;
+} // namespace lexy
+
 #endif // LEXY_INPUT_FILE_HPP_INCLUDED
 
@@ -0,0 +1,290 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_INPUT_STREAM_INPUT_HPP_INCLUDED
+#define LEXY_INPUT_STREAM_INPUT_HPP_INCLUDED
+
+#include <cstdio>
+#include <cstring>
+#include <lexy/_detail/assert.hpp>
+#include <lexy/_detail/iterator.hpp>
+#include <lexy/error.hpp>
+#include <lexy/input/base.hpp>
+#include <lexy/input/file.hpp>
+#include <lexy/lexeme.hpp>
+#include <new>
+
+namespace lexy::_detail
+{
+// Reads at most `size` bytes from the file descriptor, storing the number of bytes read in `read`.
+// A `read` of zero means EOF.
+//
+// Do not change ABI, especially with different build configurations!
+file_error read_fd(int fd, void* buffer, std::size_t size, std::size_t& read);
+} // namespace lexy::_detail
+
+namespace lexy
+{
+/// An input that reads a file in chunks as needed.
+/// It only keeps the characters that have not been discarded in memory.
+/// Without calls to `discard()`, memory is not bounded and the entire file is kept.
+template <typename Encoding = default_encoding>
+class stream_input
+{
+public:
+    using encoding  = Encoding;
+    using char_type = typename encoding::char_type;
+    static_assert(sizeof(char_type) == sizeof(char), "only support single-byte encodings");
+
+    static constexpr std::size_t default_chunk_size = 64 * 1024u;
+
+    //=== constructors ===//
+    /// Reads from the `FILE`, which must be opened in binary mode.
+    explicit stream_input(std::FILE* file, std::size_t chunk_size = default_chunk_size) noexcept
+    : _file(file), _fd(-1), _chunk_size(chunk_size)
+    {
+        LEXY_PRECONDITION(file);
+        LEXY_PRECONDITION(chunk_size > 0);
+    }
+    /// Reads from the file descriptor.
+    explicit stream_input(int fd, std::size_t chunk_size = default_chunk_size) noexcept
+    : _file(nullptr), _fd(fd), _chunk_size(chunk_size)
+    {
+        LEXY_PRECONDITION(fd >= 0);
+        LEXY_PRECONDITION(chunk_size > 0);
+    }
+
+    // Readers refer to the input, so it can't be moved.
+    stream_input(const stream_input&) = delete;
+    stream_input& operator=(const stream_input&) = delete;
+
+    ~stream_input() noexcept
+    {
+        ::operator delete(_data);
+    }
+
+    //=== access ===//
+    /// The error that occurred while reading, if any.
+    /// After an error, the input behaves as if EOF has been reached.
+    file_error error() const noexcept
+    {
+        return _ec;
+    }
+
+    /// The number of characters currently kept in memory.
+    std::size_t buffered_size() const noexcept
+    {
+        return _size;
+    }
+
+    //=== iterator ===//
+    /// Refers to a character by its position in the stream.
+    class iterator : public _detail::forward_iterator_base<iterator, const char_type>
+    {
+    public:
+        constexpr iterator() noexcept = default;
+
+        const char_type& deref() const noexcept
+        {
+            LEXY_PRECONDITION(_input->_offset <= _pos && _pos < _input->_offset + _input->_size);
+            return _input->_data[_pos - _input->_offset];
+        }
+
+        constexpr void increment() noexcept
+        {
+            ++_pos;
+        }
+
+        constexpr bool equal(iterator rhs) const noexcept
+        {
+            LEXY_PRECONDITION(_input == rhs._input);
+            return _pos == rhs._pos;
+        }
+
+        /// The position of the character in the stream.
+        constexpr std::size_t position() const noexcept
+        {
+            return _pos;
+        }
+
+        friend constexpr iterator operator+(iterator iter, std::size_t n) noexcept
+        {
+            iter._pos += n;
+            return iter;
+        }
+        friend constexpr std::ptrdiff_t operator-(iterator lhs, iterator rhs) noexcept
+        {
+            return static_cast<std::ptrdiff_t>(lhs._pos - rhs._pos);
+        }
+        friend constexpr bool operator<(iterator lhs, iterator rhs) noexcept
+        {
+            return lhs._pos < rhs._pos;
+        }
+        friend constexpr bool operator<=(iterator lhs, iterator rhs) noexcept
+        {
+            return lhs._pos <= rhs._pos;
+        }
+
+    private:
+        constexpr explicit iterator(const stream_input* input, std::size_t pos) noexcept
+        : _input(input), _pos(pos)
+        {}
+
+        const stream_input* _input = nullptr;
+        std::size_t         _pos   = 0;
+
+        friend stream_input;
+    };
+
+    //=== reader ===//
+    class _reader
+    {
+    public:
+        using encoding         = Encoding;
+        using char_type        = typename encoding::char_type;
+        using iterator         = typename stream_input::iterator;
+        using canonical_reader = _reader;
+
+        bool eof() const
+        {
+            return _pos - _input->_offset >= _input->_size && !_input->_read_until(_pos);
+        }
+
+        auto peek() const
+        {
+            if (_pos - _input->_offset >= _input->_size && !_input->_read_until(_pos))
+                return encoding::eof();
+
+            // Note that reading a chunk may have moved the characters.
+            return encoding::to_int_type(_input->_data[_pos - _input->_offset]);
+        }
+
+        void bump() noexcept
+        {
+            ++_pos;
+        }
+
+        iterator cur() const noexcept
+        {
+            return iterator(_input, _pos);
+        }
+
+    private:
+        explicit _reader(const stream_input* input, std::size_t pos) noexcept
+        : _input(input), _pos(pos)
+        {}
+
+        const stream_input* _input;
+        std::size_t         _pos;
+
+        friend stream_input;
+    };
+
+    /// Returns a reader that starts at the discard position.
+    auto reader() const& noexcept
+    {
+        return _reader(this, _discard_pos);
+    }
+
+    //=== discard ===//
+    /// Discards all characters before the position.
+    /// Iterators, readers, and lexemes that refer to them are invalidated.
+    void discard(iterator pos) noexcept
+    {
+        LEXY_PRECONDITION(pos._input == this);
+        LEXY_PRECONDITION(_discard_pos <= pos._pos && pos._pos <= _offset + _size);
+        _discard_pos = pos._pos;
+    }
+
+private:
+    // Reads chunks until the position is available, returns whether or not that was possible.
+    bool _read_until(std::size_t pos) const
+    {
+        while (pos - _offset >= _size)
+        {
+            if (!_read_chunk())
+                return false;
+        }
+        return true;
+    }
+
+    // Reads the next chunk, returns whether or not anything was read.
+    bool _read_chunk() const
+    {
+        if (_eof)
+            return false;
+
+        // Move the characters that haven't been discarded to the front of the buffer.
+        // This keeps the memory bounded by the characters still in use.
+        if (auto discarded = _discard_pos - _offset; discarded > 0)
+        {
+            std::memmove(_data, _data + discarded, _size - discarded);
+            _size -= discarded;
+            _offset = _discard_pos;
+        }
+
+        // Make room for another chunk.
+        if (_capacity - _size < _chunk_size)
+        {
+            auto new_capacity = _capacity == 0 ? _chunk_size : 2 * _capacity;
+            while (new_capacity - _size < _chunk_size)
+                new_capacity *= 2;
+
+            auto memory = static_cast<char_type*>(::operator new(new_capacity * sizeof(char_type)));
+            if (_size > 0)
+                std::memcpy(memory, _data, _size * sizeof(char_type));
+            ::operator delete(_data);
+
+            _data     = memory;
+            _capacity = new_capacity;
+        }
+
+        auto read = std::size_t(0);
+        if (_file)
+        {
+            read = std::fread(_data + _size, sizeof(char_type), _chunk_size, _file);
+            if (read < _chunk_size && std::ferror(_file))
+                _ec = file_error::os_error;
+        }
+        else
+        {
+            _ec = _detail::read_fd(_fd, _data + _size, _chunk_size, read);
+            if (_ec != file_error::_success)
+                read = 0;
+        }
+
+        _size += read;
+        if (read == 0)
+            _eof = true;
+        return read > 0;
+    }
+
+    std::FILE*  _file;
+    int         _fd;
+    std::size_t _chunk_size;
+
+    // The characters [_offset, _offset + _size) of the stream are stored in _data.
+    mutable char_type*  _data     = nullptr;
+    mutable std::size_t _capacity = 0;
+    mutable std::size_t _size     = 0;
+    mutable std::size_t _offset   = 0;
+    // Everything before this position has been discarded and may be released.
+    std::size_t _discard_pos = 0;
+
+    mutable file_error _ec  = file_error::_success;
+    mutable bool       _eof = false;
+};
+
+//=== convenience typedefs ===//
+template <typename Encoding = default_encoding>
+using stream_lexeme = lexeme_for<stream_input<Encoding>>;
+
+template <typename Tag, typename Encoding = default_encoding>
+using stream_error = error_for<stream_input<Encoding>, Tag>;
+
+template <typename Production, typename Encoding = default_encoding>
+using stream_error_context = error_context<Production, stream_input<Encoding>>;
+} // namespace lexy
+
+#endif // LEXY_INPUT_STREAM_INPUT_HPP_INCLUDED
@@ -0,0 +1,151 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_INPUT_VALIDATED_UTF8_BUFFER_HPP_INCLUDED
+#define LEXY_INPUT_VALIDATED_UTF8_BUFFER_HPP_INCLUDED
+
+#include <lexy/_detail/validate_utf8.hpp>
+#include <lexy/input/buffer.hpp>
+
+namespace lexy::_detail
+{
+// A sentinel reader whose input is known to be valid UTF-8.
+class validated_utf8_reader : public sentinel_reader<utf8_encoding>
+{
+public:
+    using canonical_reader = validated_utf8_reader;
+
+    // Allows code point engines to skip the validity checks.
+    static constexpr bool _validated_utf8 = true;
+
+    using sentinel_reader<utf8_encoding>::sentinel_reader;
+};
+} // namespace lexy::_detail
+
+namespace lexy
+{
+template <typename MemoryResource>
+class validate_utf8_result;
+
+/// A buffer of UTF-8 code units that is known to be valid UTF-8.
+/// Code points can then be decoded without checking them.
+template <typename MemoryResource = _detail::default_memory_resource>
+class validated_utf8_buffer
+{
+public:
+    using encoding  = utf8_encoding;
+    using char_type = typename encoding::char_type;
+
+    //=== access ===//
+    const char_type* data() const noexcept
+    {
+        return _buffer.data();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return _buffer.size();
+    }
+
+    /// Releases the underlying buffer.
+    lexy::buffer<utf8_encoding, MemoryResource>&& release() && noexcept
+    {
+        return LEXY_MOV(_buffer);
+    }
+
+    //=== input ===//
+    auto reader() const& noexcept
+    {
+        auto begin = _buffer.reader().cur();
+        return _detail::validated_utf8_reader(begin, begin + _buffer.size());
+    }
+
+private:
+    explicit validated_utf8_buffer(lexy::buffer<utf8_encoding, MemoryResource>&& buffer) noexcept
+    : _buffer(LEXY_MOV(buffer))
+    {}
+
+    lexy::buffer<utf8_encoding, MemoryResource> _buffer;
+
+    friend validate_utf8_result<MemoryResource>;
+};
+
+/// The result of `lexy::validate_utf8()`.
+template <typename MemoryResource>
+class validate_utf8_result
+{
+public:
+    using encoding  = utf8_encoding;
+    using char_type = typename encoding::char_type;
+
+    explicit operator bool() const noexcept
+    {
+        return _error == std::size_t(-1);
+    }
+
+    const validated_utf8_buffer<MemoryResource>& buffer() const& noexcept
+    {
+        LEXY_PRECONDITION(*this);
+        return _buffer;
+    }
+    validated_utf8_buffer<MemoryResource>&& buffer() && noexcept
+    {
+        LEXY_PRECONDITION(*this);
+        return LEXY_MOV(_buffer);
+    }
+
+    /// The index of the first code unit of the first invalid code point.
+    std::size_t error_offset() const noexcept
+    {
+        LEXY_PRECONDITION(!*this);
+        return _error;
+    }
+
+    /// Returns the buffer that failed validation, e.g. to parse it using the checked code point
+    /// rules, which report the error.
+    lexy::buffer<utf8_encoding, MemoryResource>&& invalid_buffer() && noexcept
+    {
+        LEXY_PRECONDITION(!*this);
+        return LEXY_MOV(_buffer._buffer);
+    }
+
+public:
+    // Pretend this doesn't exist.
+    explicit validate_utf8_result(lexy::buffer<utf8_encoding, MemoryResource>&& buffer,
+                                  std::size_t                                   error) noexcept
+    : _buffer(LEXY_MOV(buffer)), _error(error)
+    {}
+
+private:
+    // Only contains valid UTF-8 if _error == -1.
+    validated_utf8_buffer<MemoryResource> _buffer;
+    std::size_t                           _error;
+};
+
+/// Checks that the buffer contains valid UTF-8.
+template <typename MemoryResource>
+auto validate_utf8(buffer<utf8_encoding, MemoryResource>&& buffer) noexcept
+    -> validate_utf8_result<MemoryResource>
+{
+    auto begin = reinterpret_cast<const unsigned char*>(buffer.data());
+    auto end   = begin + buffer.size();
+
+    auto invalid = _detail::find_invalid_utf8(begin, end);
+    auto error   = invalid == end ? std::size_t(-1) : std::size_t(invalid - begin);
+    return validate_utf8_result<MemoryResource>(LEXY_MOV(buffer), error);
+}
+
+//=== convenience typedefs ===//
+template <typename MemoryResource = _detail::default_memory_resource>
+using validated_utf8_lexeme = lexeme_for<validated_utf8_buffer<MemoryResource>>;
+
+template <typename Tag, typename MemoryResource = _detail::default_memory_resource>
+using validated_utf8_error = error_for<validated_utf8_buffer<MemoryResource>, Tag>;
+
+template <typename Production, typename MemoryResource = _detail::default_memory_resource>
+using validated_utf8_error_context
+    = error_context<Production, validated_utf8_buffer<MemoryResource>>;
+} // namespace lexy
+
+#endif // LEXY_INPUT_VALIDATED_UTF8_BUFFER_HPP_INCLUDED
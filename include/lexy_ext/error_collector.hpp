@@ -0,0 +1,169 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef LEXY_EXT_ERROR_COLLECTOR_HPP_INCLUDED
+#define LEXY_EXT_ERROR_COLLECTOR_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstdio>
+#include <lexy_ext/report_error.hpp>
+#include <vector>
+
+namespace lexy_ext
+{
+/// Collects the errors of parsing the input to report them afterwards.
+///
+/// During parsing, it only stores the positions and the information to write an error.
+/// When writing, the errors are sorted by position and their locations are computed in a single
+/// pass over the input.
+/// Only the first `max_count` errors are written, so the cost is linear in the input size even
+/// if there are a lot of errors.
+///
+/// It requires an input whose iterators can be ordered, like `lexy::buffer`.
+template <typename Input>
+class error_collector
+{
+    using info     = _detail::error_info<Input>;
+    using iterator = typename info::iterator;
+
+    struct _callback
+    {
+        error_collector* _collector;
+
+        struct _sink
+        {
+            error_collector* _collector;
+            std::size_t      _count;
+
+            using return_type = std::size_t;
+
+            template <typename Production, typename Reader, typename Tag>
+            void operator()(const lexy::error_context<Production, Input>& context,
+                            const lexy::error<Reader, Tag>&               error)
+            {
+                _collector->_errors.push_back(info::make(context, error));
+                ++_count;
+            }
+
+            std::size_t finish() &&
+            {
+                return _count;
+            }
+        };
+
+        constexpr auto sink() const
+        {
+            return _sink{_collector, 0};
+        }
+    };
+
+public:
+    explicit error_collector(const Input& input) : _input(&input) {}
+
+    /// The error callback that adds the errors to the collector.
+    /// The collector must outlive it.
+    constexpr auto callback()
+    {
+        return _callback{this};
+    }
+
+    /// The number of errors collected so far.
+    std::size_t count() const noexcept
+    {
+        return _errors.size();
+    }
+    bool empty() const noexcept
+    {
+        return _errors.empty();
+    }
+
+    /// Removes all errors.
+    void clear() noexcept
+    {
+        _errors.clear();
+    }
+
+    /// Writes the first `max_count` errors sorted by position.
+    /// Returns the output iterator after the last error written.
+    template <typename OutputIt>
+    OutputIt write_to(OutputIt out, lexy::visualization_options opts = {},
+                      std::size_t max_count = std::size_t(-1))
+    {
+        // Sort the errors and discard the ones we don't write.
+        // We use a stable sort, so errors at the same position are written in the order they
+        // were raised.
+        std::stable_sort(_errors.begin(), _errors.end(),
+                         [](const info& lhs, const info& rhs) {
+                             return lhs.position < rhs.position;
+                         });
+        auto write_count = std::min(max_count, _errors.size());
+
+        // We need the locations of the context and of the error itself.
+        // The i-th error needs the positions 2 * i (context) and 2 * i + 1 (error).
+        struct position_t
+        {
+            iterator    pos;
+            std::size_t idx;
+        };
+        std::vector<position_t> positions;
+        positions.reserve(2 * write_count);
+        for (auto i = std::size_t(0); i != write_count; ++i)
+        {
+            positions.push_back({_errors[i].context, 2 * i});
+            positions.push_back({_errors[i].position, 2 * i + 1});
+        }
+        std::sort(positions.begin(), positions.end(),
+                  [](const position_t& lhs, const position_t& rhs) { return lhs.pos < rhs.pos; });
+
+        // Find all locations in a single pass.
+        // Each search starts at the previous location.
+        using finder_t = input_location_finder<Input>;
+        finder_t finder(*_input);
+
+        std::vector<typename finder_t::location> locations;
+        locations.reserve(positions.size());
+        std::vector<std::size_t> location_idx(positions.size());
+        for (auto& position : positions)
+        {
+            if (locations.empty())
+                locations.push_back(finder.find(position.pos));
+            else
+                locations.push_back(finder.find(position.pos, locations.back()));
+            location_idx[position.idx] = locations.size() - 1;
+        }
+
+        // Write the errors.
+        for (auto i = std::size_t(0); i != write_count; ++i)
+        {
+            auto& context_location = locations[location_idx[2 * i]];
+            auto& location         = locations[location_idx[2 * i + 1]];
+            out = _detail::write_error(out, _errors[i], context_location, location, opts);
+        }
+
+        return out;
+    }
+
+    /// Prints the first `max_count` errors sorted by position to stderr.
+    /// Returns the number of errors.
+    std::size_t report(std::size_t max_count = std::size_t(-1))
+    {
+        auto out = lexy::cfile_output_iterator{stderr};
+        out      = write_to(out, {lexy::visualize_fancy}, max_count);
+
+        if (max_count < _errors.size())
+            lexy::_detail::write_format(out, "(%zu more errors)\n", _errors.size() - max_count);
+        if (!_errors.empty())
+            std::fputs("\n", stderr);
+
+        return _errors.size();
+    }
+
+private:
+    const Input*      _input;
+    std::vector<info> _errors;
+};
+} // namespace lexy_ext
+
+#endif // LEXY_EXT_ERROR_COLLECTOR_HPP_INCLUDED
+
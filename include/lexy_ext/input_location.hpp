@@ -5,10 +5,14 @@
 #ifndef LEXY_EXT_INPUT_LOCATION_HPP_INCLUDED
 #define LEXY_EXT_INPUT_LOCATION_HPP_INCLUDED
 
+#include <algorithm>
+#include <lexy/_detail/ascii_set.hpp>
 #include <lexy/dsl/base.hpp>
+#include <lexy/dsl/code_point.hpp>
 #include <lexy/dsl/newline.hpp>
 #include <lexy/input/base.hpp>
 #include <lexy/lexeme.hpp>
+#include <vector>
 
 namespace lexy_ext
 {
@@ -34,6 +38,9 @@ struct _unchecked_code_unit
     };
 };
 
+template <typename Input, typename TokenColumn>
+class line_index;
+
 /// Converts positions (iterators) into locations (line/column nr).
 ///
 /// The unit for line and column numbers can be customized.
@@ -85,6 +92,11 @@ public:
         }
 
     private:
+        constexpr location(lexy::input_reader<Input> reader, iterator eol, std::size_t line,
+                           std::size_t column)
+        : _reader(LEXY_MOV(reader)), _eol(eol), _line(line), _column(column)
+        {}
+
         constexpr location(lexy::input_reader<Input> reader, std::size_t line, std::size_t column)
         : _reader(LEXY_MOV(reader)), _eol(), _line(line), _column(column)
         {
@@ -105,6 +117,7 @@ public:
         std::size_t               _line, _column;
 
         friend input_location_finder;
+        friend line_index<Input, TokenColumn>;
     };
 
     constexpr explicit input_location_finder(const Input& input) : _reader(input.reader()) {}
@@ -178,6 +191,157 @@ private:
     lexy::input_reader<Input> _reader;
 };
 
+/// Counts the code points of valid UTF-8 by counting the bytes that aren't continuation bytes.
+inline std::size_t _count_utf8_code_points(const unsigned char* str, std::size_t size) noexcept
+{
+    auto result = std::size_t(0);
+    auto pos    = std::size_t(0);
+#if LEXY_HAS_SSE2
+    while (size - pos >= 16)
+    {
+        // Count per byte lane, which can't overflow in 255 iterations.
+        auto counts = _mm_setzero_si128();
+        for (auto i = 0; i != 255 && size - pos >= 16; ++i, pos += 16)
+        {
+            auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos));
+            // Continuation bytes are 0x80-0xBF, i.e. -128 to -65 as signed bytes.
+            auto is_start = _mm_cmpgt_epi8(chars, _mm_set1_epi8(-65));
+            counts        = _mm_sub_epi8(counts, is_start);
+        }
+
+        auto sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+        result += static_cast<std::size_t>(_mm_cvtsi128_si32(sums))
+                  + static_cast<std::size_t>(_mm_extract_epi16(sums, 4));
+    }
+#endif
+
+    for (; pos != size; ++pos)
+        if ((str[pos] & 0xC0) != 0x80)
+            ++result;
+    return result;
+}
+
+/// Converts positions (iterators) into locations (line/column nr) using a precomputed index.
+///
+/// The index stores the beginning of every line, so a position is found using binary search
+/// instead of a linear search from the beginning or an anchor.
+/// It requires an input with contiguous storage like `lexy::buffer` or `lexy::string_input`.
+///
+/// Lines are separated by `lexy::dsl::newline`.
+/// By default, it counts code units in a line.
+/// If the column token is `lexy::dsl::code_point` and the input is UTF-8,
+/// the code points are counted by counting the bytes that aren't continuation bytes;
+/// unlike `input_location_finder`, invalid UTF-8 is then not skipped in the column number.
+/// Any other column token counts by matching it from the beginning of the line.
+template <typename Input, typename TokenColumn = _unchecked_code_unit>
+class line_index
+{
+    using finder   = input_location_finder<Input, TokenColumn>;
+    using reader_t = lexy::input_reader<Input>;
+    using char_type = typename reader_t::encoding::char_type;
+
+    static_assert(lexy::_is_contiguous_reader<reader_t>
+                      && std::is_same_v<typename reader_t::iterator, const char_type*>,
+                  "line_index requires an input with contiguous storage");
+
+    static constexpr auto _newline = lexy::_detail::ascii_set().insert('\n');
+
+public:
+    using iterator = typename finder::iterator;
+    using location = typename finder::location;
+
+    explicit line_index(const Input& input) : _finder(input), _reader(input.reader())
+    {
+        auto remaining = _reader.remaining();
+        auto begin     = remaining.data();
+        auto end       = begin + remaining.size();
+
+        // Every line begins after a newline character.
+        // This includes the "\r\n" newline, as "\r" isn't a newline on its own.
+        _line_begins.push_back(begin);
+        for (auto cur = begin; true;)
+        {
+            auto count = lexy::_detail::ascii_set_find<_newline>(cur, std::size_t(end - cur));
+            if (count == std::size_t(end - cur))
+                break;
+
+            cur += count + 1;
+            _line_begins.push_back(cur);
+        }
+        _end = end;
+    }
+    explicit line_index(const Input& input, TokenColumn) : line_index(input) {}
+
+    /// The number of lines in the input.
+    std::size_t line_count() const noexcept
+    {
+        return _line_begins.size();
+    }
+
+    /// The starting location.
+    location beginning() const
+    {
+        return _location(0, _reader.cur());
+    }
+
+    /// Finds the location of the position.
+    location find(iterator pos) const
+    {
+        LEXY_PRECONDITION(_line_begins.front() <= pos && pos <= _end);
+        auto next_line = std::upper_bound(_line_begins.begin(), _line_begins.end(), pos);
+        return _location(std::size_t(next_line - _line_begins.begin()) - 1, pos);
+    }
+    /// Finds the location of the position.
+    /// The anchor is ignored; it is only accepted for compatibility with `input_location_finder`.
+    location find(iterator pos, const location&) const
+    {
+        return find(pos);
+    }
+
+private:
+    location _location(std::size_t line_idx, iterator pos) const
+    {
+        auto line_begin = _line_begins[line_idx];
+
+        // The line ends before the newline, which is either "\n" or "\r\n".
+        auto eol = _end;
+        if (line_idx + 1 < _line_begins.size())
+        {
+            eol = _line_begins[line_idx + 1] - 1;
+            if (eol != line_begin && eol[-1] == '\r')
+                --eol;
+        }
+
+        auto reader = _reader;
+        reader.bump(std::size_t(line_begin - _line_begins.front()));
+
+        if constexpr (std::is_same_v<TokenColumn, _unchecked_code_unit>)
+        {
+            auto column = std::size_t(pos - line_begin) + 1;
+            return location(LEXY_MOV(reader), eol, line_idx + 1, column);
+        }
+        else if constexpr (std::is_same_v<TokenColumn, lexyd::_cp<void>> //
+                           && std::is_same_v<typename reader_t::encoding, lexy::utf8_encoding>)
+        {
+            auto column
+                = _count_utf8_code_points(reinterpret_cast<const unsigned char*>(line_begin),
+                                          std::size_t(pos - line_begin))
+                  + 1;
+            return location(LEXY_MOV(reader), eol, line_idx + 1, column);
+        }
+        else
+        {
+            auto anchor = location(LEXY_MOV(reader), eol, line_idx + 1, 1);
+            return _finder.find(pos, anchor);
+        }
+    }
+
+    finder                _finder;
+    reader_t              _reader;
+    std::vector<iterator> _line_begins;
+    iterator              _end;
+};
+
 /// Convenience function to find a single location.
 template <typename Input, typename TokenColumn, typename TokenLine>
 constexpr auto find_input_location(const Input&                                 input,
@@ -182,22 +182,141 @@ struct error_writer
 
 namespace lexy_ext::_detail
 {
-template <typename OutputIt, typename Production, typename Input, typename Reader, typename Tag>
-OutputIt write_error(OutputIt out, const lexy::error_context<Production, Input>& context,
-                     const lexy::error<Reader, Tag>& error, lexy::visualization_options opts)
+// The information about an error that is necessary to write it.
+// It doesn't depend on the production or tag, so errors can be stored.
+// The encoding is the one of the expected literals or keywords.
+template <typename Input, typename Encoding = typename lexy::input_reader<Input>::encoding>
+struct error_info
 {
-    _detail::error_writer<Input> writer{opts};
+    using iterator  = typename lexy::input_reader<Input>::iterator;
+    using char_type = typename Encoding::char_type;
 
-    // Convert the context location and error location into line/column information.
-    lexy_ext::input_location_finder finder(context.input());
+    enum kind_t
+    {
+        generic,
+        expected_literal,
+        expected_keyword,
+        expected_char_class,
+    };
+
+    kind_t      kind;
+    const char* production;
+    iterator    context;
+    iterator    position;
+    // The part of the input that is underlined.
+    iterator begin, end;
+    // The expected literal or keyword.
+    const char_type* string;
+    // The message or name of the character class.
+    const char* message;
+
+    template <typename Production, typename Reader, typename Tag>
+    static constexpr error_info make(const lexy::error_context<Production, Input>& context,
+                                     const lexy::error<Reader, Tag>&               error)
+    {
+        error_info result{};
+        result.production = context.production();
+        result.context    = context.position();
+        result.position   = error.position();
+
+        auto underline = [&](lexy::lexeme_for<Input> underlined) {
+            result.begin = underlined.begin();
+            result.end   = underlined.end();
+        };
+        constexpr auto same_encoding = std::is_same_v<typename Reader::encoding, Encoding>;
+        if constexpr (std::is_same_v<Tag, lexy::expected_literal> && same_encoding)
+        {
+            result.kind   = expected_literal;
+            result.string = error.string();
+            underline({error.position(), error.index() + 1});
+        }
+        else if constexpr (std::is_same_v<Tag, lexy::expected_keyword> && same_encoding)
+        {
+            result.kind   = expected_keyword;
+            result.string = error.string();
+            underline({error.begin(), error.end()});
+        }
+        else if constexpr (std::is_same_v<Tag, lexy::expected_literal>)
+        {
+            // We can't store a string of a different encoding.
+            result.kind    = generic;
+            result.message = "expected literal";
+            underline({error.position(), error.index() + 1});
+        }
+        else if constexpr (std::is_same_v<Tag, lexy::expected_keyword>)
+        {
+            result.kind    = generic;
+            result.message = "expected keyword";
+            underline({error.begin(), error.end()});
+        }
+        else if constexpr (std::is_same_v<Tag, lexy::expected_char_class>)
+        {
+            result.kind    = expected_char_class;
+            result.message = error.character_class();
+            underline({error.position(), 1});
+        }
+        else
+        {
+            result.kind    = generic;
+            result.message = error.message();
+            if (error.begin() == error.end())
+                underline({error.position(), 1});
+            else
+                underline({error.begin(), error.end()});
+        }
+
+        return result;
+    }
+};
+
+template <typename OutputIt, typename Input, typename Encoding>
+OutputIt write_error_message(OutputIt out, const error_info<Input, Encoding>& error,
+                             lexy::visualization_options opts)
+{
+    using info = error_info<Input, Encoding>;
+    switch (error.kind)
+    {
+    case info::expected_literal: {
+        auto string = lexy::_detail::make_literal_lexeme<Encoding>(error.string);
+
+        out = lexy::_detail::write_str(out, "expected '");
+        out = lexy::visualize_to(out, string, opts);
+        out = lexy::_detail::write_str(out, "'");
+        break;
+    }
+    case info::expected_keyword: {
+        auto string = lexy::_detail::make_literal_lexeme<Encoding>(error.string);
+
+        out = lexy::_detail::write_str(out, "expected keyword '");
+        out = lexy::visualize_to(out, string, opts);
+        out = lexy::_detail::write_str(out, "'");
+        break;
+    }
+    case info::expected_char_class:
+        out = lexy::_detail::write_str(out, "expected '");
+        out = lexy::_detail::write_str(out, error.message);
+        out = lexy::_detail::write_str(out, "' character");
+        break;
+    case info::generic:
+        out = lexy::_detail::write_str(out, error.message);
+        break;
+    }
+
+    return out;
+}
 
-    auto context_location = finder.find(context.position());
-    auto location         = finder.find(error.position(), context_location);
+// Writes the error, whose context and position have already been converted into locations.
+template <typename OutputIt, typename Input, typename Encoding, typename Location>
+OutputIt write_error(OutputIt out, const error_info<Input, Encoding>& error,
+                     const Location& context_location, const Location& location,
+                     lexy::visualization_options opts)
+{
+    _detail::error_writer<Input> writer{opts};
 
     // Write the main error headline.
     out = writer.write_message(out, [&](OutputIt out, lexy::visualization_options) {
         out = lexy::_detail::write_str(out, "while parsing ");
-        out = lexy::_detail::write_str(out, context.production());
+        out = lexy::_detail::write_str(out, error.production);
         return out;
     });
     out = writer.write_empty_annotation(out);
@@ -206,7 +325,7 @@ OutputIt write_error(OutputIt out, const lexy::error_context<Production, Input>&
     if (location.line_nr() != context_location.line_nr())
     {
         out = writer.write_annotation(out, annotation_kind::secondary, context_location,
-                                      {context.position(), 1},
+                                      {error.context, 1},
                                       [&](OutputIt out, lexy::visualization_options) {
                                           return lexy::_detail::write_str(out, "beginning here");
                                       });
@@ -214,70 +333,49 @@ OutputIt write_error(OutputIt out, const lexy::error_context<Production, Input>&
     }
 
     // Write the main annotation.
-    if constexpr (std::is_same_v<Tag, lexy::expected_literal>)
-    {
-        auto string = lexy::_detail::make_literal_lexeme<typename Reader::encoding>(error.string());
-
-        out = writer.write_annotation(out, annotation_kind::primary, location,
-                                      {error.position(), error.index() + 1},
-                                      [&](OutputIt out, lexy::visualization_options opts) {
-                                          out = lexy::_detail::write_str(out, "expected '");
-                                          out = lexy::visualize_to(out, string, opts);
-                                          out = lexy::_detail::write_str(out, "'");
-                                          return out;
-                                      });
-    }
-    else if constexpr (std::is_same_v<Tag, lexy::expected_keyword>)
-    {
-        auto string = lexy::_detail::make_literal_lexeme<typename Reader::encoding>(error.string());
-
-        out = writer.write_annotation(out, annotation_kind::primary, location,
-                                      {error.begin(), error.end()},
-                                      [&](OutputIt out, lexy::visualization_options opts) {
-                                          out = lexy::_detail::write_str(out, "expected keyword '");
-                                          out = lexy::visualize_to(out, string, opts);
-                                          out = lexy::_detail::write_str(out, "'");
-                                          return out;
-                                      });
-    }
-    else if constexpr (std::is_same_v<Tag, lexy::expected_char_class>)
-    {
-        out = writer.write_annotation(out, annotation_kind::primary, location,
-                                      {error.position(), 1},
-                                      [&](OutputIt out, lexy::visualization_options) {
-                                          out = lexy::_detail::write_str(out, "expected '");
-                                          out = lexy::_detail::write_str(out,
-                                                                         error.character_class());
-                                          out = lexy::_detail::write_str(out, "' character");
-                                          return out;
-                                      });
-    }
-    else
-    {
-        auto underlined = [&] {
-            if (error.begin() == error.end())
-                return lexy::lexeme_for<Input>(error.position(), 1);
-            else
-                return lexy::lexeme_for<Input>(error.begin(), error.end());
-        }();
-
-        out = writer.write_annotation(out, annotation_kind::primary, location, underlined,
-                                      [&](OutputIt out, lexy::visualization_options) {
-                                          return lexy::_detail::write_str(out, error.message());
-                                      });
-    }
+    out = writer.write_annotation(out, annotation_kind::primary, location,
+                                  {error.begin, error.end},
+                                  [&](OutputIt out, lexy::visualization_options opts) {
+                                      return write_error_message(out, error, opts);
+                                  });
 
     return out;
 }
+
+template <typename OutputIt, typename Production, typename Input, typename Reader, typename Tag,
+          typename Locations>
+OutputIt write_error(OutputIt out, const lexy::error_context<Production, Input>& context,
+                     const lexy::error<Reader, Tag>& error, lexy::visualization_options opts,
+                     const Locations& locations)
+{
+    // Convert the context location and error location into line/column information.
+    auto context_location = locations.find(context.position());
+    auto location         = locations.find(error.position(), context_location);
+
+    using info = error_info<Input, typename Reader::encoding>;
+    return write_error(out, info::make(context, error), context_location, location, opts);
+}
+
+template <typename OutputIt, typename Production, typename Input, typename Reader, typename Tag>
+OutputIt write_error(OutputIt out, const lexy::error_context<Production, Input>& context,
+                     const lexy::error<Reader, Tag>& error, lexy::visualization_options opts)
+{
+    return write_error(out, context, error, opts,
+                       lexy_ext::input_location_finder(context.input()));
+}
 } // namespace lexy_ext::_detail
 
 namespace lexy_ext
 {
+template <typename Locations>
 struct _report_error
 {
+    const Locations* _locations;
+
     struct _sink
     {
-        std::size_t _count;
+        const Locations* _locations;
+        std::size_t      _count;
 
         using return_type = std::size_t;
 
@@ -285,8 +383,12 @@ struct _report_error
         void operator()(const lexy::error_context<Production, Input>& context,
                         const lexy::error<Reader, Tag>&               error)
         {
-            _detail::write_error(lexy::cfile_output_iterator{stderr}, context, error,
-                                 {lexy::visualize_fancy});
+            if constexpr (std::is_void_v<Locations>)
+                _detail::write_error(lexy::cfile_output_iterator{stderr}, context, error,
+                                     {lexy::visualize_fancy});
+            else
+                _detail::write_error(lexy::cfile_output_iterator{stderr}, context, error,
+                                     {lexy::visualize_fancy}, *_locations);
             ++_count;
         }
 
@@ -300,12 +402,20 @@ struct _report_error
 
     constexpr auto sink() const
     {
-        return _sink{};
+        return _sink{_locations, 0};
+    }
+
+    /// Uses the precomputed index of the input to compute the locations of errors.
+    /// The index must outlive the callback.
+    template <typename Input, typename TokenColumn>
+    constexpr auto locations(const line_index<Input, TokenColumn>& index) const
+    {
+        return _report_error<line_index<Input, TokenColumn>>{&index};
     }
 };
 
 // The error callback that prints to stderr.
-constexpr auto report_error = _report_error{};
+constexpr auto report_error = _report_error<void>{nullptr};
 } // namespace lexy_ext
 
 #endif // LEXY_EXT_REPORT_ERROR_HPP_INCLUDED
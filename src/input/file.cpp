@@ -3,15 +3,153 @@
 // found in the top-level directory of this distribution.
 
 #include <lexy/input/file.hpp>
+#include <lexy/input/stream_input.hpp>
 
 #include <cerrno>
+#include <cstddef>
 #include <cstdio>
-#include <lexy/_detail/buffer_builder.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace
+{
+// The contents of a stream, read in chunks of increasing size.
+// Unlike a single buffer that grows, existing chunks are never moved;
+// they're copied exactly once into their final memory after everything has been read.
+class stream_chunks
+{
+public:
+    stream_chunks() noexcept = default;
+
+    stream_chunks(const stream_chunks&) = delete;
+    stream_chunks& operator=(const stream_chunks&) = delete;
+
+    ~stream_chunks() noexcept
+    {
+        for (auto cur = _head; cur != nullptr;)
+        {
+            auto next = cur->next;
+            ::operator delete(cur);
+            cur = next;
+        }
+    }
+
+    // Reads everything until EOF using `read(buffer, size, read_size)`.
+    template <typename Read>
+    lexy::file_error read_all(Read read)
+    {
+        while (true)
+        {
+            if (_tail == nullptr || _tail->size == _tail->capacity)
+                append_chunk();
+
+            auto read_size = std::size_t(0);
+            auto ec        = read(_tail->data() + _tail->size, _tail->capacity - _tail->size,
+                           read_size);
+            if (ec != lexy::file_error::_success)
+                return ec;
+            else if (read_size == 0)
+                return lexy::file_error::_success;
+
+            _tail->size += read_size;
+            _size += read_size;
+        }
+    }
+
+    // Passes the contents to the allocate callback or the callback.
+    void finish(lexy::_detail::file_allocate_callback allocate, lexy::_detail::file_callback cb,
+                void* user_data) const
+    {
+        char prefix[4];
+        auto prefix_size = _size < 4 ? _size : 4;
+        copy(prefix, 0, prefix_size);
+
+        auto offset = std::size_t(0);
+        auto memory
+            = allocate ? static_cast<char*>(allocate(user_data, prefix, prefix_size, _size, offset))
+                       : nullptr;
+        if (memory != nullptr)
+        {
+            copy(memory, offset, _size - offset);
+        }
+        else if (_head == _tail)
+        {
+            // Everything is in a single chunk already.
+            cb(user_data, _head->data(), _size);
+        }
+        else
+        {
+            lexy::buffer<>::builder builder(_size);
+            copy(builder.data(), 0, _size);
+            cb(user_data, builder.data(), builder.size());
+        }
+    }
+
+private:
+    static constexpr std::size_t initial_chunk_size = 64 * 1024;
+    static constexpr std::size_t max_chunk_size     = 16 * 1024 * 1024;
+
+    struct chunk
+    {
+        chunk*      next;
+        std::size_t capacity;
+        std::size_t size;
+
+        // The characters are stored directly after the header.
+        char* data() noexcept
+        {
+            return reinterpret_cast<char*>(this + 1);
+        }
+    };
+
+    void append_chunk()
+    {
+        auto capacity = initial_chunk_size;
+        if (_tail != nullptr && 2 * _tail->capacity <= max_chunk_size)
+            capacity = 2 * _tail->capacity;
+        else if (_tail != nullptr)
+            capacity = _tail->capacity;
+
+        auto memory = ::operator new(sizeof(chunk) + capacity);
+        auto result = ::new (memory) chunk{nullptr, capacity, 0};
+        if (_tail == nullptr)
+            _head = result;
+        else
+            _tail->next = result;
+        _tail = result;
+    }
+
+    // Copies `size` characters starting at `pos` into `dest`.
+    void copy(char* dest, std::size_t pos, std::size_t size) const
+    {
+        for (auto cur = _head; size > 0; cur = cur->next)
+        {
+            if (pos >= cur->size)
+            {
+                pos -= cur->size;
+                continue;
+            }
+
+            auto count = cur->size - pos < size ? cur->size - pos : size;
+            std::memcpy(dest, cur->data() + pos, count);
+            dest += count;
+            size -= count;
+            pos = 0;
+        }
+    }
+
+    chunk*      _head = nullptr;
+    chunk*      _tail = nullptr;
+    std::size_t _size = 0;
+};
+} // namespace
 
 #if defined(__unix__) || defined(__APPLE__)
 
 #    include <fcntl.h>
 #    include <sys/mman.h>
+#    include <sys/stat.h>
 #    include <unistd.h>
 
 namespace
@@ -30,6 +168,13 @@ public:
             ::close(_file);
     }
 
+    void reset(int file) noexcept
+    {
+        if (_file >= 0)
+            ::close(_file);
+        _file = file;
+    }
+
     operator int() const noexcept
     {
         return _file;
@@ -57,54 +202,413 @@ lexy::file_error get_file_error() noexcept
     }
 }
 
-constexpr std::size_t small_file_size  = 4 * 1024;
-constexpr std::size_t medium_file_size = 32 * 1024;
+// The size of the buffer on the stack.
+constexpr std::size_t max_small_file_size = 4 * 1024;
+// The size of the aligned buffer used with O_DIRECT.
+constexpr std::size_t direct_chunk_size = 1024 * 1024;
+
+// Reads exactly `size` bytes starting at `offset`, returns whether that was possible.
+// If `use_pread` is false, `offset` must be the current file offset.
+bool read_exactly(int fd, char* buffer, std::size_t size, std::size_t offset, bool use_pread)
+{
+    while (size > 0)
+    {
+        auto result = use_pread ? ::pread(fd, buffer, size, static_cast<::off_t>(offset))
+                                : ::read(fd, buffer, size);
+        if (result > 0)
+        {
+            buffer += result;
+            size -= static_cast<std::size_t>(result);
+            offset += static_cast<std::size_t>(result);
+        }
+        else if (result == 0 || errno != EINTR)
+            // The file has shrunk or we've got an error.
+            return false;
+    }
+    return true;
+}
+
+// Reads `size` bytes of the file starting at the offset `start`.
+lexy::file_error read_file_syscalls(int fd, std::size_t start, std::size_t size,
+                                    std::size_t small_file_size, bool use_pread,
+                                    lexy::_detail::file_allocate_callback allocate,
+                                    lexy::_detail::file_callback cb, void* user_data)
+{
+    if (!use_pread
+        && ::lseek(fd, static_cast<::off_t>(start), SEEK_SET) != static_cast<::off_t>(start))
+        return lexy::file_error::os_error;
+
+    // We read the beginning of the file into the stack first;
+    // for small files, that's the entire file.
+    // We need at least the first four bytes to detect the BOM.
+    // It is aligned, so the callback can read code units from it.
+    alignas(std::max_align_t) char buffer[max_small_file_size]; // Don't initialize.
+    auto buffer_size
+        = small_file_size < max_small_file_size ? small_file_size : max_small_file_size;
+    if (buffer_size < 4)
+        buffer_size = 4;
+    if (buffer_size > size)
+        buffer_size = size;
+    if (!read_exactly(fd, buffer, buffer_size, start, use_pread))
+        return lexy::file_error::os_error;
+
+    auto offset = std::size_t(0);
+    auto memory = allocate ? static_cast<char*>(allocate(user_data, buffer,
+                                                         buffer_size < 4 ? buffer_size : 4, size,
+                                                         offset))
+                           : nullptr;
+    if (memory != nullptr)
+    {
+        // We can read the rest of the file into its final memory directly,
+        // skipping the offset, which is part of the buffer.
+        std::memcpy(memory, buffer + offset, buffer_size - offset);
+        if (!read_exactly(fd, memory + buffer_size - offset, size - buffer_size,
+                          start + buffer_size, use_pread))
+            return lexy::file_error::os_error;
+    }
+    else if (buffer_size == size)
+    {
+        cb(user_data, buffer, size);
+    }
+    else
+    {
+        lexy::buffer<>::builder builder(size);
+        std::memcpy(builder.data(), buffer, buffer_size);
+        if (!read_exactly(fd, builder.data() + buffer_size, size - buffer_size,
+                          start + buffer_size, use_pread))
+            return lexy::file_error::os_error;
+
+        cb(user_data, builder.data(), builder.size());
+    }
+
+    return lexy::file_error::_success;
+}
+
+// Maps `size` bytes of the file starting at the offset `start`.
+lexy::file_error read_file_mmap(int fd, std::size_t start, std::size_t size,
+                                lexy::_detail::file_allocate_callback allocate,
+                                lexy::_detail::file_callback cb, void* user_data)
+{
+    // The mapping has to start at a page boundary.
+    auto page_size      = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto mapping_offset = start / page_size * page_size;
+    auto mapping_size   = start - mapping_offset + size;
+
+    auto flags = MAP_PRIVATE;
+#    ifdef MAP_POPULATE
+    // We're going to copy everything, so we can fault in all pages at once.
+    flags |= MAP_POPULATE;
+#    endif
+
+    auto mapping
+        = ::mmap(nullptr, mapping_size, PROT_READ, flags, fd, static_cast<::off_t>(mapping_offset));
+    if (mapping == MAP_FAILED) // NOLINT: int-to-ptr conversion happens in header
+        return lexy::file_error::os_error;
+#    ifdef MADV_SEQUENTIAL
+    ::madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+#    endif
+
+    auto contents = static_cast<const char*>(mapping) + (start - mapping_offset);
+    auto offset   = std::size_t(0);
+    auto memory
+        = allocate
+              ? static_cast<char*>(allocate(user_data, contents, size < 4 ? size : 4, size, offset))
+              : nullptr;
+    if (memory != nullptr)
+        std::memcpy(memory, contents + offset, size - offset);
+    else
+        cb(user_data, contents, size);
+
+    ::munmap(mapping, mapping_size);
+    return lexy::file_error::_success;
+}
+
+lexy::file_error read_file_direct(int fd, std::size_t size, std::size_t small_file_size,
+                                  lexy::_detail::file_allocate_callback allocate,
+                                  lexy::_detail::file_callback cb, void* user_data)
+{
+    // O_DIRECT requires memory, offsets, and sizes aligned to the block size of the file system,
+    // which is never bigger than a page.
+    auto alignment = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto capacity  = (size + alignment - 1) / alignment * alignment;
+    if (capacity > direct_chunk_size)
+        capacity = direct_chunk_size;
+
+    void* chunk_memory = nullptr;
+    if (::posix_memalign(&chunk_memory, alignment, capacity) != 0)
+        return lexy::file_error::os_error;
+    auto chunk = static_cast<char*>(chunk_memory);
+
+    auto result = lexy::file_error::_success;
+    // The memory we copy the chunks to; if the callback needs to be invoked, it's a temporary.
+    char*          memory = nullptr;
+    auto           offset = std::size_t(0);
+    lexy::buffer<> fallback;
+#    ifdef O_DIRECT
+    auto direct = true;
+#    endif
+    for (auto pos = std::size_t(0); pos < size;)
+    {
+#    ifdef O_DIRECT
+        if (direct && pos % alignment != 0)
+        {
+            // A short read has left us at an unaligned offset, which O_DIRECT can't read from.
+            // We read the rest of the file normally instead.
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_DIRECT);
+            direct = false;
+        }
+#    endif
+
+        auto read = ::pread(fd, chunk, capacity, static_cast<::off_t>(pos));
+        if (read < 0 && errno == EINTR)
+            continue;
+        else if (read < 0 && errno == EINVAL && pos == 0)
+        {
+            // The file system doesn't support O_DIRECT after all, so read normally.
+#    ifdef O_DIRECT
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_DIRECT);
+#    endif
+            std::free(chunk);
+            return read_file_syscalls(fd, 0, size, small_file_size, true, allocate, cb, user_data);
+        }
+        else if (read <= 0)
+        {
+            result = lexy::file_error::os_error;
+            break;
+        }
+
+        auto chunk_size = static_cast<std::size_t>(read);
+        if (chunk_size > size - pos)
+            // The file has grown, ignore the additional bytes.
+            chunk_size = size - pos;
+
+        if (pos == 0)
+        {
+            memory = allocate ? static_cast<char*>(allocate(user_data, chunk,
+                                                            chunk_size < 4 ? chunk_size : 4, size,
+                                                            offset))
+                              : nullptr;
+            if (memory == nullptr)
+            {
+                offset = 0;
+
+                lexy::buffer<>::builder builder(size);
+                memory   = builder.data();
+                fallback = LEXY_MOV(builder).finish();
+            }
+
+            std::memcpy(memory, chunk + offset, chunk_size - offset);
+        }
+        else
+        {
+            std::memcpy(memory + pos - offset, chunk, chunk_size);
+        }
+
+        pos += chunk_size;
+    }
+    std::free(chunk);
+
+    if (result == lexy::file_error::_success && size == 0)
+        // We haven't read anything, so we have to pass the empty file on.
+        return read_file_syscalls(fd, 0, size, small_file_size, true, allocate, cb, user_data);
+    else if (result == lexy::file_error::_success && fallback.data() != nullptr)
+        cb(user_data, fallback.data(), fallback.size());
+    return result;
+}
 } // namespace
 
 lexy::file_error lexy::_detail::read_file(const char* path, file_callback cb, void* user_data)
 {
-    raii_fd fd(::open(path, O_RDONLY));
+    return read_file(path, read_file_options{}, nullptr, cb, user_data);
+}
+
+lexy::file_error lexy::_detail::read_file(const char* path, const read_file_options& options,
+                                          file_allocate_callback allocate, file_callback cb,
+                                          void* user_data)
+{
+    auto strategy = options.strategy;
+
+    auto open_flags = O_RDONLY;
+#    ifdef O_DIRECT
+    if (strategy == read_file_strategy::direct)
+        open_flags |= O_DIRECT;
+#    endif
+
+    raii_fd fd(::open(path, open_flags));
+#    ifdef O_DIRECT
+    if (fd < 0 && errno == EINVAL && strategy == read_file_strategy::direct)
+    {
+        // The file system doesn't support O_DIRECT, so read normally.
+        strategy = read_file_strategy::pread;
+        fd.reset(::open(path, O_RDONLY));
+    }
+#    endif
     if (fd < 0)
         return get_file_error();
+#    ifdef F_NOCACHE
+    if (strategy == read_file_strategy::direct)
+        ::fcntl(fd, F_NOCACHE, 1);
+#    endif
 
     auto off = ::lseek(fd, 0, SEEK_END);
     if (off == static_cast<::off_t>(-1))
         return lexy::file_error::os_error;
     auto size = static_cast<std::size_t>(off);
 
-    if (size <= small_file_size)
+    if (strategy == read_file_strategy::automatic)
+        strategy = size <= options.medium_file_size ? read_file_strategy::read
+                                                    : read_file_strategy::mmap;
+
+    switch (strategy)
     {
-        if (::lseek(fd, 0, SEEK_SET) != 0)
-            return lexy::file_error::os_error;
+    case read_file_strategy::read:
+    case read_file_strategy::pread:
+        return read_file_syscalls(fd, 0, size, options.small_file_size,
+                                  strategy == read_file_strategy::pread, allocate, cb, user_data);
+
+    case read_file_strategy::mmap:
+        if (size == 0)
+            // We can't map an empty file.
+            return read_file_syscalls(fd, 0, size, options.small_file_size, false, allocate, cb,
+                                      user_data);
+        return read_file_mmap(fd, 0, size, allocate, cb, user_data);
+
+    case read_file_strategy::direct:
+        return read_file_direct(fd, size, options.small_file_size, allocate, cb, user_data);
+
+    case read_file_strategy::automatic:
+        break;
+    }
 
-        char buffer[small_file_size]; // Don't initialize.
-        if (::read(fd, buffer, size) != static_cast<::ssize_t>(size))
-            return lexy::file_error::os_error;
+    LEXY_ASSERT(false, "unreachable");
+    return lexy::file_error::os_error;
+}
 
-        cb(user_data, buffer, size);
-    }
-    else if (size <= medium_file_size)
-    {
-        if (::lseek(fd, 0, SEEK_SET) != 0)
-            return lexy::file_error::os_error;
+lexy::file_error lexy::_detail::map_file(const char* path, const void* sentinel,
+                                         std::size_t sentinel_size, file_mapping& mapping)
+{
+    raii_fd fd(::open(path, O_RDONLY));
+    if (fd < 0)
+        return get_file_error();
 
-        lexy::buffer<>::builder builder(size);
-        if (::read(fd, builder.data(), builder.size()) != static_cast<::ssize_t>(size))
+    auto off = ::lseek(fd, 0, SEEK_END);
+    if (off == static_cast<::off_t>(-1))
+        return lexy::file_error::os_error;
+    auto size = static_cast<std::size_t>(off);
+    if (sentinel_size > 0)
+        // A trailing partial code unit is overwritten by the sentinel.
+        size -= size % sentinel_size;
+
+    // We need memory for the file followed by the sentinel, rounded up to full pages.
+    auto page_size    = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto mapping_size = (size + sentinel_size + page_size - 1) / page_size * page_size;
+    if (mapping_size == 0)
+        mapping_size = page_size;
+
+    // Reserve the entire memory using zero-initialized pages.
+    auto memory
+        = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) // NOLINT: int-to-ptr conversion happens in header
+        return lexy::file_error::os_error;
+
+    if (size > 0)
+    {
+        // Map the file over the beginning of the reserved memory.
+        // The remainder of its last page is zero-filled by the kernel,
+        // the pages after it are still the anonymous ones.
+        auto file_memory
+            = ::mmap(memory, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+        if (file_memory == MAP_FAILED) // NOLINT: int-to-ptr conversion happens in header
+        {
+            ::munmap(memory, mapping_size);
             return lexy::file_error::os_error;
+        }
 
-        cb(user_data, builder.data(), builder.size());
+        // The input is (usually) parsed from front to back, so tell the kernel to read ahead.
+#    ifdef MADV_SEQUENTIAL
+        ::madvise(memory, size, MADV_SEQUENTIAL);
+#    endif
+#    ifdef MADV_WILLNEED
+        ::madvise(memory, size, MADV_WILLNEED);
+#    endif
     }
-    else
+
+    // Write the sentinel after the file.
+    // As the mapping is private, this only copies the page it is written to.
+    if (sentinel_size > 0)
+        std::memcpy(static_cast<unsigned char*>(memory) + size, sentinel, sentinel_size);
+    // If this fails, the mapping just stays writable.
+    (void)::mprotect(memory, mapping_size, PROT_READ);
+
+    mapping = {memory, size, mapping_size};
+    return lexy::file_error::_success;
+}
+
+void lexy::_detail::unmap_file(const file_mapping& mapping) noexcept
+{
+    ::munmap(const_cast<void*>(mapping.memory), mapping._mapping_size);
+}
+
+lexy::file_error lexy::_detail::read_fd(int fd, void* buffer, std::size_t size, std::size_t& read)
+{
+    while (true)
     {
-        auto memory = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
-        if (memory == MAP_FAILED) // NOLINT: int-to-ptr conversion happens in header
+        auto result = ::read(fd, buffer, size);
+        if (result >= 0)
+        {
+            read = static_cast<std::size_t>(result);
+            return lexy::file_error::_success;
+        }
+        else if (errno != EINTR)
             return lexy::file_error::os_error;
+    }
+}
 
-        cb(user_data, reinterpret_cast<const char*>(memory), size);
+lexy::file_error lexy::_detail::read_stdin(file_allocate_callback allocate, file_callback cb,
+                                           void* user_data)
+{
+    struct ::stat info;
+    if (::fstat(STDIN_FILENO, &info) != 0)
+        return lexy::file_error::os_error;
 
-        ::munmap(memory, size);
+    if (S_ISREG(info.st_mode))
+    {
+        // stdin has been redirected from a file, so we can read the rest of it like a file.
+        auto start = ::lseek(STDIN_FILENO, 0, SEEK_CUR);
+        if (start != static_cast<::off_t>(-1) && start <= info.st_size)
+        {
+            auto offset = static_cast<std::size_t>(start);
+            auto size   = static_cast<std::size_t>(info.st_size - start);
+
+            constexpr auto options = read_file_options{};
+            auto           result  = size <= options.medium_file_size
+                                         ? read_file_syscalls(STDIN_FILENO, offset, size,
+                                                              options.small_file_size, true,
+                                                              allocate, cb, user_data)
+                                         : read_file_mmap(STDIN_FILENO, offset, size, allocate,
+                                                          cb, user_data);
+
+            // Like reading it, we have consumed all of stdin.
+            ::lseek(STDIN_FILENO, static_cast<::off_t>(offset + size), SEEK_SET);
+            return result;
+        }
     }
 
+#    ifdef F_SETPIPE_SZ
+    if (S_ISFIFO(info.st_mode))
+        // A bigger pipe means fewer context switches between the writer and us.
+        // If we can't get it, it doesn't matter.
+        ::fcntl(STDIN_FILENO, F_SETPIPE_SZ, 1024 * 1024);
+#    endif
+
+    stream_chunks chunks;
+    auto          ec = chunks.read_all([](char* buffer, std::size_t size, std::size_t& read) {
+        return lexy::_detail::read_fd(STDIN_FILENO, buffer, size, read);
+    });
+    if (ec != lexy::file_error::_success)
+        return ec;
+
+    chunks.finish(allocate, cb, user_data);
     return lexy::file_error::_success;
 }
 
@@ -155,6 +659,14 @@ lexy::file_error get_file_error() noexcept
 } // namespace
 
 lexy::file_error lexy::_detail::read_file(const char* path, file_callback cb, void* user_data)
+{
+    return read_file(path, read_file_options{}, nullptr, cb, user_data);
+}
+
+// We only have C I/O, so all strategies are the same.
+lexy::file_error lexy::_detail::read_file(const char* path, const read_file_options&,
+                                          file_allocate_callback allocate, file_callback cb,
+                                          void* user_data)
 {
     // Open file.
     raii_file file(std::fopen(path, "rb"));
@@ -165,64 +677,123 @@ lexy::file_error lexy::_detail::read_file(const char* path, file_callback cb, vo
     if (std::fseek(file, 0, SEEK_END) != 0)
         return lexy::file_error::os_error;
 
-    auto size = std::ftell(file);
-    if (size == -1)
+    auto ssize = std::ftell(file);
+    if (ssize == -1)
         return lexy::file_error::os_error;
 
     if (std::fseek(file, 0, SEEK_SET) != 0)
         return lexy::file_error::os_error;
 
-    // Now read the entire file into a  buffer.
-    lexy::buffer<>::builder builder{std::size_t(size)};
-    if (std::fread(builder.data(), sizeof(char), builder.size(), file) != builder.size())
+    // Read the beginning of the file to decide where it goes.
+    auto size        = std::size_t(ssize);
+    char prefix[4]   = {};
+    auto prefix_size = std::fread(prefix, sizeof(char), size < 4 ? size : 4, file);
+    if (prefix_size != (size < 4 ? size : 4))
         return lexy::file_error::os_error;
-    LEXY_ASSERT(std::fgetc(file) == EOF, "we haven't read everything?!");
 
-    // Pass to callback.
-    // Note that this isn't ideal, as we're having one unnecessary copy plus allocation.
-    cb(user_data, builder.data(), builder.size());
+    auto offset = std::size_t(0);
+    auto memory = allocate
+                      ? static_cast<char*>(allocate(user_data, prefix, prefix_size, size, offset))
+                      : nullptr;
+    if (memory != nullptr)
+    {
+        // Read the rest of the file into its final memory directly.
+        std::memcpy(memory, prefix + offset, prefix_size - offset);
+
+        auto rest = size - prefix_size;
+        if (std::fread(memory + prefix_size - offset, sizeof(char), rest, file) != rest)
+            return lexy::file_error::os_error;
+    }
+    else
+    {
+        // Read the entire file into a buffer.
+        lexy::buffer<>::builder builder{size};
+        std::memcpy(builder.data(), prefix, prefix_size);
+
+        auto rest = size - prefix_size;
+        if (std::fread(builder.data() + prefix_size, sizeof(char), rest, file) != rest)
+            return lexy::file_error::os_error;
+
+        // Pass to callback.
+        // Note that this isn't ideal, as we're having one unnecessary copy plus allocation.
+        cb(user_data, builder.data(), builder.size());
+    }
+
+    LEXY_ASSERT(std::fgetc(file) == EOF, "we haven't read everything?!");
     return file_error::_success;
 }
 
-#endif
-
-// When reading from stdin, performance doesn't really matter.
-// As such, we use the simple portable way of the C I/O routines.
-lexy::file_error lexy::_detail::read_stdin(file_callback cb, void* user_data)
+// We can't map the file, so we have to read it into memory instead.
+lexy::file_error lexy::_detail::map_file(const char* path, const void* sentinel,
+                                         std::size_t sentinel_size, file_mapping& mapping)
 {
-    // We can't use ftell() to get file size
-    // So instead use a conservative loop.
-    lexy::_detail::buffer_builder<char> builder;
-    while (true)
-    {
-        const auto buffer_size = builder.write_size();
-        LEXY_ASSERT(buffer_size > 0, "buffer empty?!");
+    raii_file file(std::fopen(path, "rb"));
+    if (!file)
+        return get_file_error();
+
+    if (std::fseek(file, 0, SEEK_END) != 0)
+        return lexy::file_error::os_error;
 
-        // Read into the entire write area of the buffer from stdin,
-        // commiting what we've just read.
-        const auto read = std::fread(builder.write_data(), sizeof(char), buffer_size, stdin);
-        builder.commit(read);
+    auto ssize = std::ftell(file);
+    if (ssize == -1)
+        return lexy::file_error::os_error;
 
-        // Check whether we have exhausted the file.
-        if (read < buffer_size)
-        {
-            if (std::ferror(stdin) != 0)
-                // We have a read error.
-                return lexy::file_error::os_error;
+    if (std::fseek(file, 0, SEEK_SET) != 0)
+        return lexy::file_error::os_error;
 
-            // We should have reached the end.
-            LEXY_ASSERT(std::feof(stdin), "why did fread() not read enough?");
-            break;
-        }
+    auto size = std::size_t(ssize);
+    if (sentinel_size > 0)
+        // A trailing partial code unit is overwritten by the sentinel.
+        size -= size % sentinel_size;
 
-        // We've filled the entire buffer and need more space.
-        // This grow might be unnecessary if we're just so happen to reach EOF with the next
-        // input, but checking this requires reading more input.
-        builder.grow();
+    // Allocate at least one byte, so the memory is never null.
+    auto mapping_size = size + sentinel_size > 0 ? size + sentinel_size : 1;
+    auto memory       = static_cast<unsigned char*>(::operator new(mapping_size));
+    if (std::fread(memory, sizeof(char), size, file) != size)
+    {
+        ::operator delete(memory);
+        return lexy::file_error::os_error;
     }
+    if (sentinel_size > 0)
+        std::memcpy(memory + size, sentinel, sentinel_size);
+
+    mapping = {memory, size, mapping_size};
+    return lexy::file_error::_success;
+}
+
+void lexy::_detail::unmap_file(const file_mapping& mapping) noexcept
+{
+    ::operator delete(const_cast<void*>(mapping.memory));
+}
 
-    // Pass final buffer to callback.
-    cb(user_data, builder.read_data(), builder.read_size());
+// We don't know how to read from a file descriptor.
+lexy::file_error lexy::_detail::read_fd(int, void*, std::size_t, std::size_t& read)
+{
+    read = 0;
+    return lexy::file_error::os_error;
+}
+
+// We can't get the size of stdin, so we read it in chunks.
+lexy::file_error lexy::_detail::read_stdin(file_allocate_callback allocate, file_callback cb,
+                                           void* user_data)
+{
+    stream_chunks chunks;
+    auto          ec = chunks.read_all([](char* buffer, std::size_t size, std::size_t& read) {
+        read = std::fread(buffer, sizeof(char), size, stdin);
+        if (read < size && std::ferror(stdin) != 0)
+            return lexy::file_error::os_error;
+        return lexy::file_error::_success;
+    });
+    if (ec != lexy::file_error::_success)
+        return ec;
+
+    chunks.finish(allocate, cb, user_data);
     return file_error::_success;
 }
 
+#endif
+
+lexy::file_error lexy::_detail::read_stdin(file_callback cb, void* user_data)
+{
+    return read_stdin(nullptr, cb, user_data);
+}
@@ -494,5 +494,19 @@ TEST_CASE("trace")
  1: 17: - finish
 )");
     }
+    SUBCASE("line index")
+    {
+        auto input = lexy::zstring_input("Hello\n[123,\r\n  abc]");
+        auto index = lexy_ext::line_index(input);
+
+        std::string with_index;
+        lexy::trace_to<production>(std::back_insert_iterator(with_index), input, index);
+
+        std::string without_index;
+        lexy::trace_to<production>(std::back_insert_iterator(without_index), input);
+
+        CHECK(with_index == without_index);
+        CHECK(with_index.find(" 3:  3:") != std::string::npos);
+    }
 }
 
@@ -0,0 +1,22 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <lexy/callback/real.hpp>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("as_real")
+{
+    double no_sign = lexy::as_real<double>(2.5);
+    CHECK(no_sign == 2.5);
+
+    double minus_sign = lexy::as_real<double>(lexy::minus_sign{}, 2.5);
+    CHECK(minus_sign == -2.5);
+
+    double plus_sign = lexy::as_real<double>(lexy::plus_sign{}, 2.5);
+    CHECK(plus_sign == 2.5);
+
+    float narrowing = lexy::as_real<float>(lexy::minus_sign{}, 0.5);
+    CHECK(narrowing == -0.5f);
+}
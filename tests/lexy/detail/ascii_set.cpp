@@ -0,0 +1,98 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <lexy/_detail/ascii_set.hpp>
+
+#include <doctest/doctest.h>
+#include <string>
+
+namespace
+{
+constexpr auto digits = lexy::_detail::ascii_set().insert('0', '9');
+
+// Has more ranges than the SSE2 kernel checks.
+constexpr auto vowels = lexy::_detail::ascii_set()
+                            .insert('a')
+                            .insert('e')
+                            .insert('i')
+                            .insert('o')
+                            .insert('u')
+                            .insert('y');
+
+template <const lexy::_detail::ascii_set& Set, typename CharT>
+std::size_t span(const std::basic_string<CharT>& str)
+{
+    return lexy::_detail::ascii_set_span<Set>(str.data(), str.size());
+}
+} // namespace
+
+TEST_CASE("ascii_set")
+{
+    CHECK(digits.is_ascii());
+    CHECK(digits.contains('0'));
+    CHECK(digits.contains('9'));
+    CHECK(!digits.contains('a'));
+    CHECK(!digits.contains(0x80 | '0'));
+
+    CHECK(digits.ranges().count == 1);
+    CHECK(digits.ranges().min[0] == '0');
+    CHECK(digits.ranges().max[0] == '9');
+    CHECK(vowels.ranges().count == 6);
+
+    auto non_ascii = lexy::_detail::ascii_set().insert(0x70, 0x80);
+    CHECK(!non_ascii.is_ascii());
+}
+
+TEST_CASE("ascii_set_span")
+{
+    // Test every run length, so we cover the vector loops and the tail.
+    for (auto length = 0u; length != 80; ++length)
+    {
+        INFO(length);
+
+        auto str = std::string(length, '7');
+        CHECK(span<digits>(str) == length);
+        CHECK(span<digits>(str + "a") == length);
+        CHECK(span<digits>(str + "a123") == length);
+        CHECK(span<digits>(str + "\xB0" + "123") == length);
+
+        auto vowel_str = std::string(length, 'e');
+        for (auto i = 0u; i < length; i += 3)
+            vowel_str[i] = "aiouy"[i % 5];
+        CHECK(span<vowels>(vowel_str + "b") == length);
+        CHECK(span<vowels>(vowel_str + "\xE5") == length);
+
+        auto wide_str = std::u16string(length, u'7');
+        CHECK(span<digits>(wide_str + u"\x0130") == length);
+    }
+
+    CHECK(span<digits>(std::string()) == 0);
+    CHECK(span<digits>(std::string("a")) == 0);
+}
+
+TEST_CASE("ascii_set_find")
+{
+    constexpr static auto star = lexy::_detail::ascii_set().insert('*');
+
+    for (auto length = 0u; length != 80; ++length)
+    {
+        INFO(length);
+
+        auto str = std::string(length, 'a');
+        CHECK(lexy::_detail::ascii_set_find<digits>(str.data(), str.size()) == length);
+        CHECK(lexy::_detail::ascii_set_find<digits>((str + "\xB0" + "1").data(), length + 2)
+              == length + 1);
+        CHECK(lexy::_detail::ascii_set_find<vowels>((std::string(length, 'b') + "u").data(),
+                                                    length + 1)
+              == length);
+
+        auto stars = str + "*/";
+        CHECK(lexy::_detail::ascii_set_find<star>(stars.data(), stars.size()) == length);
+
+        auto wide_str = std::u16string(length, u'\x0130') + u"5";
+        CHECK(lexy::_detail::ascii_set_find<digits>(wide_str.data(), wide_str.size()) == length);
+    }
+
+    CHECK(lexy::_detail::ascii_set_find<star>(static_cast<const char*>(nullptr), 0) == 0);
+}
@@ -0,0 +1,89 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <lexy/_detail/perfect_hash.hpp>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("_detail::hash_string")
+{
+    auto hash = [](const char* str) {
+        return lexy::_detail::hash_string(str, lexy::_detail::string_view(str).size());
+    };
+
+    // Different lengths take different paths.
+    for (auto str : {"", "a", "ab", "abc", "abcd", "abcdefg", "abcdefgh", "abcdefghijklmnopq"})
+    {
+        auto view = lexy::_detail::string_view(str);
+        CHECK(hash(str) == hash(str));
+
+        // It depends on every character.
+        for (auto i = std::size_t(0); i != view.size(); ++i)
+        {
+            char copy[32] = {};
+            for (auto j = std::size_t(0); j != view.size(); ++j)
+                copy[j] = str[j];
+            copy[i] = 'x';
+            CHECK(hash(copy) != hash(str));
+        }
+    }
+
+    CHECK(lexy::_detail::hash_string("abc", 3) != lexy::_detail::hash_string("abc\0", 4));
+
+    constexpr auto constant = lexy::_detail::hash_string("abcdefghijk", 11);
+    CHECK(constant == hash("abcdefghijk"));
+
+    constexpr auto wide = lexy::_detail::hash_string(u"abc", 3);
+    CHECK(wide == lexy::_detail::hash_string(u"abc", 3));
+    CHECK(wide != lexy::_detail::hash_string(u"abd", 3));
+}
+
+namespace
+{
+using lexy::_detail::string_view;
+
+constexpr string_view keywords[]
+    = {"if",     "else",   "while", "for", "do",     "return",    "break", "continue", "switch",
+       "case",   "default", "goto", "int", "char",   "unsigned", "signed", "const",   "volatile",
+       "static", "extern", "a",     "",    "struct", "enumerator_with_a_long_name"};
+constexpr auto keyword_count = sizeof(keywords) / sizeof(keywords[0]);
+} // namespace
+
+TEST_CASE("_detail::perfect_hash")
+{
+    constexpr auto table = lexy::_detail::make_perfect_hash<char, keyword_count>(keywords);
+    CHECK(table._valid);
+
+    auto lookup = [&](const char* str) {
+        return table.lookup(str, lexy::_detail::string_view(str).size());
+    };
+
+    for (auto idx = std::size_t(0); idx != keyword_count; ++idx)
+        CHECK(table.lookup(keywords[idx].data(), keywords[idx].size()) == idx);
+
+    CHECK(lookup("iff") == table.invalid_value);
+    CHECK(lookup("i") == table.invalid_value);
+    CHECK(lookup("ELSE") == table.invalid_value);
+    CHECK(lookup("enumerator_with_a_long_nam") == table.invalid_value);
+    CHECK(lookup("enumerator_with_a_long_namee") == table.invalid_value);
+    CHECK(lookup("enumerator_with_a_long_nbme") == table.invalid_value);
+    CHECK(lookup("this_is_longer_than_all_keywords") == table.invalid_value);
+
+    constexpr auto constant = table.lookup("while", 5);
+    CHECK(constant == 2);
+
+    SUBCASE("empty")
+    {
+        constexpr auto empty = lexy::_detail::make_perfect_hash<char, 0>(keywords);
+        CHECK(empty._valid);
+        CHECK(empty.lookup("", 0) == empty.invalid_value);
+        CHECK(empty.lookup("a", 1) == empty.invalid_value);
+    }
+    SUBCASE("duplicate")
+    {
+        constexpr string_view duplicates[] = {"abc", "def", "abc"};
+        constexpr auto duplicate = lexy::_detail::make_perfect_hash<char, 3>(duplicates);
+        CHECK(!duplicate._valid);
+    }
+}
@@ -0,0 +1,101 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <lexy/_detail/real_conversion.hpp>
+
+#include <doctest/doctest.h>
+#include <limits>
+#include <string>
+
+namespace
+{
+template <typename T>
+constexpr T parse(const char* str)
+{
+    auto end = str;
+    while (*end)
+        ++end;
+    return lexy::_detail::parse_real<T>(str, end);
+}
+
+// Parses the number at compile-time, at runtime, and with a non-pointer iterator.
+#define CHECK_REAL(T, Literal)                                                                     \
+    do                                                                                             \
+    {                                                                                              \
+        constexpr auto compile_time = parse<T>(#Literal);                                          \
+        CHECK(compile_time == Literal);                                                            \
+                                                                                                   \
+        auto runtime = parse<T>(#Literal);                                                         \
+        CHECK(runtime == Literal);                                                                 \
+                                                                                                   \
+        std::string str = #Literal;                                                                \
+        auto        iterator = lexy::_detail::parse_real<T>(str.begin(), str.end());               \
+        CHECK(iterator == Literal);                                                                \
+    } while (false)
+} // namespace
+
+TEST_CASE("_detail::parse_real")
+{
+    SUBCASE("double")
+    {
+        CHECK_REAL(double, 0.);
+        CHECK_REAL(double, 0.0);
+        CHECK_REAL(double, 000.000e10);
+        CHECK_REAL(double, 1.);
+        CHECK_REAL(double, 1.5);
+        CHECK_REAL(double, 0.1);
+        CHECK_REAL(double, 1e23);
+        CHECK_REAL(double, 3.14159265358979323846264338327950288);
+        CHECK_REAL(double, 123456789012345678901234567890.);
+        CHECK_REAL(double, 9007199254740993.);
+        CHECK_REAL(double, 9007199254740992.5);
+        CHECK_REAL(double, 9007199254740993.0000000000000000000000001);
+        CHECK_REAL(double, 1.00000000000000011102230246251565404236316680908203125);
+        CHECK_REAL(double, 1.00000000000000011102230246251565404236316680908203124);
+        CHECK_REAL(double, 1.00000000000000011102230246251565404236316680908203126);
+
+        // Largest and smallest normal numbers.
+        CHECK_REAL(double, 1.7976931348623157e308);
+        CHECK_REAL(double, 2.2250738585072014e-308);
+        CHECK_REAL(double, 2.2250738585072011e-308);
+        // Subnormal numbers.
+        CHECK_REAL(double, 4.9406564584124654e-324);
+        CHECK_REAL(double, 2.4703282292062328e-324);
+        CHECK_REAL(double, 1.23456789e-310);
+
+        // Rounds to zero.
+        CHECK(parse<double>("2.4703282292062327e-324") == 0);
+        CHECK(parse<double>("1e-400") == 0);
+        CHECK(parse<double>("0.0000001e-99999999999999999") == 0);
+        // Rounds to infinity.
+        CHECK(parse<double>("1.7976931348623159e308") == std::numeric_limits<double>::infinity());
+        CHECK(parse<double>("1e400") == std::numeric_limits<double>::infinity());
+        CHECK(parse<double>("123e99999999999999999") == std::numeric_limits<double>::infinity());
+        constexpr auto compile_time_infinity = parse<double>("1e400");
+        CHECK(compile_time_infinity == std::numeric_limits<double>::infinity());
+    }
+    SUBCASE("float")
+    {
+        CHECK_REAL(float, 0.f);
+        CHECK_REAL(float, 1.5f);
+        CHECK_REAL(float, 0.1f);
+        CHECK_REAL(float, 16777217.f);
+        CHECK_REAL(float, 3.14159265358979323846264338327950288f);
+        CHECK_REAL(float, 7.038531e-26f);
+        CHECK_REAL(float, 3.4028234e38f);
+        CHECK_REAL(float, 1.17549435e-38f);
+        CHECK_REAL(float, 1.4e-45f);
+
+        CHECK(parse<float>("7e-46") == 0);
+        CHECK(parse<float>("3.4028236e38") == std::numeric_limits<float>::infinity());
+    }
+    SUBCASE("syntax")
+    {
+        // Parsing stops at the first character that can't continue the number.
+        CHECK(parse<double>("1.5x") == 1.5);
+        CHECK(parse<double>("1.5e2,") == 150);
+        CHECK(parse<double>("12345678.12345678 ") == 12345678.12345678);
+        CHECK(parse<double>("1.5e-2]") == 0.015);
+    }
+}
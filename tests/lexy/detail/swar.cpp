@@ -0,0 +1,40 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <lexy/_detail/swar.hpp>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("_detail::swar_load")
+{
+    constexpr auto value = lexy::_detail::swar_load("\x01\x02\x03\x04\x05\x06\x07\x08");
+    CHECK(value == 0x0807'0605'0403'0201);
+}
+
+TEST_CASE("_detail::swar_parse_8digits")
+{
+    SUBCASE("base 10")
+    {
+        constexpr auto value = lexy::_detail::swar_parse_8digits<10>("12345678");
+        CHECK(value == 12345678);
+
+        CHECK(lexy::_detail::swar_parse_8digits<10>("00000000") == 0);
+        CHECK(lexy::_detail::swar_parse_8digits<10>("00000001") == 1);
+        CHECK(lexy::_detail::swar_parse_8digits<10>("10000000") == 10000000);
+        CHECK(lexy::_detail::swar_parse_8digits<10>("99999999") == 99999999);
+        CHECK(lexy::_detail::swar_parse_8digits<10>("09080706") == 9080706);
+    }
+    SUBCASE("base 16")
+    {
+        constexpr auto value = lexy::_detail::swar_parse_8digits<16>("1234abcd");
+        CHECK(value == 0x1234ABCD);
+
+        CHECK(lexy::_detail::swar_parse_8digits<16>("00000000") == 0);
+        CHECK(lexy::_detail::swar_parse_8digits<16>("0000000f") == 0xF);
+        CHECK(lexy::_detail::swar_parse_8digits<16>("ABCDEF09") == 0xABCDEF09);
+        CHECK(lexy::_detail::swar_parse_8digits<16>("ffffffff") == 0xFFFFFFFF);
+        CHECK(lexy::_detail::swar_parse_8digits<16>("FfFfFfFf") == 0xFFFFFFFF);
+        CHECK(lexy::_detail::swar_parse_8digits<16>("90a0B0c0") == 0x90A0B0C0);
+    }
+}
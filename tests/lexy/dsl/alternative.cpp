@@ -6,6 +6,8 @@
 
 #include "verify.hpp"
 #include <lexy/dsl/ascii.hpp>
+#include <lexy/dsl/digit.hpp>
+#include <lexy/dsl/eof.hpp>
 #include <lexy/dsl/loop.hpp>
 
 TEST_CASE("dsl::operator/")
@@ -145,5 +147,48 @@ TEST_CASE("dsl::operator/")
         auto digit = LEXY_VERIFY("4");
         CHECK(digit == 1);
     }
-}
+    SUBCASE("dispatch")
+    {
+        // Each token is only tried if the input begins with one of its characters,
+        // and the EOF only at EOF.
+        static constexpr auto rule = LEXY_LIT("if") / LEXY_LIT("else") / lexy::dsl::digits<>
+                                     / token(while_one(lexy::dsl::ascii::alpha)) / lexy::dsl::eof;
+        CHECK(lexy::is_token_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur)
+            {
+                auto match = lexy::_detail::string_view(str, cur);
+                return int(match.size());
+            }
 
+            LEXY_VERIFY_FN int error(test_error<lexy::exhausted_alternatives> e)
+            {
+                LEXY_VERIFY_CHECK(e.position() == str);
+                return -1;
+            }
+        };
+
+        auto empty = LEXY_VERIFY("");
+        CHECK(empty == 0);
+
+        auto if_ = LEXY_VERIFY("if");
+        CHECK(if_ == 2);
+        auto else_ = LEXY_VERIFY("else+");
+        CHECK(else_ == 4);
+        auto ifx = LEXY_VERIFY("ifx");
+        CHECK(ifx == 3);
+        auto abc = LEXY_VERIFY("abc");
+        CHECK(abc == 3);
+        auto digits = LEXY_VERIFY("123");
+        CHECK(digits == 3);
+
+        auto plus = LEXY_VERIFY("+");
+        CHECK(plus == -1);
+        auto unicode = LEXY_VERIFY("ä");
+        CHECK(unicode == -1);
+    }
+}
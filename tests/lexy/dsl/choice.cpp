@@ -107,6 +107,54 @@ TEST_CASE("dsl::operator|")
         auto abc = LEXY_VERIFY("abc");
         CHECK(abc == 0);
     }
+    SUBCASE("dispatch")
+    {
+        static constexpr auto rule = LEXY_LIT("abc") >> label<0> | LEXY_LIT("def") >> label<1>
+                                     | lexy::dsl::else_ >> label<2>;
+        CHECK(lexy::is_rule<decltype(rule)>);
+
+        // The branches begin with different characters, so we select one by looking at it.
+        CHECK(decltype(rule)::_use_dispatch());
+        CHECK(!decltype(LEXY_LIT("ab") | LEXY_LIT("a"))::_use_dispatch());
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur, id<0>)
+            {
+                auto match = lexy::_detail::string_view(str, cur);
+                LEXY_VERIFY_CHECK(match == "abc");
+                return 0;
+            }
+            LEXY_VERIFY_FN int success(const char* cur, id<1>)
+            {
+                auto match = lexy::_detail::string_view(str, cur);
+                LEXY_VERIFY_CHECK(match == "def");
+                return 1;
+            }
+            LEXY_VERIFY_FN int success(const char* cur, id<2>)
+            {
+                LEXY_VERIFY_CHECK(cur == str);
+                return 2;
+            }
+        };
+
+        auto empty = LEXY_VERIFY("");
+        CHECK(empty == 2);
+
+        auto abc = LEXY_VERIFY("abc");
+        CHECK(abc == 0);
+        auto def = LEXY_VERIFY("def");
+        CHECK(def == 1);
+
+        auto ab = LEXY_VERIFY("ab");
+        CHECK(ab == 2);
+        auto xyz = LEXY_VERIFY("xyz");
+        CHECK(xyz == 2);
+        auto unicode = LEXY_VERIFY("ä");
+        CHECK(unicode == 2);
+    }
     SUBCASE("error")
     {
         struct tag;
@@ -0,0 +1,109 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <lexy/dsl/context_symbol_table.hpp>
+
+#include "verify.hpp"
+#include <lexy/dsl/alternative.hpp>
+#include <lexy/dsl/branch.hpp>
+#include <lexy/dsl/choice.hpp>
+
+TEST_CASE("dsl::context_symbol_table")
+{
+    // The table allocates memory, so we can't verify at compile-time.
+    static constexpr auto identifier
+        = lexy::dsl::identifier(lexy::dsl::lit_c<'*'> / lexy::dsl::lit_c<'+'>);
+    static constexpr auto table = lexy::dsl::context_symbol_table<struct table_id>(identifier);
+
+    SUBCASE("parsing")
+    {
+        static constexpr auto rule = table.create() + table.insert() + lexy::dsl::lit_c<'-'>
+                                     + table.insert() + lexy::dsl::lit_c<'-'>
+                                     + table.lookup().error<struct error>;
+
+        struct callback
+        {
+            const char* str;
+
+            int success(const char*, lexy::lexeme_for<test_input> a,
+                        lexy::lexeme_for<test_input> b, lexy::lexeme_for<test_input> c)
+            {
+                // We produce the lexeme of the inserted identifier.
+                CHECK((c.begin() == a.begin() || c.begin() == b.begin()));
+                return int(c.size());
+            }
+
+            int error(test_error<error> e)
+            {
+                CHECK(e.end() == lexy::_detail::string_view(str).end());
+                return -1;
+            }
+            int error(test_error<lexy::expected_literal>)
+            {
+                return -2;
+            }
+            int error(test_error<lexy::exhausted_alternatives>)
+            {
+                return -3;
+            }
+        };
+
+        auto empty = verify<callback>(rule, "");
+        CHECK(empty == -3);
+
+        auto first = verify<callback>(rule, "*-+-*");
+        CHECK(first == 1);
+        auto second = verify<callback>(rule, "*-++-++");
+        CHECK(second == 2);
+        auto duplicate = verify<callback>(rule, "*+-*+-*+");
+        CHECK(duplicate == 2);
+
+        auto unknown = verify<callback>(rule, "*-+-**");
+        CHECK(unknown == -1);
+        auto none = verify<callback>(rule, "*-+-");
+        CHECK(none == -3);
+    }
+    SUBCASE("branch parsing")
+    {
+        // Every identifier is either one we've seen before, or a new one.
+        static constexpr auto decl
+            = table.lookup() >> lexy::dsl::lit_c<'='> | table.insert() >> lexy::dsl::lit_c<':'>;
+        static constexpr auto rule = table.create() + decl + decl;
+
+        struct callback
+        {
+            const char* str;
+
+            int success(const char* cur, lexy::lexeme_for<test_input> a,
+                        lexy::lexeme_for<test_input> b)
+            {
+                CHECK(cur == lexy::_detail::string_view(str).end());
+                // If we have looked up the identifier, we produce the inserted one.
+                return b.begin() == a.begin() ? 0 : int(b.size());
+            }
+
+            int error(test_error<lexy::expected_literal> e)
+            {
+                return e.character() == '=' ? -1 : -2;
+            }
+            int error(test_error<lexy::exhausted_choice>)
+            {
+                return -3;
+            }
+        };
+
+        auto empty = verify<callback>(rule, "");
+        CHECK(empty == -3);
+
+        auto declare = verify<callback>(rule, "*:++:");
+        CHECK(declare == 2);
+        auto use = verify<callback>(rule, "**:**=");
+        CHECK(use == 0);
+
+        auto redeclare = verify<callback>(rule, "*:*:");
+        CHECK(redeclare == -1);
+        auto undeclared = verify<callback>(rule, "*=");
+        CHECK(undeclared == -2);
+    }
+}
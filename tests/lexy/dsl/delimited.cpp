@@ -5,10 +5,16 @@
 #include <lexy/dsl/delimited.hpp>
 
 #include "verify.hpp"
+#include <lexy/action/parse.hpp>
+#include <lexy/action/parse_as_tree.hpp>
+#include <lexy/callback/string.hpp>
 #include <lexy/dsl/ascii.hpp>
 #include <lexy/dsl/eof.hpp>
 #include <lexy/dsl/list.hpp>
 #include <lexy/dsl/option.hpp>
+#include <lexy/input/argv_input.hpp>
+#include <lexy_ext/parse_tree_doctest.hpp>
+#include <string>
 
 namespace
 {
@@ -665,6 +671,121 @@ TEST_CASE("predefined dsl::delimited")
                          decltype(triple_backticked_equivalent)>);
 }
 
+namespace
+{
+constexpr auto plain_rule = lexy::dsl::quoted.limit(lexy::dsl::ascii::newline)(
+    lexy::dsl::ascii::print, lexy::dsl::backslash_escape.capture(lexy::dsl::ascii::character));
+
+struct string_production
+{
+    static constexpr auto rule  = plain_rule;
+    static constexpr auto value = lexy::as_string<std::string>;
+};
+
+// Counts how often a lexeme is added to the sink.
+struct count_production
+{
+    struct counter
+    {
+        using return_type = std::size_t;
+
+        std::size_t count = 0;
+
+        template <typename Lexeme>
+        void operator()(Lexeme)
+        {
+            ++count;
+        }
+
+        std::size_t finish() &&
+        {
+            return count;
+        }
+    };
+
+    struct callback
+    {
+        using return_type = std::size_t;
+
+        counter sink() const
+        {
+            return {};
+        }
+
+        std::size_t operator()(std::size_t count) const
+        {
+            return count;
+        }
+    };
+
+    static constexpr auto rule  = plain_rule;
+    static constexpr auto value = callback{};
+};
+} // namespace
+
+TEST_CASE("dsl::delimited plain characters")
+{
+    auto parse = [](const std::string& str) {
+        auto input  = lexy::string_input(str.data(), str.size());
+        auto result = lexy::parse<string_production>(input, lexy::noop);
+        return result ? result.value() : "<error>";
+    };
+    auto count = [](const std::string& str) {
+        auto input  = lexy::string_input(str.data(), str.size());
+        auto result = lexy::parse<count_production>(input, lexy::noop);
+        return result ? result.value() : std::size_t(-1);
+    };
+
+    auto text = std::string();
+    for (auto i = 0; i != 10; ++i)
+        text += "lorem ipsum dolor sit amet, ";
+
+    CHECK(parse("\"\"").empty());
+    CHECK(parse("\"" + text + "\"") == text);
+    CHECK(parse("\"" + text + "\\\"" + text + "\"") == text + "\"" + text);
+    CHECK(parse("\"" + text + "\n" + text + "\"") == "<error>");
+    CHECK(parse("\"" + text) == "<error>");
+    CHECK(parse("\"" + text + "\x01\"") == "<error>");
+
+    // The plain characters are added at once.
+    CHECK(count("\"" + text + "\"") == 1);
+    CHECK(count("\"" + text + "\\\"" + text + "\"") == 3);
+    CHECK(count("\"" + text + "\\\\\"") == 2);
+}
+
+TEST_CASE("dsl::delimited plain characters parse tree")
+{
+    // A contiguous reader adds a run of plain characters as a single token.
+    auto input = lexy::zstring_input(R"("abc\"d")");
+
+    lexy::parse_tree_for<decltype(input)> tree;
+    auto result = lexy::parse_as_tree<string_production>(tree, input, lexy::noop);
+    REQUIRE(result);
+
+    // clang-format off
+    auto expected = lexy_ext::parse_tree_desc(string_production{})
+        .token("\"")
+        .token("abc")
+        .token("\\")
+        .token("d")
+        .token("\"");
+    // clang-format on
+    CHECK(tree == expected);
+
+    // Other readers add a token and lexeme for each character.
+    char  program[] = "program";
+    char  arg[]     = R"("abc\"d")";
+    char* argv[]    = {program, arg, nullptr};
+
+    auto argv_result = lexy::parse<count_production>(lexy::argv_input(2, argv), lexy::noop);
+    REQUIRE(argv_result);
+    CHECK(argv_result.value() == 5);
+
+    auto string_result = lexy::parse<count_production>(input, lexy::noop);
+    REQUIRE(string_result);
+    CHECK(string_result.value() == 3);
+}
+
 namespace
 {
 constexpr auto symbols = lexy::symbol_table<char>.map<'a'>('a');
@@ -5,6 +5,7 @@
 #include <lexy/dsl/identifier.hpp>
 
 #include "verify.hpp"
+#include "words.hpp"
 #include <lexy/dsl/ascii.hpp>
 #include <lexy/dsl/if.hpp>
 #include <lexy/dsl/whitespace.hpp>
@@ -15,6 +16,13 @@ struct ws_production
 {
     static constexpr auto whitespace = LEXY_LIT(" ");
 };
+
+// Enough literals that they're looked up using a hash table.
+template <typename Id, std::size_t... Idx>
+constexpr auto reserve_words(Id id, lexy::_detail::index_sequence<Idx...>)
+{
+    return id.reserve(lexy::dsl::_lit<word<Idx>>{}...);
+}
 } // namespace
 
 TEST_CASE("dsl::identifier()")
@@ -325,6 +333,70 @@ TEST_CASE("dsl::identifier()")
         CHECK(a1 == 1);
     }
 
+    SUBCASE(".reserve() many")
+    {
+        static constexpr auto rule
+            = reserve_words(identifier(lexy::dsl::ascii::alpha),
+                            lexy::_detail::make_index_sequence<300>{})
+                  .reserve(LEXY_KEYWORD("int", identifier(lexy::dsl::ascii::alpha)),
+                           LEXY_LIT("q") + lexy::dsl::ascii::alpha);
+        CHECK(lexy::is_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur, lexy::lexeme_for<test_input> id)
+            {
+                LEXY_VERIFY_CHECK(id.begin() == str);
+                LEXY_VERIFY_CHECK(id.end() == cur);
+                return int(cur - str);
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::expected_char_class> e)
+            {
+                LEXY_VERIFY_CHECK(e.position() == str);
+                return -1;
+            }
+            LEXY_VERIFY_FN int error(test_error<lexy::reserved_identifier> e)
+            {
+                LEXY_VERIFY_CHECK(e.begin() == str);
+                LEXY_VERIFY_CHECK(e.end() == lexy::_detail::string_view(str).end());
+                return -2;
+            }
+        };
+
+        auto empty = LEXY_VERIFY("");
+        CHECK(empty == -1);
+
+        auto a = LEXY_VERIFY("a");
+        CHECK(a == 1);
+        auto prefix = LEXY_VERIFY("Aa");
+        CHECK(prefix == 2);
+        auto longer = LEXY_VERIFY("Aaaz");
+        CHECK(longer == 4);
+        auto integer = LEXY_VERIFY("integer");
+        CHECK(integer == 7);
+        auto qab = LEXY_VERIFY("qab");
+        CHECK(qab == 3);
+
+        auto first = LEXY_VERIFY("Aaa");
+        CHECK(first.value == 3);
+        CHECK(first.errors(-2));
+        auto long_ = LEXY_VERIFY("Gaazzzzzz");
+        CHECK(long_.value == 9);
+        CHECK(long_.errors(-2));
+        auto last = LEXY_VERIFY("Nlazzzzz");
+        CHECK(last.value == 8);
+        CHECK(last.errors(-2));
+        auto int_ = LEXY_VERIFY("int");
+        CHECK(int_.value == 3);
+        CHECK(int_.errors(-2));
+        auto qa = LEXY_VERIFY("qa");
+        CHECK(qa.value == 2);
+        CHECK(qa.errors(-2));
+    }
+
     SUBCASE("branch")
     {
         static constexpr auto rule = lexy::dsl::if_(identifier(lexy::dsl::ascii::alpha));
@@ -299,6 +299,84 @@ TEST_CASE("dsl::integer conversion")
             CHECK(result.errors(-1));
         }
     }
+    SUBCASE("n_digits, blocks")
+    {
+        static constexpr auto rule = lexy::dsl::integer<int>(lexy::dsl::n_digits<10>);
+
+        CHECK(parse(rule, "0000000000") == 0);
+        CHECK(parse(rule, "0123456789") == 123456789);
+        CHECK(parse(rule, "1234567890") == 1234567890);
+        CHECK(parse(rule, std::to_string(INT_MAX).c_str()) == INT_MAX);
+
+        auto overflow = parse(rule, std::to_string(INT_MAX + 1ll).c_str());
+        CHECK(overflow.value == INT_MAX / 10 * 10);
+        CHECK(overflow.errors(-1));
+    }
+}
+
+TEST_CASE("dsl::integer long digit sequence")
+{
+    // Long sequences of digits are converted in blocks of eight digits.
+    auto parse = [](auto type, auto base, const std::string& str) {
+        using parser = lexyd::_bounded_integer_parser<decltype(type), decltype(base), true>;
+        static_assert(parser::template _can_parse_8digits<const char*>);
+
+        auto result = decltype(type)(0);
+        auto ok     = parser::parse(result, str.data(), str.data() + str.size());
+        return ok ? result : decltype(type)(42);
+    };
+
+    SUBCASE("base 10, uint64_t")
+    {
+        auto type = std::uint64_t();
+        auto base = lexy::dsl::decimal{};
+
+        std::uint64_t value = 0;
+        for (auto i = 1u; i <= 19; ++i)
+        {
+            value = value * 10 + i % 10;
+            CHECK(parse(type, base, std::to_string(value)) == value);
+            CHECK(parse(type, base, "00000000000" + std::to_string(value)) == value);
+        }
+
+        CHECK(parse(type, base, std::to_string(UINT64_MAX)) == UINT64_MAX);
+        CHECK(parse(type, base, std::to_string(UINT64_MAX - 1)) == UINT64_MAX - 1);
+        CHECK(parse(type, base, "18446744073709551616") == 42);
+        CHECK(parse(type, base, "99999999999999999999") == 42);
+        CHECK(parse(type, base, "100000000000000000000") == 42);
+    }
+    SUBCASE("base 10, int64_t")
+    {
+        auto type = std::int64_t();
+        auto base = lexy::dsl::decimal{};
+
+        CHECK(parse(type, base, "123456789") == 123456789);
+        CHECK(parse(type, base, "12345678901234567") == 12345678901234567);
+        CHECK(parse(type, base, std::to_string(INT64_MAX)) == INT64_MAX);
+        CHECK(parse(type, base, "9223372036854775808") == 42);
+        CHECK(parse(type, base, "10000000000000000000") == 42);
+    }
+    SUBCASE("base 10, uint32_t")
+    {
+        auto type = std::uint32_t();
+        auto base = lexy::dsl::decimal{};
+
+        CHECK(parse(type, base, "987654321") == 987654321);
+        CHECK(parse(type, base, "4294967295") == UINT32_MAX);
+        CHECK(parse(type, base, "4294967296") == 42);
+        CHECK(parse(type, base, "9999999999") == 42);
+    }
+    SUBCASE("base 16, uint64_t")
+    {
+        auto type = std::uint64_t();
+
+        CHECK(parse(type, lexy::dsl::hex{}, "123456789aBcDeF0") == 0x123456789ABCDEF0);
+        CHECK(parse(type, lexy::dsl::hex{}, "FFFFFFFFFFFFFFFF") == UINT64_MAX);
+        CHECK(parse(type, lexy::dsl::hex{}, "00000000fedcba987") == 0xFEDCBA987);
+        CHECK(parse(type, lexy::dsl::hex{}, "10000000000000000") == 42);
+        CHECK(parse(type, lexy::dsl::hex_lower{}, "abcdef0123") == 0xABCDEF0123);
+        CHECK(parse(type, lexy::dsl::hex_upper{}, "ABCDEF0123") == 0xABCDEF0123);
+    }
 }
 
 TEST_CASE("dsl::integer parsing")
@@ -0,0 +1,214 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <lexy/dsl/real.hpp>
+
+#include "verify.hpp"
+#include <lexy/dsl/if.hpp>
+#include <lexy/dsl/literal.hpp>
+
+TEST_CASE("dsl::real")
+{
+    SUBCASE("basic")
+    {
+        static constexpr auto rule = lexy::dsl::real<double>;
+        CHECK(lexy::is_rule<decltype(rule)>);
+        CHECK(lexy::is_branch_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur, double value)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return int(value * 1000);
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::expected_char_class> e)
+            {
+                LEXY_VERIFY_CHECK(e.position() == str);
+                LEXY_VERIFY_CHECK(e.character_class()
+                                  == lexy::_detail::string_view("digit.decimal"));
+                return -1;
+            }
+        };
+
+        auto empty = LEXY_VERIFY("");
+        CHECK(empty == -1);
+        auto no_digit = LEXY_VERIFY("abc");
+        CHECK(no_digit == -1);
+        auto only_fraction = LEXY_VERIFY(".5");
+        CHECK(only_fraction == -1);
+
+        auto zero = LEXY_VERIFY("0");
+        CHECK(zero == 0);
+        auto integer = LEXY_VERIFY("42");
+        CHECK(integer == 42000);
+        auto leading_zero = LEXY_VERIFY("0042");
+        CHECK(leading_zero == 42000);
+
+        auto fraction = LEXY_VERIFY("3.125");
+        CHECK(fraction == 3125);
+        auto zero_fraction = LEXY_VERIFY("0.001");
+        CHECK(zero_fraction == 1);
+
+        auto exponent = LEXY_VERIFY("3e3");
+        CHECK(exponent == 3000000);
+        auto exponent_upper = LEXY_VERIFY("3E3");
+        CHECK(exponent_upper == 3000000);
+        auto exponent_plus = LEXY_VERIFY("3e+3");
+        CHECK(exponent_plus == 3000000);
+        auto exponent_minus = LEXY_VERIFY("3e-3");
+        CHECK(exponent_minus == 3);
+        auto exponent_zero = LEXY_VERIFY("3e000");
+        CHECK(exponent_zero == 3000);
+
+        auto fraction_exponent = LEXY_VERIFY("1.5e2");
+        CHECK(fraction_exponent == 150000);
+        auto many_digits = LEXY_VERIFY("0.12345678901234567890123456789e4");
+        CHECK(many_digits == 1234567);
+    }
+    SUBCASE("partial")
+    {
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char*, double value)
+            {
+                return int(value * 1000);
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::expected_char_class>)
+            {
+                return -1;
+            }
+            LEXY_VERIFY_FN int error(test_error<lexy::expected_literal>)
+            {
+                return -2;
+            }
+        };
+
+        {
+            // The decimal point is only consumed if followed by a digit.
+            static constexpr auto rule = lexy::dsl::real<double> + LEXY_LIT(".");
+
+            auto point = LEXY_VERIFY("1.");
+            CHECK(point == 1000);
+            auto point_exponent = LEXY_VERIFY("1.e3");
+            CHECK(point_exponent == 1000);
+        }
+        {
+            // The exponent is only consumed if followed by a digit.
+            static constexpr auto rule = lexy::dsl::real<double> + LEXY_LIT("e");
+
+            auto exponent = LEXY_VERIFY("1e");
+            CHECK(exponent == 1000);
+            auto fraction_exponent = LEXY_VERIFY("1.5e");
+            CHECK(fraction_exponent == 1500);
+        }
+        {
+            static constexpr auto rule = lexy::dsl::real<double> + LEXY_LIT("e-");
+
+            auto sign = LEXY_VERIFY("1e-");
+            CHECK(sign == 1000);
+            auto sign_letter = LEXY_VERIFY("2e-x");
+            CHECK(sign_letter == 2000);
+        }
+    }
+    SUBCASE("float")
+    {
+        static constexpr auto rule = lexy::dsl::real<float>;
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char*, float value)
+            {
+                return int(value * 1000);
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::expected_char_class>)
+            {
+                return -1;
+            }
+        };
+
+        auto fraction = LEXY_VERIFY("3.125");
+        CHECK(fraction == 3125);
+        auto exponent = LEXY_VERIFY("25e-3");
+        CHECK(exponent == 25);
+    }
+    SUBCASE(".no_leading_zero()")
+    {
+        static constexpr auto rule = lexy::dsl::real<double>.no_leading_zero();
+        CHECK(lexy::is_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur, double value)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return int(value * 1000);
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::expected_char_class>)
+            {
+                return -1;
+            }
+            LEXY_VERIFY_FN int error(test_error<lexy::forbidden_leading_zero> e)
+            {
+                LEXY_VERIFY_CHECK(e.begin() == str);
+                LEXY_VERIFY_CHECK(e.end() == str + 1);
+                return -2;
+            }
+        };
+
+        auto empty = LEXY_VERIFY("");
+        CHECK(empty == -1);
+
+        auto zero = LEXY_VERIFY("0");
+        CHECK(zero == 0);
+        auto zero_fraction = LEXY_VERIFY("0.5");
+        CHECK(zero_fraction == 500);
+        auto zero_exponent = LEXY_VERIFY("0e5");
+        CHECK(zero_exponent == 0);
+        auto integer = LEXY_VERIFY("120.5");
+        CHECK(integer == 120500);
+
+        auto leading_zero = LEXY_VERIFY("012.5");
+        CHECK(leading_zero == -2);
+    }
+    SUBCASE("branch")
+    {
+        static constexpr auto rule = lexy::dsl::if_(lexy::dsl::real<double>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur)
+            {
+                LEXY_VERIFY_CHECK(cur == str);
+                return 0;
+            }
+            LEXY_VERIFY_FN int success(const char*, double value)
+            {
+                return int(value * 1000);
+            }
+        };
+
+        auto empty = LEXY_VERIFY("");
+        CHECK(empty == 0);
+        auto no_digit = LEXY_VERIFY("abc");
+        CHECK(no_digit == 0);
+
+        auto fraction = LEXY_VERIFY("2.5");
+        CHECK(fraction == 2500);
+    }
+}
@@ -0,0 +1,212 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#define LEXY_IGNORE_DEPRECATED_SWITCH
+#include <lexy/dsl/switch.hpp>
+
+#include "verify.hpp"
+#include <lexy/dsl/ascii.hpp>
+#include <lexy/dsl/digit.hpp>
+#include <lexy/dsl/loop.hpp>
+#include <lexy/dsl/token.hpp>
+
+TEST_CASE("dsl::switch_")
+{
+    static constexpr auto value = token(while_one(lexy::dsl::ascii::alnum));
+
+    SUBCASE("literals")
+    {
+        // Selects the case using a trie.
+        static constexpr auto rule = lexy::dsl::switch_(value)
+                                         .case_(LEXY_LIT("abc") >> label<0>)
+                                         .case_(LEXY_LIT("a") >> label<1>)
+                                         .case_(LEXY_LIT("ab") >> label<2>);
+        CHECK(lexy::is_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur, id<0>)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return 0;
+            }
+            LEXY_VERIFY_FN int success(const char* cur, id<1>)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return 1;
+            }
+            LEXY_VERIFY_FN int success(const char* cur, id<2>)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return 2;
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::missing_token>)
+            {
+                return -1;
+            }
+            LEXY_VERIFY_FN int error(test_error<lexy::exhausted_switch> e)
+            {
+                LEXY_VERIFY_CHECK(e.begin() == str);
+                LEXY_VERIFY_CHECK(e.end() == lexy::_detail::string_view(str).end());
+                return -2;
+            }
+        };
+
+        auto empty = LEXY_VERIFY("");
+        CHECK(empty == -1);
+
+        auto abc = LEXY_VERIFY("abc");
+        CHECK(abc == 0);
+        auto a = LEXY_VERIFY("a");
+        CHECK(a == 1);
+        auto ab = LEXY_VERIFY("ab");
+        CHECK(ab == 2);
+
+        auto abcd = LEXY_VERIFY("abcd");
+        CHECK(abcd == -2);
+        auto b = LEXY_VERIFY("b");
+        CHECK(b == -2);
+    }
+    SUBCASE("literals and default")
+    {
+        static constexpr auto rule = lexy::dsl::switch_(value)
+                                         .case_(LEXY_LIT("abc") >> label<0>)
+                                         .case_(LEXY_LIT("a") >> label<1>)
+                                         .default_(label<2>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur, id<0>)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return 0;
+            }
+            LEXY_VERIFY_FN int success(const char* cur, id<1>)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return 1;
+            }
+            LEXY_VERIFY_FN int success(const char* cur, id<2>)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return 2;
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::missing_token>)
+            {
+                return -1;
+            }
+        };
+
+        auto abc = LEXY_VERIFY("abc");
+        CHECK(abc == 0);
+        auto a = LEXY_VERIFY("a");
+        CHECK(a == 1);
+        auto ab = LEXY_VERIFY("ab");
+        CHECK(ab == 2);
+        auto abcd = LEXY_VERIFY("abcd");
+        CHECK(abcd == 2);
+    }
+    SUBCASE("duplicate literals")
+    {
+        // The first case is taken.
+        static constexpr auto rule = lexy::dsl::switch_(value)
+                                         .case_(LEXY_LIT("a") >> label<0>)
+                                         .case_(LEXY_LIT("a") >> label<1>)
+                                         .case_(LEXY_LIT("b") >> label<2>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char*, id<0>)
+            {
+                return 0;
+            }
+            LEXY_VERIFY_FN int success(const char*, id<1>)
+            {
+                return 1;
+            }
+            LEXY_VERIFY_FN int success(const char*, id<2>)
+            {
+                return 2;
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::missing_token>)
+            {
+                return -1;
+            }
+            LEXY_VERIFY_FN int error(test_error<lexy::exhausted_switch>)
+            {
+                return -2;
+            }
+        };
+
+        auto a = LEXY_VERIFY("a");
+        CHECK(a == 0);
+        auto b = LEXY_VERIFY("b");
+        CHECK(b == 2);
+        auto c = LEXY_VERIFY("c");
+        CHECK(c == -2);
+    }
+    SUBCASE("tokens")
+    {
+        // The cases are tried in order, skipping those that can't begin with the first character.
+        struct tag;
+        static constexpr auto word = token(while_one(lexy::dsl::ascii::alpha));
+        static constexpr auto rule = lexy::dsl::switch_(value)
+                                         .case_(LEXY_LIT("abc") >> label<0>)
+                                         .case_(lexy::dsl::digits<> >> label<1>)
+                                         .case_(word >> label<2>)
+                                         .error<tag>;
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur, id<0>)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return 0;
+            }
+            LEXY_VERIFY_FN int success(const char* cur, id<1>)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return 1;
+            }
+            LEXY_VERIFY_FN int success(const char* cur, id<2>)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return 2;
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::missing_token>)
+            {
+                return -1;
+            }
+            LEXY_VERIFY_FN int error(test_error<tag> e)
+            {
+                LEXY_VERIFY_CHECK(e.begin() == str);
+                return -2;
+            }
+        };
+
+        auto abc = LEXY_VERIFY("abc");
+        CHECK(abc == 0);
+        auto digits = LEXY_VERIFY("123");
+        CHECK(digits == 1);
+        auto alpha = LEXY_VERIFY("abcd");
+        CHECK(alpha == 2);
+
+        auto mixed = LEXY_VERIFY("a1");
+        CHECK(mixed == -2);
+        auto digits_alpha = LEXY_VERIFY("1a");
+        CHECK(digits_alpha == -2);
+    }
+}
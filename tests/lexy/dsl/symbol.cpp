@@ -5,6 +5,8 @@
 #include <lexy/dsl/symbol.hpp>
 
 #include "verify.hpp"
+#include "words.hpp"
+#include <lexy/dynamic_symbol_table.hpp>
 #include <lexy/dsl/ascii.hpp>
 #include <lexy/dsl/identifier.hpp>
 #include <lexy/dsl/loop.hpp>
@@ -528,3 +530,306 @@ TEST_CASE("dsl::symbol(identifier)")
         CHECK(ab == -1);
     }
 }
+
+namespace
+{
+template <std::size_t Idx, std::size_t Size, typename Table>
+LEXY_CONSTEVAL auto map_words(Table table)
+{
+    if constexpr (Idx == Size)
+        return table;
+    else
+        return map_words<Idx + 1, Size>(table.template map<word<Idx>>(int(Idx)));
+}
+
+// Enough symbols that they're looked up using a hash table.
+constexpr auto many_symbols = map_words<0, 300>(lexy::symbol_table<int>);
+// One of them isn't an identifier, so they're matched using the trie.
+constexpr auto many_symbols_not_id = many_symbols.map<LEXY_SYMBOL("A-b")>(300);
+} // namespace
+
+TEST_CASE("dsl::symbol(identifier) with many symbols")
+{
+    constexpr auto id = identifier(lexy::dsl::ascii::upper, lexy::dsl::ascii::lower);
+
+    SUBCASE("basic")
+    {
+        static constexpr auto rule = lexy::dsl::symbol<many_symbols>(id);
+        CHECK(lexy::is_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur, int i)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return i;
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::unknown_symbol> e)
+            {
+                LEXY_VERIFY_CHECK(e.begin() == str);
+                LEXY_VERIFY_CHECK(e.end() == lexy::_detail::string_view(str).end());
+                return -1;
+            }
+            LEXY_VERIFY_FN int error(test_error<lexy::expected_char_class> e)
+            {
+                LEXY_VERIFY_CHECK(e.position() == str);
+                return -2;
+            }
+        };
+
+        auto empty = LEXY_VERIFY("");
+        CHECK(empty == -2);
+
+        auto first = LEXY_VERIFY("Aaa");
+        CHECK(first == 0);
+        auto second = LEXY_VERIFY("Baaz");
+        CHECK(second == 1);
+        auto long_ = LEXY_VERIFY("Gaazzzzzz");
+        CHECK(long_ == 6);
+        auto last = LEXY_VERIFY("Nlazzzzz");
+        CHECK(last == 299);
+
+        auto prefix = LEXY_VERIFY("Aa");
+        CHECK(prefix == -1);
+        auto longer = LEXY_VERIFY("Aaaz");
+        CHECK(longer == -1);
+        auto too_long = LEXY_VERIFY("Aaazzzzzzzzzzzzzz");
+        CHECK(too_long == -1);
+        auto non_alpha = LEXY_VERIFY("123");
+        CHECK(non_alpha == -2);
+    }
+    SUBCASE("branch")
+    {
+        static constexpr auto rule = opt(lexy::dsl::symbol<many_symbols>(id));
+        CHECK(lexy::is_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur, lexy::nullopt)
+            {
+                LEXY_VERIFY_CHECK(cur == str);
+                return 42;
+            }
+            LEXY_VERIFY_FN int success(const char* cur, int i)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return i;
+            }
+        };
+
+        auto empty = LEXY_VERIFY("");
+        CHECK(empty == 42);
+
+        auto first = LEXY_VERIFY("Aaa");
+        CHECK(first == 0);
+        auto last = LEXY_VERIFY("Nlazzzzz");
+        CHECK(last == 299);
+
+        auto longer = LEXY_VERIFY("Aaaz");
+        CHECK(longer == 42);
+        auto non_alpha = LEXY_VERIFY("123");
+        CHECK(non_alpha == 42);
+    }
+    SUBCASE("token")
+    {
+        static constexpr auto rule = lexy::dsl::symbol<many_symbols>(token(id));
+        CHECK(lexy::is_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur, int i)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return i;
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::unknown_symbol>)
+            {
+                return -1;
+            }
+            LEXY_VERIFY_FN int error(test_error<lexy::missing_token>)
+            {
+                return -2;
+            }
+        };
+
+        auto first = LEXY_VERIFY("Aaa");
+        CHECK(first == 0);
+        auto last = LEXY_VERIFY("Nlazzzzz");
+        CHECK(last == 299);
+
+        auto longer = LEXY_VERIFY("Aaaz");
+        CHECK(longer == -1);
+        auto non_alpha = LEXY_VERIFY("123");
+        CHECK(non_alpha == -2);
+    }
+    SUBCASE("not all identifiers")
+    {
+        static constexpr auto rule = lexy::dsl::symbol<many_symbols_not_id>(id);
+        CHECK(lexy::is_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            LEXY_VERIFY_FN int success(const char* cur, int i)
+            {
+                LEXY_VERIFY_CHECK(cur == lexy::_detail::string_view(str).end());
+                return i;
+            }
+
+            LEXY_VERIFY_FN int error(test_error<lexy::unknown_symbol>)
+            {
+                return -1;
+            }
+            LEXY_VERIFY_FN int error(test_error<lexy::expected_char_class>)
+            {
+                return -2;
+            }
+        };
+
+        auto first = LEXY_VERIFY("Aaa");
+        CHECK(first == 0);
+        auto last = LEXY_VERIFY("Nlazzzzz");
+        CHECK(last == 299);
+        auto not_id = LEXY_VERIFY("A-b");
+        CHECK(not_id == 300);
+
+        auto longer = LEXY_VERIFY("Aaaz");
+        CHECK(longer == -1);
+    }
+}
+
+namespace
+{
+lexy::dynamic_symbol_table<int> dynamic_symbols;
+} // namespace
+
+TEST_CASE("dsl::symbol(identifier) with dynamic_symbol_table")
+{
+    // The table is filled at runtime, so we can't verify at compile-time.
+    constexpr auto id = identifier(lexy::dsl::ascii::upper, lexy::dsl::ascii::lower);
+
+    dynamic_symbols.clear();
+    dynamic_symbols.insert("A", 0);
+    dynamic_symbols.insert("Abc", 1);
+
+    SUBCASE("basic")
+    {
+        static constexpr auto rule = lexy::dsl::symbol<dynamic_symbols>(id);
+        CHECK(lexy::is_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            int success(const char* cur, int i)
+            {
+                CHECK(cur == lexy::_detail::string_view(str).end());
+                return i;
+            }
+
+            int error(test_error<lexy::unknown_symbol> e)
+            {
+                CHECK(e.begin() == str);
+                CHECK(e.end() == lexy::_detail::string_view(str).end());
+                return -1;
+            }
+            int error(test_error<lexy::expected_char_class> e)
+            {
+                CHECK(e.position() == str);
+                return -2;
+            }
+        };
+
+        auto empty = verify<callback>(rule, "");
+        CHECK(empty == -2);
+
+        auto a = verify<callback>(rule, "A");
+        CHECK(a == 0);
+        auto abc = verify<callback>(rule, "Abc");
+        CHECK(abc == 1);
+
+        auto ab = verify<callback>(rule, "Ab");
+        CHECK(ab == -1);
+        auto abcd = verify<callback>(rule, "Abcd");
+        CHECK(abcd == -1);
+
+        dynamic_symbols.insert("Ab", 2);
+        auto inserted = verify<callback>(rule, "Ab");
+        CHECK(inserted == 2);
+        dynamic_symbols.erase("Abc");
+        auto erased = verify<callback>(rule, "Abc");
+        CHECK(erased == -1);
+    }
+    SUBCASE("branch")
+    {
+        static constexpr auto rule = opt(lexy::dsl::symbol<dynamic_symbols>(id));
+        CHECK(lexy::is_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            int success(const char* cur, lexy::nullopt)
+            {
+                CHECK(cur == str);
+                return 42;
+            }
+            int success(const char* cur, int i)
+            {
+                CHECK(cur == lexy::_detail::string_view(str).end());
+                return i;
+            }
+        };
+
+        auto empty = verify<callback>(rule, "");
+        CHECK(empty == 42);
+
+        auto abc = verify<callback>(rule, "Abc");
+        CHECK(abc == 1);
+
+        auto ab = verify<callback>(rule, "Ab");
+        CHECK(ab == 42);
+        auto non_alpha = verify<callback>(rule, "123");
+        CHECK(non_alpha == 42);
+    }
+    SUBCASE("token")
+    {
+        static constexpr auto rule = lexy::dsl::symbol<dynamic_symbols>(token(id));
+        CHECK(lexy::is_rule<decltype(rule)>);
+
+        struct callback
+        {
+            const char* str;
+
+            int success(const char*, int i)
+            {
+                return i;
+            }
+
+            int error(test_error<lexy::unknown_symbol>)
+            {
+                return -1;
+            }
+            int error(test_error<lexy::missing_token>)
+            {
+                return -2;
+            }
+        };
+
+        auto abc = verify<callback>(rule, "Abc");
+        CHECK(abc == 1);
+        auto ab = verify<callback>(rule, "Ab");
+        CHECK(ab == -1);
+        auto non_alpha = verify<callback>(rule, "123");
+        CHECK(non_alpha == -2);
+    }
+}
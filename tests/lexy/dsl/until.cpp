@@ -5,7 +5,11 @@
 #include <lexy/dsl/until.hpp>
 
 #include "verify.hpp"
+#include <lexy/dsl/alternative.hpp>
+#include <lexy/dsl/eof.hpp>
+#include <lexy/dsl/newline.hpp>
 #include <lexy/dsl/peek.hpp>
+#include <string>
 
 TEST_CASE("dsl::until()")
 {
@@ -74,3 +78,29 @@ TEST_CASE("dsl::until().or_eof()")
     CHECK(unterminated == 3);
 }
 
+TEST_CASE("dsl::until(newline / eof)")
+{
+    static constexpr auto rule = until(lexy::dsl::newline / lexy::dsl::eof);
+    CHECK(lexy::is_token_rule<decltype(rule)>);
+
+    // Only a newline character needs to be checked; EOF is always checked.
+    using condition   = typename decltype(lexy::dsl::newline / lexy::dsl::eof)::token_engine;
+    constexpr auto& first = lexy::_engine_first_chars<condition>;
+    CHECK(first.size() == 2);
+    CHECK(first.contains('\n'));
+    CHECK(first.contains('\r'));
+
+    using engine = typename decltype(rule)::token_engine;
+    auto match   = [](const std::string& str) {
+        auto input  = lexy::string_input(str.data(), str.size());
+        auto reader = input.reader();
+        if (engine::match(reader) != engine::error_code())
+            return std::size_t(-1);
+        return std::size_t(reader.cur() - input.data());
+    };
+
+    auto line = std::string(40, 'a') + "\r" + std::string(30, 'b');
+    CHECK(match(line + "\r\nc") == line.size() + 2);
+    CHECK(match(line + "\nc") == line.size() + 1);
+    CHECK(match(line) == line.size());
+}
@@ -0,0 +1,41 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TEST_DSL_WORDS_HPP_INCLUDED
+#define TEST_DSL_WORDS_HPP_INCLUDED
+
+#include <cstddef>
+#include <lexy/_detail/string_view.hpp>
+
+// Made up words: an uppercase letter followed by two to eight lowercase letters.
+// They can be used as the string of a literal or symbol, and there are enough of them to test the
+// hash table lookup.
+template <std::size_t Idx>
+struct word
+{
+    using char_type            = char;
+    static constexpr auto size = 3 + Idx % 7;
+
+    struct storage_t
+    {
+        char data[10];
+    };
+    static constexpr auto storage = [] {
+        storage_t result{};
+        result.data[0] = char('A' + Idx % 26);
+        result.data[1] = char('a' + Idx / 26 % 26);
+        result.data[2] = char('a' + Idx / (26 * 26) % 26);
+        for (auto i = 3u; i != size; ++i)
+            result.data[i] = 'z';
+        return result;
+    }();
+
+    template <typename CharT = char>
+    static constexpr auto get()
+    {
+        return lexy::_detail::string_view(lexy::_detail::null_terminated{}, storage.data, size);
+    }
+};
+
+#endif // TEST_DSL_WORDS_HPP_INCLUDED
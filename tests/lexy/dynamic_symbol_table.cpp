@@ -0,0 +1,123 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <lexy/dynamic_symbol_table.hpp>
+
+#include <doctest/doctest.h>
+#include <lexy/input/string_input.hpp>
+#include <string>
+#include <vector>
+
+TEST_CASE("dynamic_symbol_table")
+{
+    lexy::dynamic_symbol_table<int> table;
+    CHECK(table.empty());
+    CHECK(table.size() == 0);
+    CHECK(!table.lookup("abc"));
+
+    SUBCASE("insert")
+    {
+        CHECK(table.insert("abc", 0));
+        CHECK(table.insert("a", 1));
+        CHECK(table.insert("", 2));
+        CHECK(!table.insert("abc", 3));
+        CHECK(table.size() == 3);
+
+        CHECK(table[table.lookup("abc")] == 0);
+        CHECK(table[table.lookup("a")] == 1);
+        CHECK(table[table.lookup("")] == 2);
+        CHECK(!table.lookup("ab"));
+        CHECK(!table.lookup("abcd"));
+
+        table[table.lookup("a")] = 11;
+        CHECK(table[table.lookup("a")] == 11);
+    }
+    SUBCASE("lexeme")
+    {
+        auto input  = lexy::zstring_input("hello world");
+        auto reader = input.reader();
+
+        auto hello = lexy::lexeme_for<decltype(input)>(reader.cur(), 5);
+        auto world = lexy::lexeme_for<decltype(input)>(reader.cur() + 6, 5);
+        CHECK(table.insert(hello, 0));
+        CHECK(table.insert(world, 1));
+        CHECK(!table.insert(hello, 2));
+
+        CHECK(table[table.lookup(hello)] == 0);
+        CHECK(table[table.lookup("world")] == 1);
+        CHECK(!table.lookup(lexy::lexeme_for<decltype(input)>(reader.cur(), 4)));
+
+        CHECK(table.erase(hello));
+        CHECK(!table.erase(hello));
+        CHECK(!table.lookup("hello"));
+        CHECK(table[table.lookup(world)] == 1);
+    }
+    SUBCASE("many")
+    {
+        std::vector<std::string> symbols;
+        for (auto i = 0; i != 1000; ++i)
+            symbols.push_back("symbol" + std::to_string(i));
+
+        for (auto i = 0; i != 1000; ++i)
+            CHECK(table.insert(symbols[std::size_t(i)].c_str(), i));
+        CHECK(table.size() == 1000);
+        for (auto i = 0; i != 1000; ++i)
+            CHECK(table[table.lookup(symbols[std::size_t(i)].c_str())] == i);
+        CHECK(!table.lookup("symbol1000"));
+
+        // Erase every other symbol; this moves symbols around both in the slots and the entries.
+        for (auto i = 0; i < 1000; i += 2)
+            CHECK(table.erase(symbols[std::size_t(i)].c_str()));
+        CHECK(table.size() == 500);
+        for (auto i = 0; i != 1000; ++i)
+        {
+            auto idx = table.lookup(symbols[std::size_t(i)].c_str());
+            if (i % 2 == 0)
+                CHECK(!idx);
+            else
+                CHECK(table[idx] == i);
+        }
+
+        table.clear();
+        CHECK(table.empty());
+        for (auto& symbol : symbols)
+            CHECK(!table.lookup(symbol.c_str()));
+
+        CHECK(table.insert("abc", 42));
+        CHECK(table[table.lookup("abc")] == 42);
+    }
+    SUBCASE("reserve")
+    {
+        table.reserve(100);
+        CHECK(table.insert("abc", 0));
+        CHECK(table[table.lookup("abc")] == 0);
+    }
+    SUBCASE("move")
+    {
+        table.insert("abc", 0);
+
+        auto other = LEXY_MOV(table);
+        CHECK(other.size() == 1);
+        CHECK(other[other.lookup("abc")] == 0);
+
+        table = LEXY_MOV(other);
+        CHECK(table.size() == 1);
+        CHECK(table[table.lookup("abc")] == 0);
+    }
+}
+
+TEST_CASE("dynamic_symbol_table insert aliasing an entry")
+{
+    lexy::dynamic_symbol_table<std::string> table;
+
+    const char* symbols[] = {"a", "b", "c", "d", "e", "f", "g", "h"};
+    for (auto symbol : symbols)
+        CHECK(table.insert(symbol, std::string(100, *symbol)));
+
+    // The table is full, so this insert grows it while the argument refers to an entry.
+    CHECK(table.insert("i", table[table.lookup("a")]));
+    CHECK(table.size() == 9);
+    CHECK(table[table.lookup("i")] == std::string(100, 'a'));
+    CHECK(table[table.lookup("a")] == std::string(100, 'a'));
+}
@@ -44,6 +44,10 @@ TEST_CASE("engine_digits")
     auto zero_zero_seven = engine_matches<engine>("007");
     CHECK(zero_zero_seven);
     CHECK(zero_zero_seven.count == 3);
+
+    auto many = engine_matches<engine>("1234567890123456789012345678901234567890.5");
+    CHECK(many);
+    CHECK(many.count == 40);
 }
 
 TEST_CASE("engine_digits_sep")
@@ -7,6 +7,7 @@
 #include "verify.hpp"
 #include <lexy/_detail/nttp_string.hpp>
 #include <lexy/engine/literal.hpp>
+#include <string>
 
 namespace
 {
@@ -96,5 +97,17 @@ TEST_CASE("engine_find_before")
     CHECK(!limited);
     CHECK(limited.count == 2);
     CHECK(limited.ec == engine::error_code::not_found_limit);
+
+    // Long enough to skip vectors at once.
+    auto long_str = std::string(40, '-') + "a-" + std::string(30, '+');
+
+    auto long_found = engine_matches<engine>((long_str + "ab!").c_str());
+    CHECK(long_found);
+    CHECK(long_found.count == long_str.size());
+
+    auto long_limited = engine_matches<engine>((long_str + "!ab").c_str());
+    CHECK(!long_limited);
+    CHECK(long_limited.count == long_str.size());
+    CHECK(long_limited.ec == engine::error_code::not_found_limit);
 }
 
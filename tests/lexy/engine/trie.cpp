@@ -17,6 +17,18 @@ constexpr auto trie_linear       = lexy::trie<char, LEXY_NTTP_STRING(""), LEXY_N
                                         LEXY_NTTP_STRING("ab"), LEXY_NTTP_STRING("abc")>;
 constexpr auto trie_disjoint
     = lexy::trie<char, LEXY_NTTP_STRING("abc"), LEXY_NTTP_STRING("bcd"), LEXY_NTTP_STRING("cde")>;
+// The root node has enough transitions to use a table.
+constexpr auto trie_dense
+    = lexy::trie<char, LEXY_NTTP_STRING("a"), LEXY_NTTP_STRING("b"), LEXY_NTTP_STRING("c"),
+                 LEXY_NTTP_STRING("d"), LEXY_NTTP_STRING("e"), LEXY_NTTP_STRING("f"),
+                 LEXY_NTTP_STRING("g"), LEXY_NTTP_STRING("h"), LEXY_NTTP_STRING("ij"),
+                 LEXY_NTTP_STRING("\xFF")>;
+// Same, but one transition is not a single byte.
+constexpr auto trie_dense_u
+    = lexy::trie<char16_t, LEXY_NTTP_STRING(u"a"), LEXY_NTTP_STRING(u"b"), LEXY_NTTP_STRING(u"c"),
+                 LEXY_NTTP_STRING(u"d"), LEXY_NTTP_STRING(u"e"), LEXY_NTTP_STRING(u"f"),
+                 LEXY_NTTP_STRING(u"g"), LEXY_NTTP_STRING(u"h"), LEXY_NTTP_STRING(u"ij"),
+                 LEXY_NTTP_STRING(u"\u0100")>;
 } // namespace
 
 TEST_CASE("engine_trie")
@@ -181,5 +193,70 @@ TEST_CASE("engine_trie")
         CHECK(cde.count == 3);
         CHECK(cde.value == 2);
     }
-}
+    SUBCASE("dense")
+    {
+        using engine = lexy::engine_trie<trie_dense>;
+        CHECK(lexy::engine_is_matcher<engine>);
+        CHECK(lexy::engine_is_parser<engine>);
 
+        auto empty = parse(engine{}, "");
+        CHECK(!empty);
+        CHECK(empty.count == 0);
+        CHECK(empty.value == trie_dense.invalid_value);
+
+        auto a = parse(engine{}, "a");
+        CHECK(a);
+        CHECK(a.count == 1);
+        CHECK(a.value == 0);
+        auto h = parse(engine{}, "hi");
+        CHECK(h);
+        CHECK(h.count == 1);
+        CHECK(h.value == 7);
+        auto ij = parse(engine{}, "ijk");
+        CHECK(ij);
+        CHECK(ij.count == 2);
+        CHECK(ij.value == 8);
+        auto ff = parse(engine{}, "\xFF");
+        CHECK(ff);
+        CHECK(ff.count == 1);
+        CHECK(ff.value == 9);
+
+        auto i = parse(engine{}, "i");
+        CHECK(!i);
+        CHECK(i.count == 1);
+        CHECK(i.value == trie_dense.invalid_value);
+        auto z = parse(engine{}, "z");
+        CHECK(!z);
+        CHECK(z.count == 0);
+        CHECK(z.value == trie_dense.invalid_value);
+    }
+    SUBCASE("dense, not bytes")
+    {
+        using engine = lexy::engine_trie<trie_dense_u>;
+        CHECK(lexy::engine_is_matcher<engine>);
+        CHECK(lexy::engine_is_parser<engine>);
+
+        auto empty = parse(engine{}, u"");
+        CHECK(!empty);
+        CHECK(empty.count == 0);
+        CHECK(empty.value == trie_dense_u.invalid_value);
+
+        auto a = parse(engine{}, u"a");
+        CHECK(a);
+        CHECK(a.count == 1);
+        CHECK(a.value == 0);
+        auto ij = parse(engine{}, u"ijk");
+        CHECK(ij);
+        CHECK(ij.count == 2);
+        CHECK(ij.value == 8);
+        auto wide = parse(engine{}, u"\u0100");
+        CHECK(wide);
+        CHECK(wide.count == 1);
+        CHECK(wide.value == 9);
+
+        auto wide_byte = parse(engine{}, u"\u0161");
+        CHECK(!wide_byte);
+        CHECK(wide_byte.count == 0);
+        CHECK(wide_byte.value == trie_dense_u.invalid_value);
+    }
+}
@@ -6,12 +6,17 @@
 
 #include "verify.hpp"
 #include <lexy/_detail/nttp_string.hpp>
+#include <lexy/engine/eof.hpp>
 #include <lexy/engine/literal.hpp>
+#include <lexy/engine/trie.hpp>
+#include <string>
 
 namespace
 {
 constexpr auto trie_ab = lexy::linear_trie<LEXY_NTTP_STRING("ab")>;
-}
+
+constexpr auto trie_newline = lexy::trie<char, LEXY_NTTP_STRING("\n"), LEXY_NTTP_STRING("\r\n")>;
+} // namespace
 
 TEST_CASE("engine_until")
 {
@@ -84,3 +89,32 @@ TEST_CASE("engine_until_eof")
     CHECK(partial_end.count == 4);
 }
 
+TEST_CASE("engine_until first characters")
+{
+    using literal = lexy::engine_literal<trie_ab>;
+    CHECK(lexy::_engine_first_chars<literal>.is_ascii());
+    CHECK(lexy::_engine_first_chars<literal>.size() == 1);
+    CHECK(lexy::_engine_first_chars<literal>.contains('a'));
+
+    using newline = lexy::engine_trie<trie_newline>;
+    CHECK(lexy::_engine_first_chars<newline>.size() == 2);
+    CHECK(lexy::_engine_first_chars<newline>.contains('\n'));
+    CHECK(lexy::_engine_first_chars<newline>.contains('\r'));
+
+    CHECK(lexy::_engine_first_chars<literal, lexy::engine_eof>.size() == 1);
+
+    // Long enough to skip vectors at once.
+    auto str = std::string(40, '-') + "a-" + std::string(30, '+') + "\r-\r\n" + "--ab";
+
+    auto lit = engine_matches<lexy::engine_until<literal>>(str.c_str());
+    CHECK(lit);
+    CHECK(lit.count == str.size());
+
+    auto nl = engine_matches<lexy::engine_until<newline>>(str.c_str());
+    CHECK(nl);
+    CHECK(nl.count == str.size() - 4);
+
+    auto eof = engine_matches<lexy::engine_until_eof<newline>>(str.c_str(), 40);
+    CHECK(eof);
+    CHECK(eof.count == 40);
+}
@@ -5,13 +5,18 @@
 #include <lexy/engine/while.hpp>
 
 #include "verify.hpp"
+#include <lexy/_detail/ascii_table.hpp>
 #include <lexy/_detail/nttp_string.hpp>
+#include <lexy/engine/char_class.hpp>
 #include <lexy/engine/literal.hpp>
+#include <string>
 
 namespace
 {
 constexpr auto trie = lexy::linear_trie<LEXY_NTTP_STRING("ab")>;
-}
+
+constexpr auto space_trie = lexy::shallow_trie<LEXY_NTTP_STRING(" \t")>;
+} // namespace
 
 TEST_CASE("engine_while")
 {
@@ -38,3 +43,29 @@ TEST_CASE("engine_while")
     CHECK(partial.count == 2);
 }
 
+TEST_CASE("engine_while char class")
+{
+    // Long enough to skip vectors at once.
+    auto str = std::string("ab_c") + std::string(50, 'x') + "1 ";
+
+    using table_engine = lexy::engine_while<
+        lexy::engine_ascii_table<lexy::_detail::dsl_ascii_table,
+                                 lexy::_detail::ascii_table_alpha_underscore>>;
+    auto table = engine_matches<table_engine>(str.c_str());
+    CHECK(table);
+    CHECK(table.count == str.size() - 2);
+
+    using range_engine = lexy::engine_while<lexy::engine_char_range<'a', 'z'>>;
+    auto range         = engine_matches<range_engine>(str.c_str());
+    CHECK(range);
+    CHECK(range.count == 2);
+
+    using set_engine = lexy::engine_while<lexy::engine_char_set<space_trie>>;
+    auto set         = engine_matches<set_engine>(" \t \t\t  ");
+    CHECK(set);
+    CHECK(set.count == 7);
+
+    auto wide = engine_matches<table_engine>(u"abc\u00E4");
+    CHECK(wide);
+    CHECK(wide.count == 3);
+}
@@ -5,6 +5,7 @@
 #include <lexy/input/base.hpp>
 
 #include <doctest/doctest.h>
+#include <lexy/input/argv_input.hpp>
 #include <lexy/input/string_input.hpp>
 
 TEST_CASE("partial_reader()")
@@ -24,5 +25,46 @@ TEST_CASE("partial_reader()")
     partial.bump();
     CHECK(partial.peek() == lexy::default_encoding::eof());
     CHECK(partial.eof());
+
+    SUBCASE("contiguous")
+    {
+        auto reader = lexy::partial_reader(input.reader(), end);
+        CHECK(lexy::_is_contiguous_reader<decltype(reader)>);
+        CHECK(reader.remaining().data() == input.data());
+        CHECK(reader.remaining().size() == 2);
+
+        reader.bump(2);
+        CHECK(reader.cur() == end);
+        CHECK(reader.eof());
+        CHECK(reader.remaining().empty());
+    }
+}
+
+TEST_CASE("range_reader")
+{
+    auto input  = lexy::zstring_input("abc");
+    auto reader = input.reader();
+    CHECK(lexy::_is_contiguous_reader<decltype(reader)>);
+
+    CHECK(reader.remaining().data() == input.data());
+    CHECK(reader.remaining().size() == 3);
+
+    reader.bump(1);
+    CHECK(reader.peek() == 'b');
+    CHECK(reader.remaining().size() == 2);
+
+    reader.bump(2);
+    CHECK(reader.eof());
+    CHECK(reader.remaining().empty());
+
+    SUBCASE("not contiguous")
+    {
+        using argv_reader = lexy::input_reader<lexy::argv_input<>>;
+        CHECK(!lexy::_is_contiguous_reader<argv_reader>);
+
+        using partial_argv_reader
+            = decltype(lexy::partial_reader(LEXY_DECLVAL(argv_reader), lexy::argv_iterator()));
+        CHECK(!lexy::_is_contiguous_reader<partial_argv_reader>);
+    }
 }
 
@@ -4,7 +4,9 @@
 
 #include <lexy/input/buffer.hpp>
 
+#include <cstdint>
 #include <doctest/doctest.h>
+#include <string>
 
 #if defined(__has_include) && __has_include(<memory_resource>)
 #    include <memory_resource>
@@ -247,6 +249,72 @@ TEST_CASE("buffer")
         CHECK(reader.peek() == lexy::default_encoding::eof());
         CHECK(reader.eof());
     }
+    SUBCASE("reader, contiguous")
+    {
+        const lexy::buffer<lexy::utf16_encoding> no_sentinel(u"abc", 3);
+        auto                                     no_sentinel_reader = no_sentinel.reader();
+        CHECK(lexy::_is_contiguous_reader<decltype(no_sentinel_reader)>);
+        CHECK(no_sentinel_reader.remaining().data() == no_sentinel.data());
+        CHECK(no_sentinel_reader.remaining().size() == 3);
+
+        no_sentinel_reader.bump(3);
+        CHECK(no_sentinel_reader.eof());
+        CHECK(no_sentinel_reader.remaining().empty());
+
+        const lexy::buffer<lexy::ascii_encoding> sentinel(str, 3);
+        auto                                     sentinel_reader = sentinel.reader();
+        CHECK(lexy::_is_contiguous_reader<decltype(sentinel_reader)>);
+        CHECK(sentinel_reader.remaining().data() == sentinel.data());
+        CHECK(sentinel_reader.remaining().size() == 3);
+
+        // The sentinel is not part of the remaining characters.
+        sentinel_reader.bump(3);
+        CHECK(sentinel_reader.eof());
+        CHECK(sentinel_reader.remaining().empty());
+    }
+    SUBCASE("reader, empty")
+    {
+        const lexy::buffer<lexy::utf16_encoding> no_sentinel;
+        CHECK(no_sentinel.reader().eof());
+        CHECK(no_sentinel.reader().peek() == lexy::utf16_encoding::eof());
+
+        const lexy::buffer<lexy::utf8_encoding> sentinel;
+        CHECK(sentinel.reader().eof());
+        CHECK(sentinel.reader().peek() == lexy::utf8_encoding::eof());
+    }
+
+    SUBCASE("alignment and padding")
+    {
+        auto check = [](const auto& buffer) {
+            using buffer_type = std::decay_t<decltype(buffer)>;
+            using char_type   = typename buffer_type::char_type;
+
+            auto address = reinterpret_cast<std::uintptr_t>(buffer.data());
+            CHECK(address % buffer_type::alignment == 0);
+
+            auto padding = reinterpret_cast<const unsigned char*>(buffer.data() + buffer.size());
+            auto offset  = std::is_same_v<char_type, typename buffer_type::encoding::int_type>
+                               ? sizeof(char_type)
+                               : 0u;
+            auto zero    = true;
+            for (auto i = offset; i != buffer_type::padding; ++i)
+                zero = zero && padding[i] == 0;
+            CHECK(zero);
+        };
+
+        for (auto size : {0u, 1u, 3u, 64u, 100u})
+        {
+            const std::u32string data(size, U'a');
+
+            check(lexy::buffer<lexy::default_encoding>(str, size < 3 ? size : 3));
+            check(lexy::buffer<lexy::utf16_encoding>(std::u16string(size, u'a')));
+            check(lexy::buffer<lexy::utf32_encoding>(data));
+            check(lexy::buffer<lexy::utf32_encoding>::builder(size).finish());
+
+            const lexy::buffer<lexy::utf32_encoding> sentinel(data);
+            CHECK(sentinel.data()[size] == lexy::utf32_encoding::eof());
+        }
+    }
 }
 
 TEST_CASE("make_buffer")
@@ -430,5 +498,200 @@ TEST_CASE("make_buffer")
         CHECK(big_bom.size() == 1);
         CHECK(big_bom.data()[0] == 0x00112233);
     }
+    SUBCASE("long input")
+    {
+        // Long enough for the vectorized loops plus a remainder.
+        unsigned char long_str[4 * 37];
+        for (auto i = 0u; i != sizeof(long_str); ++i)
+            long_str[i] = static_cast<unsigned char>(i);
+
+        auto utf16
+            = lexy::make_buffer_from_raw<lexy::utf16_encoding,
+                                         lexy::encoding_endianness::big>(long_str,
+                                                                         sizeof(long_str));
+        REQUIRE(utf16.size() == 2 * 37);
+        for (auto i = 0u; i != utf16.size(); ++i)
+            CHECK(utf16.data()[i] == ((2 * i) << 8 | (2 * i + 1)));
+
+        auto utf32
+            = lexy::make_buffer_from_raw<lexy::utf32_encoding,
+                                         lexy::encoding_endianness::little>(long_str,
+                                                                            sizeof(long_str));
+        REQUIRE(utf32.size() == 37);
+        for (auto i = 0u; i != utf32.size(); ++i)
+            CHECK(utf32.data()[i]
+                  == ((4 * i + 3) << 24 | (4 * i + 2) << 16 | (4 * i + 1) << 8 | 4 * i));
+    }
+    SUBCASE("in place")
+    {
+        lexy::buffer<lexy::utf16_encoding>::builder builder(37);
+        auto bytes = reinterpret_cast<unsigned char*>(builder.data());
+        for (auto i = 0u; i != 2 * 37; ++i)
+            bytes[i] = static_cast<unsigned char>(i);
+        auto raw  = LEXY_MOV(builder).finish();
+        auto data = raw.data();
+
+        auto big = lexy::make_buffer_from_raw<lexy::utf16_encoding,
+                                              lexy::encoding_endianness::big>(LEXY_MOV(raw));
+        CHECK(big.data() == data);
+        REQUIRE(big.size() == 37);
+        for (auto i = 0u; i != big.size(); ++i)
+            CHECK(big.data()[i] == ((2 * i) << 8 | (2 * i + 1)));
+
+        auto little = lexy::make_buffer_from_raw<lexy::utf16_encoding,
+                                                 lexy::encoding_endianness::little>(LEXY_MOV(big));
+        CHECK(little.data() == data);
+        for (auto i = 0u; i != little.size(); ++i)
+            CHECK(little.data()[i] == ((2 * i) << 8 | (2 * i + 1)));
+    }
 }
 
+TEST_CASE("make_buffer_transcoded")
+{
+    SUBCASE("UTF-16 to UTF-8")
+    {
+        auto empty
+            = lexy::make_buffer_transcoded<lexy::utf16_encoding, lexy::utf8_encoding>(u"", 0);
+        REQUIRE(empty);
+        CHECK(empty.buffer().size() == 0);
+
+        auto result = lexy::make_buffer_transcoded<lexy::utf16_encoding,
+                                                   lexy::utf8_encoding>(u"aä€\U0001F600", 5);
+        REQUIRE(result);
+        CHECK(result.buffer().size() == 1 + 2 + 3 + 4);
+
+        auto str = reinterpret_cast<const char*>(result.buffer().data());
+        CHECK(std::string(str, result.buffer().size()) == "aä€\U0001F600");
+    }
+    SUBCASE("UTF-32 to UTF-8")
+    {
+        auto result = lexy::make_buffer_transcoded<lexy::utf32_encoding,
+                                                   lexy::utf8_encoding>(U"aä€\U0001F600", 4);
+        REQUIRE(result);
+
+        auto str = reinterpret_cast<const char*>(result.buffer().data());
+        CHECK(std::string(str, result.buffer().size()) == "aä€\U0001F600");
+    }
+    SUBCASE("UTF-16 to UTF-32")
+    {
+        auto result = lexy::make_buffer_transcoded<lexy::utf16_encoding,
+                                                   lexy::utf32_encoding>(u"aä€\U0001F600", 5);
+        REQUIRE(result);
+        REQUIRE(result.buffer().size() == 4);
+        CHECK(result.buffer().data()[0] == U'a');
+        CHECK(result.buffer().data()[1] == U'ä');
+        CHECK(result.buffer().data()[2] == U'€');
+        CHECK(result.buffer().data()[3] == U'\U0001F600');
+    }
+    SUBCASE("UTF-32 to UTF-16")
+    {
+        auto result = lexy::make_buffer_transcoded<lexy::utf32_encoding,
+                                                   lexy::utf16_encoding>(U"aä€\U0001F600", 4);
+        REQUIRE(result);
+        REQUIRE(result.buffer().size() == 5);
+        CHECK(result.buffer().data()[0] == u'a');
+        CHECK(result.buffer().data()[1] == u'ä');
+        CHECK(result.buffer().data()[2] == u'€');
+        CHECK(result.buffer().data()[3] == 0xD83D);
+        CHECK(result.buffer().data()[4] == 0xDE00);
+    }
+    SUBCASE("secondary char type")
+    {
+        using wide_encoding = std::conditional_t<sizeof(wchar_t) == sizeof(char16_t),
+                                                 lexy::utf16_encoding, lexy::utf32_encoding>;
+
+        auto result = lexy::make_buffer_transcoded<wide_encoding, lexy::utf8_encoding>(L"abc", 3);
+        REQUIRE(result);
+        CHECK(result.buffer().size() == 3);
+        CHECK(result.buffer().data()[2] == 'c');
+    }
+    SUBCASE("malformed UTF-16")
+    {
+        auto check_error = [](std::initializer_list<char16_t> str, std::size_t offset) {
+            auto result = lexy::make_buffer_transcoded<lexy::utf16_encoding,
+                                                       lexy::utf8_encoding>(str.begin(),
+                                                                            str.size());
+            CHECK(!result);
+            CHECK(result.error_offset() == offset);
+        };
+
+        check_error({'a', 'b', 0xD83D, 'c'}, 2);        // Unpaired leading surrogate.
+        check_error({'a', 'b', 0xDE00, 'c'}, 2);        // Unpaired trailing surrogate.
+        check_error({'a', 'b', 0xD83D}, 2);             // Leading surrogate at the end.
+        check_error({'a', 0xD83D, 0xDE00, 0xDE00}, 3); // After a valid surrogate pair.
+    }
+    SUBCASE("malformed UTF-32")
+    {
+        auto check_error = [](std::initializer_list<char32_t> str, std::size_t offset) {
+            auto result = lexy::make_buffer_transcoded<lexy::utf32_encoding,
+                                                       lexy::utf16_encoding>(str.begin(),
+                                                                             str.size());
+            CHECK(!result);
+            CHECK(result.error_offset() == offset);
+        };
+
+        check_error({'a', 'b', 0xD83D, 'c'}, 2);   // Surrogate.
+        check_error({'a', 'b', 0x110000, 'c'}, 2); // Out of range.
+    }
+    SUBCASE("long input")
+    {
+        // Long enough to cover the ASCII blocks with non-ASCII characters at every position.
+        std::u32string code_points;
+        for (auto i = 0u; i != 200; ++i)
+        {
+            if (i % 37 == 5)
+                code_points.push_back(U'ä');
+            else if (i % 41 == 7)
+                code_points.push_back(U'\U0001F600');
+            else
+                code_points.push_back(char32_t('a' + i % 26));
+        }
+
+        for (auto size = 0u; size != code_points.size(); ++size)
+        {
+            INFO(size);
+
+            std::u16string utf16;
+            std::string    utf8;
+            for (auto i = 0u; i != size; ++i)
+            {
+                auto cp = lexy::code_point(code_points[i]);
+
+                char16_t utf16_buffer[2];
+                auto     utf16_size = lexy::_detail::encode_code_point<
+                    lexy::utf16_encoding>::encode(cp, utf16_buffer, 2);
+                utf16.append(utf16_buffer, utf16_size);
+
+                LEXY_CHAR8_T utf8_buffer[4];
+                auto         utf8_size
+                    = lexy::_detail::encode_code_point<lexy::utf8_encoding>::encode(cp, utf8_buffer,
+                                                                                    4);
+                utf8.append(reinterpret_cast<const char*>(utf8_buffer), utf8_size);
+            }
+
+            auto from_utf16 = lexy::make_buffer_transcoded<lexy::utf16_encoding,
+                                                           lexy::utf8_encoding>(utf16.data(),
+                                                                                utf16.size());
+            REQUIRE(from_utf16);
+            CHECK(std::string(reinterpret_cast<const char*>(from_utf16.buffer().data()),
+                              from_utf16.buffer().size())
+                  == utf8);
+
+            auto from_utf32 = lexy::make_buffer_transcoded<lexy::utf32_encoding,
+                                                           lexy::utf8_encoding>(code_points.data(),
+                                                                                size);
+            REQUIRE(from_utf32);
+            CHECK(std::string(reinterpret_cast<const char*>(from_utf32.buffer().data()),
+                              from_utf32.buffer().size())
+                  == utf8);
+
+            // Append a leading surrogate without a trailing one.
+            auto broken = utf16 + u'\xD800';
+            auto result = lexy::make_buffer_transcoded<lexy::utf16_encoding,
+                                                       lexy::utf8_encoding>(broken.data(),
+                                                                            broken.size());
+            REQUIRE(!result);
+            CHECK(result.error_offset() == utf16.size());
+        }
+    }
+}
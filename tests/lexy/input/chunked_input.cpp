@@ -0,0 +1,211 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <lexy/input/chunked_input.hpp>
+
+#include <doctest/doctest.h>
+#include <lexy/_detail/nttp_string.hpp>
+#include <lexy/action/match.hpp>
+#include <lexy/dsl/ascii.hpp>
+#include <lexy/dsl/eof.hpp>
+#include <lexy/dsl/identifier.hpp>
+#include <lexy/dsl/literal.hpp>
+#include <lexy/dsl/sequence.hpp>
+#include <lexy/engine/any.hpp>
+#include <lexy/engine/char_class.hpp>
+#include <lexy/engine/literal.hpp>
+#include <lexy/engine/while.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+constexpr auto trie_abc = lexy::linear_trie<LEXY_NTTP_STRING("abc")>;
+
+struct production
+{
+    static constexpr auto rule = LEXY_LIT("ab") + lexy::dsl::identifier(lexy::dsl::ascii::alpha)
+                                 + lexy::dsl::eof;
+};
+
+// Splits the string into chunks at the specified positions.
+std::vector<std::string_view> split(std::string_view str, std::initializer_list<std::size_t> at)
+{
+    std::vector<std::string_view> result;
+
+    auto pos = std::size_t(0);
+    for (auto next : at)
+    {
+        result.push_back(str.substr(pos, next - pos));
+        pos = next;
+    }
+    result.push_back(str.substr(pos));
+
+    return result;
+}
+
+template <typename Reader>
+std::string read_all(Reader reader)
+{
+    std::string result;
+    while (!reader.eof())
+    {
+        result.push_back(static_cast<char>(reader.peek()));
+        reader.bump();
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE("chunked_iterator")
+{
+    // Includes empty chunks at the beginning, in the middle and at the end.
+    auto chunks = split("abcdef", {0, 2, 2, 3, 6});
+    auto input  = lexy::chunked_input(chunks);
+    using iterator = typename decltype(input)::iterator;
+
+    auto iter = input.begin();
+    REQUIRE(!iter.is_end());
+    REQUIRE(*iter == 'a');
+
+    auto positions = std::vector<iterator>{iter};
+    for (auto c : std::string_view("bcdef"))
+    {
+        ++iter;
+        REQUIRE(!iter.is_end());
+        REQUIRE(*iter == c);
+        positions.push_back(iter);
+    }
+
+    ++iter;
+    REQUIRE(iter.is_end());
+    CHECK(iter != positions.back());
+
+    for (auto c : std::string_view("fedcba"))
+    {
+        --iter;
+        REQUIRE(*iter == c);
+    }
+    CHECK(iter == input.begin());
+
+    SUBCASE("empty")
+    {
+        auto empty_chunks = split("", {0, 0});
+        auto empty        = lexy::chunked_input(empty_chunks);
+        CHECK(empty.begin().is_end());
+        CHECK(empty.reader().eof());
+
+        auto no_chunks = lexy::chunked_input<lexy::default_encoding, std::string_view>();
+        CHECK(no_chunks.begin().is_end());
+        CHECK(no_chunks.reader().eof());
+    }
+}
+
+TEST_CASE("chunked_input")
+{
+    auto chunks = split("abcdefgh", {3, 3, 5});
+
+    SUBCASE("constructors")
+    {
+        auto from_pointer = lexy::chunked_input(chunks.data(), chunks.size());
+        CHECK(std::is_same_v<decltype(from_pointer),
+                             lexy::chunked_input<lexy::default_encoding, std::string_view>>);
+        CHECK(read_all(from_pointer.reader()) == "abcdefgh");
+
+        auto from_container = lexy::chunked_input(chunks);
+        CHECK(std::is_same_v<decltype(from_container), decltype(from_pointer)>);
+        CHECK(read_all(from_container.reader()) == "abcdefgh");
+
+        auto secondary = lexy::chunked_input<lexy::utf8_encoding, std::string_view>(chunks);
+        auto reader    = secondary.reader();
+        CHECK(reader.peek() == 'a');
+    }
+    SUBCASE("reader")
+    {
+        auto input  = lexy::chunked_input(chunks);
+        auto reader = input.reader();
+        CHECK(lexy::is_canonical_reader<decltype(reader)>);
+
+        CHECK(std::string(reader.remaining().begin(), reader.remaining().end()) == "abc");
+        reader.bump(2);
+        CHECK(reader.peek() == 'c');
+        CHECK(std::string(reader.remaining().begin(), reader.remaining().end()) == "c");
+
+        // Bumping to the end of the chunk goes to the next non-empty one.
+        reader.bump(1);
+        CHECK(reader.peek() == 'd');
+        CHECK(std::string(reader.remaining().begin(), reader.remaining().end()) == "de");
+
+        auto begin = input.begin();
+        auto lexeme
+            = lexy::lexeme_for<decltype(input)>(begin, lexy::_detail::next(begin, 4));
+        CHECK(std::string(lexeme.begin(), lexeme.end()) == "abcd");
+
+        reader.bump(2);
+        reader.bump(3);
+        CHECK(reader.eof());
+        CHECK(reader.peek() == lexy::default_encoding::eof());
+        CHECK(reader.remaining().empty());
+    }
+    SUBCASE("parse")
+    {
+        auto input = lexy::chunked_input(chunks);
+        CHECK(lexy::match<production>(input));
+
+        auto other_chunks = split("ab123", {1, 3});
+        CHECK(!lexy::match<production>(lexy::chunked_input(other_chunks)));
+    }
+    SUBCASE("engine_any")
+    {
+        auto input  = lexy::chunked_input(chunks);
+        auto reader = input.reader();
+        reader.bump();
+
+        lexy::engine_any::match(reader);
+        CHECK(reader.eof());
+    }
+    SUBCASE("engine_while")
+    {
+        auto str_chunks = split("abcdefgh12", {3, 3, 5, 8});
+        auto input      = lexy::chunked_input(str_chunks);
+        auto reader     = input.reader();
+
+        lexy::engine_while<lexy::engine_char_range<'a', 'z'>>::match(reader);
+        CHECK(reader.peek() == '1');
+        CHECK(std::string(reader.remaining().begin(), reader.remaining().end()) == "12");
+    }
+    SUBCASE("engine_literal")
+    {
+        using engine = lexy::engine_literal<trie_abc>;
+
+        // Try every position of the chunk boundaries.
+        for (auto first = 0u; first <= 4; ++first)
+            for (auto second = first; second <= 4; ++second)
+            {
+                INFO(first);
+                INFO(second);
+
+                auto match = [&](std::string_view str) {
+                    auto str_chunks = split(str, {first < str.size() ? first : str.size(),
+                                                  second < str.size() ? second : str.size()});
+                    auto input      = lexy::chunked_input(str_chunks);
+                    auto reader     = input.reader();
+
+                    auto ec    = engine::match(reader);
+                    auto count = std::size_t(0);
+                    for (auto iter = input.begin(); iter != reader.cur(); ++iter)
+                        ++count;
+                    return std::make_pair(ec, count);
+                };
+
+                CHECK(match("abc") == std::make_pair(engine::error_code(), std::size_t(3)));
+                CHECK(match("abcd") == std::make_pair(engine::error_code(), std::size_t(3)));
+                CHECK(match("") == std::make_pair(engine::index_to_error(0), std::size_t(0)));
+                CHECK(match("ab") == std::make_pair(engine::index_to_error(2), std::size_t(2)));
+                CHECK(match("abd") == std::make_pair(engine::index_to_error(2), std::size_t(2)));
+                CHECK(match("xbcd") == std::make_pair(engine::index_to_error(0), std::size_t(0)));
+            }
+    }
+}
@@ -5,8 +5,20 @@
 #undef LEXY_DISABLE_FILE
 #include <lexy/input/file.hpp>
 
+#include <array>
 #include <cstdio>
 #include <doctest/doctest.h>
+#include <lexy/action/match.hpp>
+#include <lexy/dsl/eof.hpp>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <sys/wait.h>
+#    include <unistd.h>
+#    define LEXY_HAS_FD 1
+#else
+#    define LEXY_HAS_FD 0
+#endif
 
 #if defined(__has_include) && __has_include(<memory_resource>)
 #    include <memory_resource>
@@ -25,6 +37,11 @@ void write_test_data(const char* data)
     std::fputs(data, file);
     std::fclose(file);
 }
+
+struct eof_production
+{
+    static constexpr auto rule = lexy::dsl::eof;
+};
 } // namespace
 
 TEST_CASE("read_file")
@@ -213,6 +230,303 @@ TEST_CASE("read_file")
         CHECK(reader.peek() == lexy::utf16_encoding::eof());
         CHECK(reader.eof());
     }
+    SUBCASE("medium file with BOM")
+    {
+        {
+            auto file = std::fopen(test_file_name, "wb");
+            std::fputs("\xEF\xBB\xBF", file);
+            for (auto i = 0; i != 10 * 1024; ++i)
+                std::fputc('a', file);
+            for (auto i = 0; i != 10 * 1024; ++i)
+                std::fputc('b', file);
+            std::fclose(file);
+        }
+
+        auto result = lexy::read_file<lexy::utf8_encoding>(test_file_name);
+        REQUIRE(result);
+        CHECK(result.buffer().size() == 20 * 1024);
+
+        auto reader = result.buffer().reader();
+        for (auto i = 0; i != 10 * 1024; ++i)
+        {
+            CHECK(reader.peek() == 'a');
+            reader.bump();
+        }
+        for (auto i = 0; i != 10 * 1024; ++i)
+        {
+            CHECK(reader.peek() == 'b');
+            reader.bump();
+        }
+
+        CHECK(reader.peek() == lexy::utf8_encoding::eof());
+        CHECK(reader.eof());
+    }
+    SUBCASE("medium file in either byte order")
+    {
+        auto write = [](bool swap) {
+            auto file = std::fopen(test_file_name, "wb");
+            for (auto i = 0; i != 10 * 1024; ++i)
+            {
+                // BOM followed by the code units 0 to 10 * 1024 - 2.
+                auto unit = i == 0 ? char16_t(0xFEFF) : char16_t(i - 1);
+                if (swap)
+                    unit = char16_t((unit >> 8) | (unit << 8));
+                std::fwrite(&unit, sizeof(unit), 1, file);
+            }
+            std::fclose(file);
+        };
+        auto check = [] {
+            auto result = lexy::read_file<lexy::utf16_encoding>(test_file_name);
+            REQUIRE(result);
+            CHECK(result.buffer().size() == 10 * 1024 - 1);
+
+            auto reader = result.buffer().reader();
+            for (auto i = 0; i != 10 * 1024 - 1; ++i)
+            {
+                CHECK(reader.peek() == i);
+                reader.bump();
+            }
+            CHECK(reader.peek() == lexy::utf16_encoding::eof());
+            CHECK(reader.eof());
+        };
+
+        write(false);
+        check();
+
+        write(true);
+        check();
+    }
+
+    std::remove(test_file_name);
+}
+
+TEST_CASE("read_file_options")
+{
+    std::remove(test_file_name);
+
+    auto all_options = [] {
+        auto make = [](lexy::read_file_strategy strategy, std::size_t small_file_size,
+                       std::size_t medium_file_size) {
+            lexy::read_file_options options;
+            options.strategy         = strategy;
+            options.small_file_size  = small_file_size;
+            options.medium_file_size = medium_file_size;
+            return options;
+        };
+
+        return std::array{make(lexy::read_file_strategy::automatic, 4 * 1024, 32 * 1024),
+                          make(lexy::read_file_strategy::automatic, 0, 1024 * 1024),
+                          make(lexy::read_file_strategy::read, 4 * 1024, 0),
+                          make(lexy::read_file_strategy::pread, 1024, 0),
+                          make(lexy::read_file_strategy::mmap, 4 * 1024, 0),
+                          make(lexy::read_file_strategy::direct, 4 * 1024, 0)};
+    }();
+
+    SUBCASE("non-existing file")
+    {
+        for (auto options : all_options)
+        {
+            INFO(int(options.strategy));
+
+            auto result = lexy::read_file(test_file_name, options);
+            CHECK(!result);
+            CHECK(result.error() == lexy::file_error::file_not_found);
+        }
+    }
+    SUBCASE("empty file")
+    {
+        write_test_data("");
+
+        for (auto options : all_options)
+        {
+            INFO(int(options.strategy));
+
+            auto result = lexy::read_file(test_file_name, options);
+            REQUIRE(result);
+            CHECK(result.buffer().size() == 0);
+        }
+    }
+    SUBCASE("tiny file with BOM")
+    {
+        write_test_data("\xEF\xBB\xBF"
+                        "abc");
+
+        for (auto options : all_options)
+        {
+            INFO(int(options.strategy));
+
+            auto result = lexy::read_file<lexy::utf8_encoding>(test_file_name, options);
+            REQUIRE(result);
+            CHECK(result.buffer().size() == 3);
+
+            auto reader = result.buffer().reader();
+            CHECK(reader.peek() == 'a');
+            reader.bump();
+            CHECK(reader.peek() == 'b');
+            reader.bump();
+            CHECK(reader.peek() == 'c');
+            reader.bump();
+            CHECK(reader.peek() == lexy::utf8_encoding::eof());
+        }
+    }
+    SUBCASE("big file")
+    {
+        // Bigger than the chunks used by O_DIRECT and not a multiple of the page size.
+        constexpr auto size = 3 * 1024 * 1024 / 2 + 11;
+        {
+            auto file = std::fopen(test_file_name, "wb");
+            for (auto i = 0; i != size; ++i)
+                std::fputc('a' + i % 26, file);
+            std::fclose(file);
+        }
+
+        for (auto options : all_options)
+        {
+            INFO(int(options.strategy));
+
+            auto result = lexy::read_file(test_file_name, options);
+            REQUIRE(result);
+            REQUIRE(result.buffer().size() == size);
+
+            auto correct = true;
+            for (auto i = 0; i != size; ++i)
+                correct = correct && result.buffer().data()[i] == 'a' + i % 26;
+            CHECK(correct);
+        }
+    }
+    SUBCASE("byte order conversion")
+    {
+        {
+            auto file = std::fopen(test_file_name, "wb");
+            for (auto i = 0; i != 10 * 1024; ++i)
+            {
+                std::fputc(0, file);
+                std::fputc(i % 128, file);
+            }
+            std::fclose(file);
+        }
+
+        for (auto options : all_options)
+        {
+            INFO(int(options.strategy));
+
+            auto result = lexy::read_file<lexy::utf16_encoding,
+                                          lexy::encoding_endianness::big>(test_file_name, options);
+            REQUIRE(result);
+            REQUIRE(result.buffer().size() == 10 * 1024);
+
+            auto correct = true;
+            for (auto i = 0; i != 10 * 1024; ++i)
+                correct = correct && result.buffer().data()[i] == i % 128;
+            CHECK(correct);
+        }
+    }
+
+    std::remove(test_file_name);
+}
+
+TEST_CASE("read_file_transcoded")
+{
+    auto write_test_data = [](std::initializer_list<unsigned char> data) {
+        auto file = std::fopen(test_file_name, "wb");
+        std::fwrite(data.begin(), 1, data.size(), file);
+        std::fclose(file);
+    };
+
+    SUBCASE("non-existing file")
+    {
+        std::remove(test_file_name);
+
+        auto result = lexy::read_file_transcoded<lexy::utf16_encoding, lexy::utf8_encoding>(
+            test_file_name);
+        CHECK(!result);
+        CHECK(result.error() == lexy::file_error::file_not_found);
+    }
+    SUBCASE("little endian BOM")
+    {
+        write_test_data({0xFF, 0xFE, 'a', 0x00, 0xE4, 0x00, 0x3D, 0xD8, 0x00, 0xDE});
+
+        auto result = lexy::read_file_transcoded<lexy::utf16_encoding, lexy::utf8_encoding>(
+            test_file_name);
+        REQUIRE(result);
+        CHECK(std::string(reinterpret_cast<const char*>(result.buffer().data()),
+                          result.buffer().size())
+              == "aä\U0001F600");
+    }
+    SUBCASE("big endian BOM")
+    {
+        write_test_data({0xFE, 0xFF, 0x00, 'a', 0x00, 0xE4, 0xD8, 0x3D, 0xDE, 0x00});
+
+        auto result = lexy::read_file_transcoded<lexy::utf16_encoding, lexy::utf8_encoding>(
+            test_file_name);
+        REQUIRE(result);
+        CHECK(std::string(reinterpret_cast<const char*>(result.buffer().data()),
+                          result.buffer().size())
+              == "aä\U0001F600");
+    }
+    SUBCASE("fixed endianness")
+    {
+        write_test_data({0x00, 0x00, 0x00, 'a', 0x00, 0x00, 0x20, 0xAC});
+
+        auto result
+            = lexy::read_file_transcoded<lexy::utf32_encoding, lexy::utf16_encoding,
+                                         lexy::encoding_endianness::big>(test_file_name);
+        REQUIRE(result);
+        REQUIRE(result.buffer().size() == 2);
+        CHECK(result.buffer().data()[0] == u'a');
+        CHECK(result.buffer().data()[1] == u'€');
+    }
+    SUBCASE("malformed")
+    {
+        write_test_data({0xFF, 0xFE, 'a', 0x00, 0x3D, 0xD8, 'b', 0x00});
+
+        auto result = lexy::read_file_transcoded<lexy::utf16_encoding, lexy::utf8_encoding>(
+            test_file_name);
+        CHECK(!result);
+        CHECK(result.error() == lexy::file_error::invalid_encoding);
+    }
+    SUBCASE("partial code unit")
+    {
+        write_test_data({0xFF, 0xFE, 'a', 0x00, 'b'});
+
+        auto result = lexy::read_file_transcoded<lexy::utf16_encoding, lexy::utf8_encoding>(
+            test_file_name);
+        CHECK(!result);
+        CHECK(result.error() == lexy::file_error::invalid_encoding);
+    }
+    SUBCASE("strategies")
+    {
+        {
+            auto file = std::fopen(test_file_name, "wb");
+            for (auto i = 0; i != 10 * 1024; ++i)
+            {
+                std::fputc(i % 128, file);
+                std::fputc(0, file);
+            }
+            std::fclose(file);
+        }
+
+        for (auto strategy : {lexy::read_file_strategy::automatic, lexy::read_file_strategy::read,
+                              lexy::read_file_strategy::pread, lexy::read_file_strategy::mmap,
+                              lexy::read_file_strategy::direct})
+        {
+            INFO(int(strategy));
+
+            lexy::read_file_options options;
+            options.strategy = strategy;
+
+            auto result = lexy::read_file_transcoded<lexy::utf16_encoding, lexy::utf8_encoding,
+                                                     lexy::encoding_endianness::little>(
+                test_file_name, options);
+            REQUIRE(result);
+            REQUIRE(result.buffer().size() == 10 * 1024);
+
+            auto correct = true;
+            for (auto i = 0; i != 10 * 1024; ++i)
+                correct = correct && result.buffer().data()[i] == i % 128;
+            CHECK(correct);
+        }
+    }
 
     std::remove(test_file_name);
 }
@@ -345,6 +659,267 @@ TEST_CASE("read_stdin")
         CHECK(reader.eof());
     }
 
+#if LEXY_HAS_FD
+    SUBCASE("partially consumed file")
+    {
+        {
+            auto file = std::fopen(test_file_name, "wb");
+            for (auto i = 0; i != 100 * 1024; ++i)
+                std::fputc('a' + i % 26, file);
+            std::fclose(file);
+
+            auto result = std::freopen(test_file_name, "rb", stdin);
+            REQUIRE(result == stdin);
+        }
+        // Not aligned to a page boundary.
+        REQUIRE(::lseek(STDIN_FILENO, 5000, SEEK_SET) == 5000);
+
+        auto result = lexy::read_stdin();
+        REQUIRE(result);
+        REQUIRE(result.buffer().size() == 100 * 1024 - 5000);
+
+        auto correct = true;
+        for (auto i = 5000; i != 100 * 1024; ++i)
+            correct = correct && result.buffer().data()[i - 5000] == 'a' + i % 26;
+        CHECK(correct);
+        CHECK(::lseek(STDIN_FILENO, 0, SEEK_CUR) == 100 * 1024);
+    }
+    SUBCASE("pipe")
+    {
+        // Bigger than the pipe and the first chunks.
+        constexpr auto size = 1024 * 1024 + 11;
+
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+
+        auto pid = ::fork();
+        REQUIRE(pid >= 0);
+        if (pid == 0)
+        {
+            ::close(fds[0]);
+
+            // Write a UTF-8 BOM followed by the data in small pieces.
+            char buffer[1000];
+            auto written = ::write(fds[1], "\xEF\xBB\xBF", 3) == 3;
+            for (auto i = 0; written && i < size; i += int(sizeof(buffer)))
+            {
+                auto count = size - i < int(sizeof(buffer)) ? size - i : int(sizeof(buffer));
+                for (auto j = 0; j != count; ++j)
+                    buffer[j] = char('a' + (i + j) % 26);
+                written = ::write(fds[1], buffer, std::size_t(count)) == count;
+            }
+            ::_exit(written ? 0 : 1);
+        }
+
+        ::close(fds[1]);
+        REQUIRE(::dup2(fds[0], STDIN_FILENO) == STDIN_FILENO);
+        ::close(fds[0]);
+
+        auto result = lexy::read_stdin<lexy::utf8_encoding>();
+
+        auto status = 0;
+        ::waitpid(pid, &status, 0);
+        CHECK(WIFEXITED(status));
+        CHECK(WEXITSTATUS(status) == 0);
+
+        REQUIRE(result);
+        REQUIRE(result.buffer().size() == size);
+
+        auto correct = true;
+        for (auto i = 0; i != size; ++i)
+            correct = correct && result.buffer().data()[i] == 'a' + i % 26;
+        CHECK(correct);
+    }
+#endif
+
     std::remove(test_file_name);
 }
 
+TEST_CASE("map_file")
+{
+    std::remove(test_file_name);
+
+    SUBCASE("non-existing file")
+    {
+        auto result = lexy::map_file(test_file_name);
+        CHECK(!result);
+        CHECK(result.error() == lexy::file_error::file_not_found);
+    }
+    SUBCASE("empty file")
+    {
+        write_test_data("");
+
+        auto result = lexy::map_file(test_file_name);
+        REQUIRE(result);
+        CHECK(result.input().size() == 0);
+
+        auto reader = result.input().reader();
+        CHECK(reader.peek() == lexy::default_encoding::eof());
+        CHECK(reader.eof());
+    }
+    SUBCASE("tiny file")
+    {
+        write_test_data("abc");
+
+        auto result = lexy::map_file(test_file_name);
+        REQUIRE(result);
+        CHECK(result.input().size() == 3);
+
+        auto reader = result.input().reader();
+        CHECK(reader.peek() == 'a');
+        CHECK(!reader.eof());
+
+        reader.bump();
+        CHECK(reader.peek() == 'b');
+        CHECK(!reader.eof());
+
+        reader.bump();
+        CHECK(reader.peek() == 'c');
+        CHECK(!reader.eof());
+
+        reader.bump();
+        CHECK(reader.peek() == lexy::default_encoding::eof());
+        CHECK(reader.eof());
+    }
+    SUBCASE("big file")
+    {
+        {
+            auto file = std::fopen(test_file_name, "wb");
+            for (auto i = 0; i != 200 * 1024; ++i)
+                std::fputc('a', file);
+            for (auto i = 0; i != 200 * 1024; ++i)
+                std::fputc('b', file);
+            std::fclose(file);
+        }
+
+        auto result = lexy::map_file(test_file_name);
+        REQUIRE(result);
+
+        auto input  = LEXY_MOV(result).input();
+        auto reader = input.reader();
+        for (auto i = 0; i != 200 * 1024; ++i)
+        {
+            CHECK(reader.peek() == 'a');
+            CHECK(!reader.eof());
+            reader.bump();
+        }
+
+        for (auto i = 0; i != 200 * 1024; ++i)
+        {
+            CHECK(reader.peek() == 'b');
+            CHECK(!reader.eof());
+            reader.bump();
+        }
+
+        CHECK(reader.peek() == lexy::default_encoding::eof());
+        CHECK(reader.eof());
+    }
+    SUBCASE("page-sized file with sentinel")
+    {
+        {
+            auto file = std::fopen(test_file_name, "wb");
+            for (auto i = 0; i != 64 * 1024; ++i)
+                std::fputc('a', file);
+            std::fclose(file);
+        }
+
+        auto result = lexy::map_file<lexy::utf8_encoding>(test_file_name);
+        REQUIRE(result);
+        CHECK(result.input().size() == 64 * 1024);
+
+        auto reader = result.input().reader();
+        for (auto i = 0; i != 64 * 1024; ++i)
+        {
+            CHECK(reader.peek() == 'a');
+            CHECK(!reader.eof());
+            reader.bump();
+        }
+
+        CHECK(reader.peek() == lexy::utf8_encoding::eof());
+        CHECK(reader.eof());
+    }
+    SUBCASE("UTF-8 with BOM")
+    {
+        write_test_data("\xEF\xBB\xBF"
+                        "abc");
+
+        auto result = lexy::map_file<lexy::utf8_encoding>(test_file_name);
+        REQUIRE(result);
+        CHECK(result.input().size() == 3);
+
+        auto reader = result.input().reader();
+        CHECK(reader.peek() == 'a');
+        reader.bump();
+        CHECK(reader.peek() == 'b');
+        reader.bump();
+        CHECK(reader.peek() == 'c');
+        reader.bump();
+        CHECK(reader.peek() == lexy::utf8_encoding::eof());
+        CHECK(reader.eof());
+    }
+    SUBCASE("UTF-32")
+    {
+        {
+            const char32_t data[] = {0xFEFF, 0x11, 0x2211};
+            auto           file   = std::fopen(test_file_name, "wb");
+            std::fwrite(data, sizeof(char32_t), 3, file);
+            // Partial code unit at the end is ignored.
+            std::fputc('a', file);
+            std::fclose(file);
+        }
+
+        auto result = lexy::map_file<lexy::utf32_encoding>(test_file_name);
+        REQUIRE(result);
+        CHECK(result.input().size() == 2);
+
+        auto reader = result.input().reader();
+        CHECK(reader.peek() == 0x11);
+        reader.bump();
+        CHECK(reader.peek() == 0x2211);
+        reader.bump();
+        CHECK(reader.peek() == lexy::utf32_encoding::eof());
+        CHECK(reader.eof());
+    }
+    SUBCASE("move")
+    {
+        write_test_data("abc");
+
+        auto result = lexy::map_file(test_file_name);
+        REQUIRE(result);
+
+        lexy::mapped_file_input<> input;
+        CHECK(input.size() == 0);
+
+        input = LEXY_MOV(result).input();
+        CHECK(input.size() == 3);
+        CHECK(input.data()[0] == 'a');
+    }
+    SUBCASE("empty input")
+    {
+        write_test_data("abc");
+
+        lexy::mapped_file_input<lexy::utf32_encoding> empty;
+        auto                                          empty_reader = empty.reader();
+        CHECK(empty_reader.peek() == lexy::utf32_encoding::eof());
+        CHECK(empty_reader.eof());
+        CHECK(lexy::match<eof_production>(empty));
+
+        auto result = lexy::map_file<lexy::utf8_encoding>(test_file_name);
+        REQUIRE(result);
+
+        auto input = LEXY_MOV(result).input();
+        auto other = LEXY_MOV(input);
+        CHECK(other.size() == 3);
+
+        auto moved_reader = input.reader();
+        CHECK(moved_reader.peek() == lexy::utf8_encoding::eof());
+        CHECK(moved_reader.eof());
+        CHECK(lexy::match<eof_production>(input));
+
+        auto default_reader = lexy::mapped_file_input<>().reader();
+        CHECK(default_reader.peek() == lexy::default_encoding::eof());
+        CHECK(default_reader.eof());
+    }
+
+    std::remove(test_file_name);
+}
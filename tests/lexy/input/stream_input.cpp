@@ -0,0 +1,208 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#undef LEXY_DISABLE_FILE
+#include <lexy/input/stream_input.hpp>
+
+#include <cstdio>
+#include <doctest/doctest.h>
+#include <lexy/action/parse.hpp>
+#include <lexy/callback/adapter.hpp>
+#include <lexy/dsl/digit.hpp>
+#include <lexy/dsl/integer.hpp>
+#include <lexy/dsl/newline.hpp>
+#include <lexy/dsl/position.hpp>
+#include <lexy/dsl/sequence.hpp>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>
+#    include <unistd.h>
+#    define LEXY_HAS_FD 1
+#else
+#    define LEXY_HAS_FD 0
+#endif
+
+namespace
+{
+constexpr auto test_file_name = "lexy-input-stream_input.test.delete-me";
+
+void write_test_data(const char* data)
+{
+    auto file = std::fopen(test_file_name, "wb");
+    std::fputs(data, file);
+    std::fclose(file);
+}
+
+struct record
+{
+    int                              value;
+    lexy::stream_input<>::iterator end;
+};
+
+struct record_production
+{
+    static constexpr auto rule
+        = lexy::dsl::integer<int>(lexy::dsl::digits<>) + lexy::dsl::newline + lexy::dsl::position;
+    static constexpr auto value = lexy::callback<record>(
+        [](int value, lexy::stream_input<>::iterator end) { return record{value, end}; });
+};
+} // namespace
+
+TEST_CASE("stream_input")
+{
+    std::remove(test_file_name);
+
+    SUBCASE("empty")
+    {
+        write_test_data("");
+
+        auto                  file = std::fopen(test_file_name, "rb");
+        lexy::stream_input<> input(file);
+
+        auto reader = input.reader();
+        CHECK(reader.peek() == lexy::default_encoding::eof());
+        CHECK(reader.eof());
+        CHECK(input.error() == lexy::file_error::_success);
+
+        std::fclose(file);
+    }
+    SUBCASE("chunks")
+    {
+        write_test_data("abcdefghij");
+
+        auto                  file = std::fopen(test_file_name, "rb");
+        lexy::stream_input<> input(file, 4);
+
+        auto reader = input.reader();
+        auto begin  = reader.cur();
+        for (auto c = 'a'; c <= 'j'; ++c)
+        {
+            CHECK(!reader.eof());
+            CHECK(reader.peek() == c);
+            reader.bump();
+        }
+        CHECK(reader.eof());
+        CHECK(reader.peek() == lexy::default_encoding::eof());
+
+        lexy::stream_lexeme<> lexeme(reader, begin);
+        CHECK(lexeme.size() == 10);
+        CHECK(*lexeme.begin() == 'a');
+        CHECK(*(lexeme.begin() + 9) == 'j');
+        CHECK(input.buffered_size() == 10);
+
+        std::fclose(file);
+    }
+    SUBCASE("backtracking")
+    {
+        write_test_data("abcdefghij");
+
+        auto                  file = std::fopen(test_file_name, "rb");
+        lexy::stream_input<> input(file, 2);
+
+        auto reader = input.reader();
+        reader.bump();
+        reader.bump();
+
+        auto save = reader;
+        for (auto i = 0; i != 5; ++i)
+            reader.bump();
+        CHECK(reader.peek() == 'h');
+
+        reader = save;
+        CHECK(reader.peek() == 'c');
+        CHECK(*reader.cur() == 'c');
+
+        std::fclose(file);
+    }
+    SUBCASE("discard")
+    {
+        {
+            auto file = std::fopen(test_file_name, "wb");
+            for (auto i = 0; i != 100 * 1024; ++i)
+                std::fputs("abc\n", file);
+            std::fclose(file);
+        }
+
+        auto                  file = std::fopen(test_file_name, "rb");
+        lexy::stream_input<> input(file, 256);
+
+        auto lines = 0;
+        while (!input.reader().eof())
+        {
+            auto reader = input.reader();
+            auto begin  = reader.cur();
+            while (reader.peek() != '\n')
+                reader.bump();
+            reader.bump();
+
+            lexy::stream_lexeme<> line(reader, begin);
+            CHECK(line.size() == 4);
+            CHECK(*line.begin() == 'a');
+
+            input.discard(reader.cur());
+            ++lines;
+        }
+        CHECK(lines == 100 * 1024);
+        // We only keep the current line and the chunk it belongs to.
+        CHECK(input.buffered_size() <= 2 * 256);
+
+        std::fclose(file);
+    }
+    SUBCASE("parse records")
+    {
+        {
+            auto file = std::fopen(test_file_name, "wb");
+            for (auto i = 0; i != 200 * 1000; ++i)
+                std::fputs((std::to_string(i) + "\n").c_str(), file);
+            std::fclose(file);
+        }
+
+        auto                 file = std::fopen(test_file_name, "rb");
+        lexy::stream_input<> input(file, 256);
+
+        auto records = 0;
+        while (!input.reader().eof())
+        {
+            auto result = lexy::parse<record_production>(input, lexy::noop);
+            REQUIRE(result);
+            CHECK(result.value().value == records);
+
+            // We no longer need the record, so discard it.
+            input.discard(result.value().end);
+            ++records;
+
+            // We only keep the current record and the chunk it belongs to.
+            CHECK(input.buffered_size() <= 2 * 256);
+        }
+        CHECK(records == 200 * 1000);
+        CHECK(input.error() == lexy::file_error::_success);
+
+        std::fclose(file);
+    }
+#if LEXY_HAS_FD
+    SUBCASE("file descriptor")
+    {
+        write_test_data("abc");
+
+        auto                                    fd = ::open(test_file_name, O_RDONLY);
+        lexy::stream_input<lexy::utf8_encoding> input(fd, 2);
+
+        auto reader = input.reader();
+        CHECK(reader.peek() == 'a');
+        reader.bump();
+        CHECK(reader.peek() == 'b');
+        reader.bump();
+        CHECK(reader.peek() == 'c');
+        reader.bump();
+        CHECK(reader.peek() == lexy::utf8_encoding::eof());
+        CHECK(reader.eof());
+        CHECK(input.error() == lexy::file_error::_success);
+
+        ::close(fd);
+    }
+#endif
+
+    std::remove(test_file_name);
+}
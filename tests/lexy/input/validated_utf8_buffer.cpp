@@ -0,0 +1,215 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <lexy/input/validated_utf8_buffer.hpp>
+
+#include <doctest/doctest.h>
+#include <lexy/action/match.hpp>
+#include <lexy/dsl/code_point.hpp>
+#include <lexy/dsl/eof.hpp>
+#include <lexy/dsl/loop.hpp>
+#include <lexy/engine/code_point.hpp>
+#include <lexy/input/string_input.hpp>
+#include <vector>
+
+namespace
+{
+auto make_buffer(const std::vector<unsigned char>& data)
+{
+    return lexy::buffer<lexy::utf8_encoding>(reinterpret_cast<const LEXY_CHAR8_T*>(data.data()),
+                                             data.size());
+}
+auto make_buffer(const char* str)
+{
+    return lexy::buffer<lexy::utf8_encoding>(reinterpret_cast<const LEXY_CHAR8_T*>(str),
+                                             std::strlen(str));
+}
+
+// The offset of the first invalid code point according to the engine, or -1.
+std::size_t expected_error(const std::vector<unsigned char>& data)
+{
+    auto input  = lexy::string_input<lexy::utf8_encoding>(reinterpret_cast<const LEXY_CHAR8_T*>(
+                                                             data.data()),
+                                                         data.size());
+    auto reader = input.reader();
+    while (!reader.eof())
+    {
+        auto begin = reader.cur();
+
+        lexy::engine_cp_utf8::error_code ec{};
+        lexy::engine_cp_utf8::parse(ec, reader);
+        if (ec != lexy::engine_cp_utf8::error_code{})
+            return std::size_t(begin - input.data());
+    }
+    return std::size_t(-1);
+}
+
+// Generates mostly ASCII input with some multi-unit code points.
+std::vector<unsigned char> generate(unsigned& seed, std::size_t size)
+{
+    auto next = [&](unsigned max) {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 16) % max;
+    };
+
+    std::vector<unsigned char> result;
+    while (result.size() < size)
+    {
+        switch (next(8))
+        {
+        case 0:
+            // ä
+            result.insert(result.end(), {0xC3, 0xA4});
+            break;
+        case 1:
+            // €
+            result.insert(result.end(), {0xE2, 0x82, 0xAC});
+            break;
+        case 2:
+            // U+1F600
+            result.insert(result.end(), {0xF0, 0x9F, 0x98, 0x80});
+            break;
+
+        default:
+            result.push_back(static_cast<unsigned char>('a' + next(26)));
+            break;
+        }
+    }
+    return result;
+}
+
+struct code_points
+{
+    static constexpr auto rule = lexy::dsl::while_(lexy::dsl::code_point) + lexy::dsl::eof;
+};
+} // namespace
+
+TEST_CASE("validate_utf8")
+{
+    auto validate = [](const char* str) { return lexy::validate_utf8(make_buffer(str)); };
+
+    SUBCASE("valid")
+    {
+        auto empty = validate("");
+        CHECK(empty);
+        CHECK(empty.buffer().size() == 0);
+
+        auto ascii = validate("abc");
+        CHECK(ascii);
+        CHECK(ascii.buffer().size() == 3);
+        CHECK(ascii.buffer().data()[0] == 'a');
+
+        auto multi = validate("ä€\U0001F600\U0010FFFF");
+        CHECK(multi);
+        CHECK(multi.buffer().size() == 2 + 3 + 4 + 4);
+    }
+    SUBCASE("invalid")
+    {
+        auto check_error = [&](const char* str, std::size_t offset) {
+            auto result = validate(str);
+            CHECK(!result);
+            CHECK(result.error_offset() == offset);
+        };
+
+        check_error("ab\x80", 2);              // Leads with trailing.
+        check_error("ab\xC3", 2);              // Missing trailing at EOF.
+        check_error("ab\xE2\x82z", 2);         // Missing trailing.
+        check_error("ab\xC0\x80", 2);          // Overlong ASCII.
+        check_error("ab\xE0\x80\x80", 2);      // Overlong 3 unit sequence.
+        check_error("ab\xF0\x80\x80\x80", 2);  // Overlong 4 unit sequence.
+        check_error("ab\xED\xA0\x80", 2);      // Surrogate.
+        check_error("ab\xF4\x90\x80\x80", 2);  // Out of range.
+        check_error("ab\xF5\x80\x80\x80", 2);  // Out of range.
+        check_error("ab\xFF", 2);              // Invalid unit.
+        check_error("ab\xC3\xA4\xC3\xC3", 4);  // Error after valid code point.
+
+        auto result = validate("ab\x80");
+        auto buffer = LEXY_MOV(result).invalid_buffer();
+        CHECK(buffer.size() == 3);
+        CHECK(buffer.data()[2] == 0x80);
+    }
+    SUBCASE("long input")
+    {
+        // Long enough to cover multiple SIMD blocks and the remaining units.
+        auto seed = 42u;
+        for (auto size = 1u; size < 256; ++size)
+        {
+            auto data = generate(seed, size);
+            INFO(size);
+            CHECK(lexy::validate_utf8(make_buffer(data)));
+
+            // Replace each unit in turn, and compare against the code point engine.
+            for (auto i = 0u; i < data.size(); ++i)
+            {
+                for (auto unit : {0x00, 0x80, 0xBF, 0xC3, 0xE2, 0xED, 0xF0, 0xF4, 0xFF})
+                {
+                    auto copy = data;
+                    copy[i]   = static_cast<unsigned char>(unit);
+
+                    auto expected = expected_error(copy);
+                    auto result   = lexy::validate_utf8(make_buffer(copy));
+                    if (expected == std::size_t(-1))
+                        CHECK(result);
+                    else
+                    {
+                        INFO(i);
+                        INFO(unit);
+                        REQUIRE(!result);
+                        CHECK(result.error_offset() == expected);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("validated_utf8_buffer")
+{
+    auto result = lexy::validate_utf8(make_buffer("aä€\U0001F600"));
+    REQUIRE(result);
+
+    auto buffer = LEXY_MOV(result).buffer();
+    CHECK(buffer.size() == 1 + 2 + 3 + 4);
+
+    auto reader = buffer.reader();
+    CHECK(lexy::is_canonical_reader<decltype(reader)>);
+
+    auto parse = [&] {
+        lexy::engine_cp_utf8::error_code ec{};
+        auto                             cp = lexy::engine_cp_utf8::parse(ec, reader);
+        CHECK(ec == lexy::engine_cp_utf8::error_code{});
+        return cp.value();
+    };
+    CHECK(parse() == 'a');
+    CHECK(parse() == 0xE4);
+    CHECK(parse() == 0x20AC);
+    CHECK(parse() == 0x1F600);
+    CHECK(reader.eof());
+
+    lexy::engine_cp_utf8::error_code ec{};
+    lexy::engine_cp_utf8::parse(ec, reader);
+    CHECK(ec == lexy::engine_cp_utf8::error_code::eof);
+
+    SUBCASE("in the middle of a code point")
+    {
+        auto middle = buffer.reader();
+        middle.bump();
+        middle.bump();
+
+        lexy::engine_cp_utf8::parse(ec, middle);
+        CHECK(ec == lexy::engine_cp_utf8::error_code::leads_with_trailing);
+        CHECK(middle.cur() == buffer.data() + 2);
+    }
+    SUBCASE("dsl")
+    {
+        CHECK(lexy::match<code_points>(buffer));
+    }
+    SUBCASE("release")
+    {
+        auto data     = buffer.data();
+        auto released = LEXY_MOV(buffer).release();
+        CHECK(released.data() == data);
+        CHECK(released.size() == 1 + 2 + 3 + 4);
+    }
+}
@@ -0,0 +1,134 @@
+// Copyright (C) 2020-2021 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <lexy_ext/error_collector.hpp>
+
+#include <doctest/doctest.h>
+#include <iterator>
+#include <lexy/action/validate.hpp>
+#include <lexy/dsl/literal.hpp>
+#include <lexy/dsl/sequence.hpp>
+#include <lexy/dsl/terminator.hpp>
+#include <lexy/input/string_input.hpp>
+#include <string>
+
+namespace
+{
+struct production
+{
+    static constexpr auto name = "production";
+};
+
+struct error_tag
+{
+    static constexpr auto name = "error tag";
+};
+
+struct statements
+{
+    static constexpr auto name = "statements";
+    static constexpr auto rule = [] {
+        auto statement = lexy::dsl::terminator(LEXY_LIT(";")).try_(LEXY_LIT("a"));
+        return statement + statement + statement + statement;
+    }();
+};
+} // namespace
+
+TEST_CASE("error_collector")
+{
+    auto input = lexy::zstring_input("hello\nworld\nfoo");
+
+    lexy_ext::error_collector errors(input);
+    CHECK(errors.empty());
+
+    auto write = [&](std::size_t max_count) {
+        std::string str;
+        errors.write_to(std::back_insert_iterator(str), {}, max_count);
+        return str;
+    };
+
+    SUBCASE("sorted")
+    {
+        auto sink = errors.callback().sink();
+
+        auto context = lexy::error_context(production{}, input, input.data());
+        sink(context, lexy::string_error<error_tag>(input.data() + 13));
+        sink(context, lexy::string_error<lexy::expected_literal>(input.data() + 2, "abc", 1));
+        sink(context, lexy::string_error<lexy::expected_char_class>(input.data() + 8, "class"));
+        CHECK(LEXY_MOV(sink).finish() == 3);
+        CHECK(errors.count() == 3);
+
+        CHECK(write(std::size_t(-1)) == R"*(error: while parsing production
+     |
+   1 | hello
+     |   ^^ expected 'abc'
+error: while parsing production
+     |
+   1 | hello
+     | ~ beginning here
+     |
+   2 | world
+     |   ^ expected 'class' character
+error: while parsing production
+     |
+   1 | hello
+     | ~ beginning here
+     |
+   3 | foo
+     |  ^ error tag
+)*");
+
+        CHECK(write(1) == R"*(error: while parsing production
+     |
+   1 | hello
+     |   ^^ expected 'abc'
+)*");
+        CHECK(write(0).empty());
+
+        errors.clear();
+        CHECK(errors.empty());
+        CHECK(write(std::size_t(-1)).empty());
+    }
+    SUBCASE("same position")
+    {
+        auto sink = errors.callback().sink();
+
+        auto context = lexy::error_context(production{}, input, input.data() + 6);
+        sink(context, lexy::string_error<error_tag>(input.data() + 6, input.data() + 8));
+        sink(context, lexy::string_error<lexy::expected_keyword>(input.data() + 6,
+                                                                 input.data() + 11, "abc"));
+        CHECK(write(std::size_t(-1)) == R"*(error: while parsing production
+     |
+   2 | world
+     | ^^ error tag
+error: while parsing production
+     |
+   2 | world
+     | ^^^^^ expected keyword 'abc'
+)*");
+    }
+    SUBCASE("parse")
+    {
+        auto statement_input = lexy::zstring_input("a;c;a;d;");
+
+        lexy_ext::error_collector statement_errors(statement_input);
+        auto result = lexy::validate<statements>(statement_input, statement_errors.callback());
+        CHECK(result.is_recovered_error());
+        CHECK(result.errors() == 2);
+        CHECK(statement_errors.count() == 2);
+
+        std::string str;
+        statement_errors.write_to(std::back_insert_iterator(str));
+        CHECK(str == R"*(error: while parsing statements
+     |
+   1 | a;c;a;d;
+     |   ^ expected 'a'
+error: while parsing statements
+     |
+   1 | a;c;a;d;
+     |       ^ expected 'a'
+)*");
+    }
+}
+
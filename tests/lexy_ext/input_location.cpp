@@ -6,7 +6,10 @@
 
 #include <doctest/doctest.h>
 #include <lexy/dsl/ascii.hpp>
+#include <lexy/dsl/code_point.hpp>
+#include <lexy/input/buffer.hpp>
 #include <lexy/input/string_input.hpp>
+#include <string>
 
 namespace
 {
@@ -220,3 +223,108 @@ TEST_CASE("find_input_location")
     }
 }
 
+TEST_CASE("line_index")
+{
+    // Checks that the index finds the same locations as the finder.
+    auto check_all = [](const auto& input, auto column) {
+        lexy_ext::input_location_finder finder(input, column, lexy::dsl::newline);
+        lexy_ext::line_index            index(input, column);
+
+        auto begin = input.reader().cur();
+        auto end   = begin + input.size();
+        for (auto pos = begin; pos <= end; ++pos)
+        {
+            // The finder can't find the newline character of "\r\n".
+            if (pos != begin && pos != end && pos[-1] == '\r' && *pos == '\n')
+                continue;
+            // Neither can it find positions in the middle of a code point.
+            if (pos != end && (static_cast<unsigned char>(*pos) & 0xC0) == 0x80)
+                continue;
+            INFO(pos - begin);
+
+            auto expected = finder.find(pos);
+            auto actual   = index.find(pos);
+            REQUIRE(actual.line_nr() == expected.line_nr());
+            REQUIRE(actual.column_nr() == expected.column_nr());
+            REQUIRE(actual.context().begin() == expected.context().begin());
+            REQUIRE(actual.context().end() == expected.context().end());
+            REQUIRE(actual.newline().end() == expected.newline().end());
+        }
+    };
+
+    SUBCASE("basic")
+    {
+        auto input = lexy::zstring_input("Line 1\n"
+                                         "Line 2\n"
+                                         "Line 3\n");
+        lexy_ext::line_index index(input);
+        CHECK(index.line_count() == 4);
+
+        auto second = index.find(input.data() + 10);
+        CHECK(second.line_nr() == 2);
+        CHECK(second.column_nr() == 4);
+        CHECK(second.context() == str_context{"Line 2"});
+        CHECK(second.newline() == str_context{"\n"});
+
+        auto beginning = index.beginning();
+        CHECK(beginning.line_nr() == 1);
+        CHECK(beginning.column_nr() == 1);
+        CHECK(index.find(input.data() + 10, beginning).line_nr() == 2);
+
+        check_all(input, lexy_ext::_unchecked_code_unit{});
+        check_all(lexy::zstring_input("Line 1\nLine 2"), lexy_ext::_unchecked_code_unit{});
+        check_all(lexy::zstring_input(""), lexy_ext::_unchecked_code_unit{});
+        check_all(lexy::zstring_input("\n\n"), lexy_ext::_unchecked_code_unit{});
+    }
+    SUBCASE("carriage return")
+    {
+        auto input = lexy::zstring_input("Line 1\r\n"
+                                         "Line\r2\r\n"
+                                         "\r\n");
+        lexy_ext::line_index index(input);
+        CHECK(index.line_count() == 4);
+
+        auto first = index.find(input.data() + 2);
+        CHECK(first.context() == str_context{"Line 1"});
+        CHECK(first.newline() == str_context{"\r\n"});
+
+        // A carriage return on its own doesn't start a new line.
+        auto second = index.find(input.data() + 14);
+        CHECK(second.line_nr() == 2);
+        CHECK(second.column_nr() == 7);
+        CHECK(second.context() == str_context{"Line\r2"});
+
+        check_all(input, lexy_ext::_unchecked_code_unit{});
+    }
+    SUBCASE("column token")
+    {
+        static constexpr char array[] = {'a', 'b', 'c', char(0xFF), 'd', '\n', 'e', '\0'};
+        auto                  input   = lexy::zstring_input(array);
+        check_all(input, lexy::dsl::ascii::character);
+
+        auto index = lexy_ext::line_index(input, lexy::dsl::ascii::character);
+        auto after = index.find(input.data() + 4);
+        CHECK(after.line_nr() == 1);
+        CHECK(after.column_nr() == 4);
+    }
+    SUBCASE("code point")
+    {
+        // Code points with one to four bytes.
+        auto bytes = std::string();
+        for (auto i = 0; i != 1000; ++i)
+            bytes += "a\xC3\xA4\xE1\x88\xB4\xF0\x9F\x98\x80";
+        bytes += "\n\xC3\xA4\n";
+        auto str = std::basic_string<LEXY_CHAR8_T>(bytes.begin(), bytes.end());
+
+        auto input = lexy::string_input<lexy::utf8_encoding>(str.data(), str.size());
+        check_all(input, lexy::dsl::code_point);
+
+        auto index = lexy_ext::line_index(input, lexy::dsl::code_point);
+        auto last  = index.find(input.data() + str.size() - 13);
+        CHECK(last.line_nr() == 1);
+        CHECK(last.column_nr() == 3998);
+
+        auto buffer = lexy::buffer<lexy::utf8_encoding>(str.data(), str.size());
+        check_all(buffer, lexy::dsl::code_point);
+    }
+}
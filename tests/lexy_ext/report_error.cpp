@@ -96,6 +96,25 @@ TEST_CASE("_detail::write_error")
      |
    2 | world
      |   ^ error tag
+)*");
+    }
+    SUBCASE("line index")
+    {
+        auto input = lexy::zstring_input("hello\nworld");
+        auto index = lexy_ext::line_index(input);
+
+        auto context = lexy::error_context(production{}, input, input.data());
+        lexy::string_error<error_tag> error(input.data() + 8);
+
+        std::string str;
+        lexy_ext::_detail::write_error(std::back_insert_iterator(str), context, error, {}, index);
+        CHECK(str == R"*(error: while parsing production
+     |
+   1 | hello
+     | ~ beginning here
+     |
+   2 | world
+     |   ^ error tag
 )*");
     }
     SUBCASE("error at newline")